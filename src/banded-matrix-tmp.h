@@ -0,0 +1,439 @@
+#ifndef MATRIX_BANDED_MATRIX_TMP_H
+#define MATRIX_BANDED_MATRIX_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "banded-matrix.h"
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+
+template <Elementable Element>
+BandedMatrix<Element>::BandedMatrix(size_t size, size_t lower_bandwidth, size_t upper_bandwidth)
+: size(size)
+, lower_bandwidth(lower_bandwidth)
+, upper_bandwidth(upper_bandwidth)
+, storage(size * (lower_bandwidth + upper_bandwidth + 1), Element(0))
+{
+}
+
+template <Elementable Element>
+BandedMatrix<Element>::BandedMatrix(const Matrix<Element>& matrix, size_t lower_bandwidth, size_t upper_bandwidth)
+: BandedMatrix(matrix.get_number_of_row(), lower_bandwidth, upper_bandwidth)
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		std::copy(matrix.row_data(row_index) + first_col(row_index), matrix.row_data(row_index) + last_col(row_index),
+				storage.begin() + static_cast<std::ptrdiff_t>(index(row_index, first_col(row_index))));
+	}
+}
+
+template <Elementable Element>
+size_t BandedMatrix<Element>::width() const noexcept
+{
+	return lower_bandwidth + upper_bandwidth + 1;
+}
+
+template <Elementable Element>
+bool BandedMatrix<Element>::in_band(size_t row_index, size_t col_index) const noexcept
+{
+	return col_index + lower_bandwidth >= row_index and col_index <= row_index + upper_bandwidth;
+}
+
+template <Elementable Element>
+size_t BandedMatrix<Element>::index(size_t row_index, size_t col_index) const noexcept
+{
+	return row_index * width() + col_index + lower_bandwidth - row_index;
+}
+
+template <Elementable Element>
+size_t BandedMatrix<Element>::first_col(size_t row_index) const noexcept
+{
+	return row_index > lower_bandwidth ? row_index - lower_bandwidth : 0;
+}
+
+template <Elementable Element>
+size_t BandedMatrix<Element>::last_col(size_t row_index) const noexcept
+{
+	return std::min(size, row_index + upper_bandwidth + 1);
+}
+
+template <Elementable Element>
+size_t BandedMatrix<Element>::get_size() const noexcept
+{
+	return size;
+}
+
+template <Elementable Element>
+size_t BandedMatrix<Element>::get_lower_bandwidth() const noexcept
+{
+	return lower_bandwidth;
+}
+
+template <Elementable Element>
+size_t BandedMatrix<Element>::get_upper_bandwidth() const noexcept
+{
+	return upper_bandwidth;
+}
+
+template <Elementable Element>
+Element BandedMatrix<Element>::at(size_t row_index, size_t col_index) const
+{
+	if (row_index >= size or col_index >= size)
+		throw std::out_of_range("the index is out of the matrix!");
+	return in_band(row_index, col_index) ? storage[index(row_index, col_index)] : Element(0);
+}
+
+template <Elementable Element>
+void BandedMatrix<Element>::set(size_t row_index, size_t col_index, const Element& value)
+{
+	if (row_index >= size or col_index >= size or not in_band(row_index, col_index))
+		throw std::out_of_range("the index is out of the band!");
+	storage[index(row_index, col_index)] = value;
+}
+
+template <Elementable Element>
+Matrix<Element> BandedMatrix<Element>::to_dense() const
+{
+	Matrix<Element> result(size, size);
+	const auto result_rows = result.mutable_rows();
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		const Element* row = storage.data() + index(row_index, first_col(row_index));
+		std::copy(row, row + (last_col(row_index) - first_col(row_index)),
+				result_rows.row_data(row_index) + first_col(row_index));
+	}
+	return result;
+}
+
+template <Elementable Element>
+BandedMatrix<Element>::operator Matrix<Element>() const
+{
+	return to_dense();
+}
+
+template <Elementable Element>
+BandedMatrix<Element> BandedMatrix<Element>::transpose() const
+{
+	BandedMatrix result(size, upper_bandwidth, lower_bandwidth);
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		for (size_t col_index = first_col(row_index); col_index < last_col(row_index); ++col_index)
+			result.storage[result.index(col_index, row_index)] = storage[index(row_index, col_index)];
+	}
+	return result;
+}
+
+template <Elementable Element>
+void BandedMatrix<Element>::multiply(const Element* x, Element* y) const
+{
+	matrix_helper::parallel_for(size, width(), [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = begin; row_index < end; ++row_index)
+		{
+			const size_t first = first_col(row_index);
+			y[row_index] = matrix_kernel::dot(last_col(row_index) - first, storage.data() + index(row_index, first),
+					x + first);
+		}
+	});
+}
+
+template <Elementable Element>
+std::vector<Element> BandedMatrix<Element>::operator*(const std::vector<Element>& x) const
+{
+	if (x.size() != size)
+		throw std::invalid_argument("the number of rows must match the number of columns.");
+
+	std::vector<Element> y(size);
+	multiply(x.data(), y.data());
+	return y;
+}
+
+template <Elementable Element>
+Matrix<Element> BandedMatrix<Element>::operator*(const Matrix<Element>& other) const
+{
+	if (other.get_number_of_row() != size)
+		throw std::invalid_argument("the number of rows must match the number of columns.");
+
+	const size_t number_of_rhs = other.get_number_of_col();
+	Matrix<Element> result(size, number_of_rhs);
+	const auto result_rows = result.mutable_rows();
+	matrix_helper::parallel_for(size, width() * number_of_rhs, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = begin; row_index < end; ++row_index)
+		{
+			for (size_t k = first_col(row_index); k < last_col(row_index); ++k)
+				matrix_kernel::axpy(number_of_rhs, storage[index(row_index, k)], other.row_data(k),
+						result_rows.row_data(row_index));
+		}
+	});
+	return result;
+}
+
+template <Elementable Element>
+BandedMatrix<Element> BandedMatrix<Element>::operator*(const Element& scalar) const
+{
+	BandedMatrix result(size, lower_bandwidth, upper_bandwidth);
+	matrix_kernel::scale(storage.size(), storage.data(), scalar, result.storage.data());
+	return result;
+}
+
+template <Elementable Element>
+template <typename Combine>
+BandedMatrix<Element> BandedMatrix<Element>::merge(const BandedMatrix& other, Combine combine) const
+{
+	if (size != other.size)
+		throw std::invalid_argument("the matrices should have the same size!");
+
+	BandedMatrix result(size, std::max(lower_bandwidth, other.lower_bandwidth),
+			std::max(upper_bandwidth, other.upper_bandwidth));
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		for (size_t col_index = result.first_col(row_index); col_index < result.last_col(row_index); ++col_index)
+		{
+			const Element left = in_band(row_index, col_index) ? storage[index(row_index, col_index)] : Element(0);
+			const Element right = other.in_band(row_index, col_index)
+					? other.storage[other.index(row_index, col_index)]
+					: Element(0);
+			result.storage[result.index(row_index, col_index)] = combine(left, right);
+		}
+	}
+	return result;
+}
+
+template <Elementable Element>
+BandedMatrix<Element> BandedMatrix<Element>::operator+(const BandedMatrix& other) const
+{
+	return merge(other, [](const Element& left, const Element& right) { return left + right; });
+}
+
+template <Elementable Element>
+BandedMatrix<Element> BandedMatrix<Element>::operator-(const BandedMatrix& other) const
+{
+	return merge(other, [](const Element& left, const Element& right) { return left - right; });
+}
+
+template <Elementable Element>
+auto BandedMatrix<Element>::factorize() const -> Factorization
+{
+	Factorization factorization;
+	const size_t factor_width = 2 * lower_bandwidth + upper_bandwidth + 1;
+	factorization.width = factor_width;
+	factorization.lu.assign(size * factor_width, Element(0));
+	factorization.pivots.resize(size);
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		std::copy_n(storage.begin() + static_cast<std::ptrdiff_t>(row_index * width()), width(),
+				factorization.lu.begin() + static_cast<std::ptrdiff_t>(row_index * factor_width));
+	}
+	// same slot rule as storage, in the wider rows
+	const auto lu = [&](size_t row_index, size_t col_index) -> Element&
+	{
+		return factorization.lu[row_index * factor_width + col_index + lower_bandwidth - row_index];
+	};
+
+	for (size_t k = 0; k < size; ++k)
+	{
+		const size_t last_row = std::min(size, k + lower_bandwidth + 1);
+		const size_t last_col = std::min(size, k + lower_bandwidth + upper_bandwidth + 1);
+		size_t pivot_row = k;
+		for (size_t i = k + 1; i < last_row; ++i)
+		{
+			if (matrix_helper::is_better_pivot(lu(i, k), lu(pivot_row, k)))
+				pivot_row = i;
+		}
+		factorization.pivots[k] = pivot_row;
+		if (lu(pivot_row, k) == Element(0))
+		{
+			factorization.singular = true;
+			return factorization;
+		}
+		if (pivot_row != k)
+		{
+			for (size_t j = k; j < last_col; ++j)
+				std::swap(lu(k, j), lu(pivot_row, j));
+			factorization.odd_swaps = not factorization.odd_swaps;
+		}
+
+		for (size_t i = k + 1; i < last_row; ++i)
+		{
+			lu(i, k) /= lu(k, k);
+			matrix_kernel::axpy(last_col - k - 1, -lu(i, k), &lu(k, k + 1), &lu(i, k + 1));
+		}
+	}
+	return factorization;
+}
+
+template <Elementable Element>
+void BandedMatrix<Element>::substitute(const Factorization& factorization, Element* x, size_t number_of_rhs,
+		size_t x_stride) const
+{
+	const auto lu = [&](size_t row_index, size_t col_index) -> const Element&
+	{
+		return factorization.lu[row_index * factorization.width + col_index + lower_bandwidth - row_index];
+	};
+
+	// P * L: the swaps and multipliers of every step in order
+	for (size_t k = 0; k < size; ++k)
+	{
+		Element* x_row = x + k * x_stride;
+		if (factorization.pivots[k] != k)
+			std::swap_ranges(x_row, x_row + number_of_rhs, x + factorization.pivots[k] * x_stride);
+		for (size_t i = k + 1; i < std::min(size, k + lower_bandwidth + 1); ++i)
+			matrix_kernel::axpy(number_of_rhs, -lu(i, k), x_row, x + i * x_stride);
+	}
+
+	// U, lower_bandwidth + upper_bandwidth diagonals above the main one
+	for (size_t k = size; k-- > 0;)
+	{
+		Element* x_row = x + k * x_stride;
+		const size_t last_col = std::min(size, k + lower_bandwidth + upper_bandwidth + 1);
+		if (number_of_rhs == 1 and x_stride == 1)
+			*x_row -= matrix_kernel::dot(last_col - k - 1, &lu(k, k + 1), x_row + 1);
+		else
+		{
+			for (size_t j = k + 1; j < last_col; ++j)
+				matrix_kernel::axpy(number_of_rhs, -lu(k, j), x + j * x_stride, x_row);
+		}
+		matrix_kernel::scale(number_of_rhs, x_row, Element(1) / lu(k, k), x_row);
+	}
+}
+
+template <Elementable Element>
+bool BandedMatrix<Element>::is_diagonally_dominant_tridiagonal() const
+{
+	if constexpr (std::floating_point<Element>)
+	{
+		if (lower_bandwidth > 1 or upper_bandwidth > 1)
+			return false;
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			Element off_diagonal = 0;
+			for (size_t j = first_col(i); j < last_col(i); ++j)
+			{
+				if (j != i)
+					off_diagonal += std::abs(storage[index(i, j)]);
+			}
+			if (std::abs(storage[index(i, i)]) < off_diagonal)
+				return false;
+		}
+		return true;
+	}
+	else
+		return false;
+}
+
+template <Elementable Element>
+void BandedMatrix<Element>::thomas(Element* x, size_t number_of_rhs, size_t x_stride) const
+{
+	// forward sweep to a unit upper bidiagonal system, c[i] holds its superdiagonal
+	std::vector<Element> c(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		Element* x_row = x + i * x_stride;
+		Element pivot = storage[index(i, i)];
+		if (i > 0 and lower_bandwidth > 0)
+		{
+			const Element sub_diagonal = storage[index(i, i - 1)];
+			pivot -= sub_diagonal * c[i - 1];
+			matrix_kernel::axpy(number_of_rhs, -sub_diagonal, x_row - x_stride, x_row);
+		}
+		if (pivot == Element(0))
+			throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+		if (i + 1 < size and upper_bandwidth > 0)
+			c[i] = storage[index(i, i + 1)] / pivot;
+		matrix_kernel::scale(number_of_rhs, x_row, Element(1) / pivot, x_row);
+	}
+	for (size_t i = size; i-- > 0;)
+	{
+		if (i + 1 < size)
+			matrix_kernel::axpy(number_of_rhs, -c[i], x + (i + 1) * x_stride, x + i * x_stride);
+	}
+}
+
+template <Elementable Element>
+Element BandedMatrix<Element>::determinant() const
+{
+	// the band LU divides, which truncates integers, so they take the exact dense determinant
+	if constexpr (std::floating_point<Element>)
+	{
+		const Factorization factorization = factorize();
+		if (factorization.singular)
+			return Element(0);
+
+		Element det = factorization.odd_swaps ? Element(-1) : Element(1);
+		for (size_t k = 0; k < size; ++k)
+			det *= factorization.lu[k * factorization.width + lower_bandwidth];
+		return det;
+	}
+	else
+		return to_dense().determinant();
+}
+
+template <Elementable Element>
+std::vector<Element> BandedMatrix<Element>::solve(const std::vector<Element>& b) const
+{
+	if (b.size() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+
+	if constexpr (std::floating_point<Element>)
+	{
+		std::vector<Element> x = b;
+		if (is_diagonally_dominant_tridiagonal())
+		{
+			thomas(x.data(), 1, 1);
+			return x;
+		}
+		const Factorization factorization = factorize();
+		if (factorization.singular)
+			throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+		substitute(factorization, x.data(), 1, 1);
+		return x;
+	}
+	else
+		return to_dense().solve(b);
+}
+
+template <Elementable Element>
+Matrix<Element> BandedMatrix<Element>::solve(const Matrix<Element>& b) const
+{
+	if (b.get_number_of_row() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+
+	if constexpr (std::floating_point<Element>)
+	{
+		Matrix<Element> x = b;
+		Element* const x_data = x.mutable_rows().row_data(0);
+		if (is_diagonally_dominant_tridiagonal())
+		{
+			matrix_helper::parallel_for(x.get_number_of_col(), 5 * size, [&](size_t begin, size_t end)
+			{
+				thomas(x_data + begin, end - begin, x.get_stride());
+			});
+			return x;
+		}
+		const Factorization factorization = factorize();
+		if (factorization.singular)
+			throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+		matrix_helper::parallel_for(x.get_number_of_col(), size * factorization.width, [&](size_t begin, size_t end)
+		{
+			substitute(factorization, x_data + begin, end - begin, x.get_stride());
+		});
+		return x;
+	}
+	else
+		return to_dense().solve(b);
+}
+
+template <Elementable Element>
+Matrix<Element> BandedMatrix<Element>::inverse() const
+{
+	return solve(Matrix<Element>::create_i_matrix(size));
+}
+
+#endif
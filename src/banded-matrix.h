@@ -0,0 +1,94 @@
+#ifndef MATRIX_BANDED_MATRIX_H
+#define MATRIX_BANDED_MATRIX_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+
+// Square matrix whose non-zeros lie within lower_bandwidth diagonals below the main one and upper_bandwidth above it.
+// Row i keeps columns i - lower_bandwidth .. i + upper_bandwidth in a row of lower_bandwidth + upper_bandwidth + 1
+// slots, so a tridiagonal matrix takes 3 * size elements. Solves and determinants cost O(size * bandwidth^2): the
+// Thomas algorithm for a diagonally dominant tridiagonal matrix, banded LU with partial pivoting otherwise. Both
+// divide, so elements that are not floating point go through the dense matrix instead.
+template <Elementable Element>
+class BandedMatrix
+{
+public:
+	BandedMatrix() = default;
+	// size x size without any non-zero
+	BandedMatrix(size_t size, size_t lower_bandwidth, size_t upper_bandwidth);
+	// entries of matrix outside the band are ignored
+	BandedMatrix(const Matrix<Element>& matrix, size_t lower_bandwidth, size_t upper_bandwidth);
+
+	[[nodiscard]] size_t get_size() const noexcept;
+	[[nodiscard]] size_t get_lower_bandwidth() const noexcept;
+	[[nodiscard]] size_t get_upper_bandwidth() const noexcept;
+
+	// zero outside the band
+	[[nodiscard]] Element at(size_t row_index, size_t col_index) const;
+	// throws std::out_of_range outside the band
+	void set(size_t row_index, size_t col_index, const Element& value);
+
+	[[nodiscard]] Matrix<Element> to_dense() const;
+	[[nodiscard]] explicit operator Matrix<Element>() const;
+	[[nodiscard]] BandedMatrix transpose() const;
+
+	// y = A * x, this makes a BandedMatrix a LinearOperator
+	void multiply(const Element* x, Element* y) const;
+	[[nodiscard]] std::vector<Element> operator*(const std::vector<Element>& x) const;
+	[[nodiscard]] Matrix<Element> operator*(const Matrix<Element>& other) const;
+	[[nodiscard]] BandedMatrix operator*(const Element& scalar) const;
+	// the band of the result covers both bands
+	[[nodiscard]] BandedMatrix operator+(const BandedMatrix& other) const;
+	[[nodiscard]] BandedMatrix operator-(const BandedMatrix& other) const;
+	bool operator==(const BandedMatrix& other) const = default;
+
+	[[nodiscard]] Element determinant() const;
+	[[nodiscard]] std::vector<Element> solve(const std::vector<Element>& b) const;
+	[[nodiscard]] Matrix<Element> solve(const Matrix<Element>& b) const;
+	// dense, the inverse of a banded matrix usually is
+	[[nodiscard]] Matrix<Element> inverse() const;
+
+private:
+	// LU of the band: row swaps may push U up to lower_bandwidth + upper_bandwidth diagonals above the main one, so
+	// its rows are wider than those of the matrix
+	struct Factorization
+	{
+		size_t width = 0;
+		std::vector<Element> lu;
+		std::vector<size_t> pivots;
+		bool odd_swaps = false;
+		bool singular = false;
+	};
+
+	[[nodiscard]] size_t width() const noexcept;
+	[[nodiscard]] bool in_band(size_t row_index, size_t col_index) const noexcept;
+	// position of A[row_index][col_index] in storage, for an entry in the band
+	[[nodiscard]] size_t index(size_t row_index, size_t col_index) const noexcept;
+	// first and one past the last column of the band in a row
+	[[nodiscard]] size_t first_col(size_t row_index) const noexcept;
+	[[nodiscard]] size_t last_col(size_t row_index) const noexcept;
+
+	[[nodiscard]] bool is_diagonally_dominant_tridiagonal() const;
+	[[nodiscard]] Factorization factorize() const;
+	// X = A^-1 * X for the size x number_of_rhs row-major block X
+	void substitute(const Factorization& factorization, Element* x, size_t number_of_rhs, size_t x_stride) const;
+	// the same without pivoting for a diagonally dominant tridiagonal A, throws when a pivot is zero
+	void thomas(Element* x, size_t number_of_rhs, size_t x_stride) const;
+
+	template <typename Combine>
+	[[nodiscard]] BandedMatrix merge(const BandedMatrix& other, Combine combine) const;
+
+	size_t size = 0;
+	size_t lower_bandwidth = 0;
+	size_t upper_bandwidth = 0;
+	// row i, slot j - i + lower_bandwidth; slots that fall outside the matrix stay zero
+	std::vector<Element> storage;
+};
+
+#include "banded-matrix-tmp.h"
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef MATRIX_CHOLESKY_DECOMPOSITION_TMP_H
+#define MATRIX_CHOLESKY_DECOMPOSITION_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "cholesky-decomposition.h"
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+
+template <Elementable Element>
+CholeskyDecomposition<Element>::CholeskyDecomposition(const Matrix<Element>& matrix, bool check_symmetric)
+: lower(matrix)
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+	if (check_symmetric and not matrix.is_symmetric())
+		throw std::invalid_argument("the matrix should be symmetric!");
+
+	// right-looking blocked elimination: factorize a panel of columns, then subtract L21 * L21^T from the lower
+	// triangle of the trailing matrix only
+	const size_t size = get_size();
+	const size_t stride = lower.get_stride();
+	const auto lower_rows = lower.mutable_rows();
+	for (size_t first_col = 0; first_col < size and positive_definite; first_col += BLOCK_SIZE)
+	{
+		const size_t last_col = std::min(first_col + BLOCK_SIZE, size);
+		positive_definite = factorize_panel(first_col, last_col);
+		if (positive_definite and last_col < size)
+		{
+			const Element* lower_panel = lower.row_data(last_col) + first_col;
+			matrix_kernel::syrk_lower(size - last_col, last_col - first_col, lower_panel, stride, lower_panel, stride,
+					lower_rows.row_data(last_col) + last_col, stride);
+		}
+	}
+
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		Element* row = lower_rows.row_data(row_index);
+		std::fill(row + row_index + 1, row + size, Element(0));
+	}
+}
+
+template <Elementable Element>
+bool CholeskyDecomposition<Element>::factorize_panel(size_t first_col, size_t last_col)
+{
+	using std::sqrt;
+	const size_t size = get_size();
+	const size_t panel_width = last_col - first_col;
+	const auto lower_rows = lower.mutable_rows();
+
+	// L[i][j] = (A[i][j] - L[i][first:j] . L[j][first:j]) / L[j][j], both operands contiguous
+	auto eliminate_row = [&](Element* row, size_t last_col_of_row)
+	{
+		for (size_t col_index = first_col; col_index < last_col_of_row; ++col_index)
+		{
+			const Element* pivot_row = lower.row_data(col_index);
+			row[col_index] = (row[col_index] - matrix_kernel::dot(col_index - first_col, row + first_col,
+										  pivot_row + first_col)) /
+					pivot_row[col_index];
+		}
+	};
+
+	for (size_t row_index = first_col; row_index < last_col; ++row_index)
+	{
+		Element* row = lower_rows.row_data(row_index);
+		eliminate_row(row, row_index);
+		const Element pivot =
+				row[row_index] - matrix_kernel::dot(row_index - first_col, row + first_col, row + first_col);
+		if (not(pivot > 0))
+			return false;
+		row[row_index] = sqrt(pivot);
+	}
+
+	// rows below the diagonal block only depend on it
+	matrix_helper::parallel_for(size - last_col, panel_width * panel_width, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = last_col + begin; row_index < last_col + end; ++row_index)
+			eliminate_row(lower_rows.row_data(row_index), last_col);
+	});
+	return true;
+}
+
+template <Elementable Element>
+size_t CholeskyDecomposition<Element>::get_size() const noexcept
+{
+	return lower.get_number_of_row();
+}
+
+template <Elementable Element>
+const Matrix<Element>& CholeskyDecomposition<Element>::get_lower() const noexcept
+{
+	return lower;
+}
+
+template <Elementable Element>
+bool CholeskyDecomposition<Element>::is_positive_definite() const noexcept
+{
+	return positive_definite;
+}
+
+template <Elementable Element>
+Element CholeskyDecomposition<Element>::determinant() const
+{
+	check_positive_definite();
+
+	Element det = 1;
+	for (size_t i = 0; i < get_size(); ++i)
+		det *= lower.row_data(i)[i] * lower.row_data(i)[i];
+	return det;
+}
+
+template <Elementable Element>
+Element CholeskyDecomposition<Element>::log_determinant() const
+{
+	check_positive_definite();
+
+	using std::log;
+	Element log_det = 0;
+	for (size_t i = 0; i < get_size(); ++i)
+		log_det += log(lower.row_data(i)[i]);
+	return 2 * log_det;
+}
+
+template <Elementable Element>
+Matrix<Element> CholeskyDecomposition<Element>::inverse() const
+{
+	return solve(Matrix<Element>::create_i_matrix(get_size()));
+}
+
+template <Elementable Element>
+Matrix<Element> CholeskyDecomposition<Element>::solve(const Matrix<Element>& b) const
+{
+	const size_t size = get_size();
+	if (b.get_number_of_row() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+	check_positive_definite();
+
+	Matrix<Element> x = b;
+	Element* const x_data = x.mutable_rows().row_data(0);
+	const size_t number_of_rhs = x.get_number_of_col();
+	matrix_helper::parallel_for(number_of_rhs, size * size, [&](size_t begin, size_t end)
+	{
+		substitute(x_data + begin, end - begin, x.get_stride());
+	});
+	return x;
+}
+
+template <Elementable Element>
+std::vector<Element> CholeskyDecomposition<Element>::solve(const std::vector<Element>& b) const
+{
+	if (b.size() != get_size())
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+	check_positive_definite();
+
+	std::vector<Element> x = b;
+	substitute(x.data(), 1, 1);
+	return x;
+}
+
+template <Elementable Element>
+void CholeskyDecomposition<Element>::check_positive_definite() const
+{
+	if (not positive_definite)
+		throw std::invalid_argument("the matrix should be positive definite!");
+}
+
+template <Elementable Element>
+void CholeskyDecomposition<Element>::substitute(Element* x, size_t number_of_rhs, size_t x_stride) const
+{
+	const size_t size = get_size();
+	matrix_kernel::trsm_lower(size, number_of_rhs, lower.get_data(), lower.get_stride(), false, x, x_stride);
+	matrix_kernel::trsm_lower_transpose(size, number_of_rhs, lower.get_data(), lower.get_stride(), false, x,
+			x_stride);
+}
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef MATRIX_CHOLESKY_DECOMPOSITION_H
+#define MATRIX_CHOLESKY_DECOMPOSITION_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+
+// A = L * L^T for a symmetric positive definite A. Only the lower triangle of A is read unless check_symmetric is
+// set; a non-positive pivot marks the matrix as not positive definite instead of throwing, so callers can fall back
+// to LU.
+template <Elementable Element>
+class CholeskyDecomposition
+{
+public:
+	explicit CholeskyDecomposition(const Matrix<Element>& matrix, bool check_symmetric = false);
+
+	[[nodiscard]] size_t get_size() const noexcept;
+	[[nodiscard]] const Matrix<Element>& get_lower() const noexcept;
+	[[nodiscard]] bool is_positive_definite() const noexcept;
+
+	[[nodiscard]] Element determinant() const;
+	// log(det(A)) = 2 * sum(log(L[i][i])), finite where determinant() would overflow
+	[[nodiscard]] Element log_determinant() const;
+	[[nodiscard]] Matrix<Element> inverse() const;
+
+	// A * X = B for every column of B
+	[[nodiscard]] Matrix<Element> solve(const Matrix<Element>& b) const;
+	[[nodiscard]] std::vector<Element> solve(const std::vector<Element>& b) const;
+
+private:
+	static constexpr size_t BLOCK_SIZE = 64;
+
+	// returns false at the first non-positive pivot
+	bool factorize_panel(size_t first_col, size_t last_col);
+
+	void check_positive_definite() const;
+
+	// X = L^-T * L^-1 * X for the n x number_of_rhs row-major block X
+	void substitute(Element* x, size_t number_of_rhs, size_t x_stride) const;
+
+	// upper triangle is zero
+	Matrix<Element> lower;
+	bool positive_definite = true;
+};
+
+#include "cholesky-decomposition-tmp.h"
+
+#endif
@@ -104,12 +104,23 @@ concept Containerable = requires(Container c, Element e) {
 	typename Element;
 };
 
+namespace concept_helper
+{
+using std::to_string;
+
+// std::to_string for arithmetic types, a to_string next to the type (found by ADL) for the others
+template <typename Element>
+concept Stringable = requires(Element e) {
+	{ to_string(e) } -> std::same_as<std::string>;
+};
+}		 // namespace concept_helper
+
 template <typename Element>
 concept Elementable = requires(Element e) {
 	requires Multiplicationable<Element>;
 	requires Sumable<Element>;
 	requires Symmetryable<Element>;
-	{ std::to_string(e) } -> std::same_as<std::string>;
+	requires concept_helper::Stringable<Element>;
 };
 
 template <typename Matrix>
@@ -138,6 +149,15 @@ concept Polynomialable = requires(Coefficientable first_coefficient, Coefficient
 	} -> std::same_as<bool>;
 };
 
+// y = A * x for vectors of the operator's size, all that iterative methods need from a matrix: either a callable
+// apply(x, y) or a matrix with multiply(x, y)
+template <typename Operator, typename Element>
+concept LinearOperator = requires(const Operator& apply, const Element* x, Element* y) {
+	apply(x, y);
+} or requires(const Operator& matrix, const Element* x, Element* y) {
+	matrix.multiply(x, y);
+};
+
 template <typename Element>
 concept Numberable = std::is_arithmetic_v<Element>;
 
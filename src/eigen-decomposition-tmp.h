@@ -0,0 +1,513 @@
+#ifndef MATRIX_EIGEN_DECOMPOSITION_TMP_H
+#define MATRIX_EIGEN_DECOMPOSITION_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "eigen-decomposition.h"
+#include "hessenberg-decomposition.h"
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+
+template <Elementable Element>
+EigenDecomposition<Element>::EigenDecomposition(const Matrix<Element>& matrix, bool compute_eigenvectors)
+: real_part(matrix.get_number_of_row())
+, imaginary_part(matrix.get_number_of_row())
+, compute_eigenvectors(compute_eigenvectors)
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	HessenbergDecomposition<Element> hessenberg(matrix, compute_eigenvectors);
+	Matrix<Element> h = hessenberg.get_hessenberg();
+	if (compute_eigenvectors)
+		vectors = hessenberg.get_q().transpose();
+
+	francis_qr(h);
+	if (compute_eigenvectors)
+		back_substitute(h);
+
+	eigenvalues.resize(get_size());
+	for (size_t i = 0; i < get_size(); ++i)
+		eigenvalues[i] = std::complex<Element>(real_part[i], imaginary_part[i]);
+}
+
+// EISPACK hqr2 on a row-major matrix. Indices are signed because the active window shrinks below zero.
+template <Elementable Element>
+void EigenDecomposition<Element>::francis_qr(Matrix<Element>& h)
+{
+	using std::abs;
+	using std::sqrt;
+	using Index = std::ptrdiff_t;
+
+	const Index size = static_cast<Index>(get_size());
+	const Element eps = std::numeric_limits<Element>::epsilon();
+	const auto h_rows = h.mutable_rows();
+	const auto vectors_rows = vectors.mutable_rows();
+	auto H = [&h_rows](Index i, Index j) -> Element& { return h_rows.row_data(static_cast<size_t>(i))[j]; };
+	// without eigenvectors only the active window [low, n] of H has to be kept up to date
+	const bool full_update = compute_eigenvectors;
+
+	for (Index i = 0; i < size; ++i)
+	{
+		for (Index j = std::max<Index>(i - 1, 0); j < size; ++j)
+			norm += abs(H(i, j));
+	}
+
+	// below this a subdiagonal element is dropped whatever its neighbours, otherwise a block of rounding noise never
+	// converges because its products underflow
+	const Element negligible = std::max(norm * eps * eps, std::numeric_limits<Element>::min());
+
+	Index n = size - 1;
+	Element exceptional_shift = 0;
+	size_t iteration = 0;
+	Element p = 0, q = 0, r = 0, s = 0, z = 0, w, x, y;
+	while (n >= 0)
+	{
+		// look for a single small subdiagonal element
+		Index l = n;
+		while (l > 0)
+		{
+			s = abs(H(l - 1, l - 1)) + abs(H(l, l));
+			if (s == 0)
+				s = norm;
+			if (abs(H(l, l - 1)) < eps * s or abs(H(l, l - 1)) <= negligible)
+				break;
+			--l;
+		}
+
+		if (l == n)
+		{
+			// one real root
+			H(n, n) += exceptional_shift;
+			real_part[n] = H(n, n);
+			imaginary_part[n] = 0;
+			--n;
+			iteration = 0;
+		}
+		else if (l == n - 1)
+		{
+			// two roots, split the 2x2 block into a real pair or keep it as a complex pair
+			w = H(n, n - 1) * H(n - 1, n);
+			p = (H(n - 1, n - 1) - H(n, n)) / 2;
+			q = p * p + w;
+			z = sqrt(abs(q));
+			H(n, n) += exceptional_shift;
+			H(n - 1, n - 1) += exceptional_shift;
+			x = H(n, n);
+
+			if (q >= 0)
+			{
+				z = p >= 0 ? p + z : p - z;
+				real_part[n - 1] = x + z;
+				real_part[n] = z != 0 ? x - w / z : x + z;
+				imaginary_part[n - 1] = 0;
+				imaginary_part[n] = 0;
+				x = H(n, n - 1);
+				s = abs(x) + abs(z);
+				p = x / s;
+				q = z / s;
+				r = sqrt(p * p + q * q);
+				p = p / r;
+				q = q / r;
+
+				for (Index j = n - 1; j < (full_update ? size : n + 1); ++j)
+				{
+					z = H(n - 1, j);
+					H(n - 1, j) = q * z + p * H(n, j);
+					H(n, j) = q * H(n, j) - p * z;
+				}
+				for (Index i = full_update ? 0 : l; i <= n; ++i)
+				{
+					z = H(i, n - 1);
+					H(i, n - 1) = q * z + p * H(i, n);
+					H(i, n) = q * H(i, n) - p * z;
+				}
+				if (compute_eigenvectors)
+					matrix_kernel::rotate(get_size(), q, -p, vectors_rows.row_data(static_cast<size_t>(n - 1)),
+							vectors_rows.row_data(static_cast<size_t>(n)));
+			}
+			else
+			{
+				real_part[n - 1] = x + p;
+				real_part[n] = x + p;
+				imaginary_part[n - 1] = z;
+				imaginary_part[n] = -z;
+			}
+			n -= 2;
+			iteration = 0;
+		}
+		else
+		{
+			if (iteration == MAX_ITERATION_PER_EIGENVALUE)
+				throw std::runtime_error("the QR algorithm did not converge!");
+
+			// Francis shift from the trailing 2x2 block
+			x = H(n, n);
+			y = H(n - 1, n - 1);
+			w = H(n, n - 1) * H(n - 1, n);
+
+			// exceptional shifts break the rare cycles of the plain Francis shift
+			if (iteration == 10)
+			{
+				exceptional_shift += x;
+				for (Index i = 0; i <= n; ++i)
+					H(i, i) -= x;
+				s = abs(H(n, n - 1)) + abs(H(n - 1, n - 2));
+				x = y = Element(0.75) * s;
+				w = Element(-0.4375) * s * s;
+			}
+			if (iteration == 30)
+			{
+				s = (y - x) / 2;
+				s = s * s + w;
+				if (s > 0)
+				{
+					s = sqrt(s);
+					if (y < x)
+						s = -s;
+					s = x - w / ((y - x) / 2 + s);
+					for (Index i = 0; i <= n; ++i)
+						H(i, i) -= s;
+					exceptional_shift += s;
+					x = y = w = Element(0.964);
+				}
+			}
+			++iteration;
+
+			// look for two consecutive small subdiagonal elements
+			Index m = n - 2;
+			while (m >= l)
+			{
+				z = H(m, m);
+				r = x - z;
+				s = y - z;
+				p = (r * s - w) / H(m + 1, m) + H(m, m + 1);
+				q = H(m + 1, m + 1) - z - r - s;
+				r = H(m + 2, m + 1);
+				s = abs(p) + abs(q) + abs(r);
+				p = p / s;
+				q = q / s;
+				r = r / s;
+				if (m == l)
+					break;
+				if (abs(H(m, m - 1)) * (abs(q) + abs(r)) <
+						eps * (abs(p) * (abs(H(m - 1, m - 1)) + abs(z) + abs(H(m + 1, m + 1)))))
+					break;
+				--m;
+			}
+			for (Index i = m + 2; i <= n; ++i)
+			{
+				H(i, i - 2) = 0;
+				if (i > m + 2)
+					H(i, i - 3) = 0;
+			}
+
+			// double QR step on rows l:n and columns m:n, chasing a 3x3 reflector down the subdiagonal
+			for (Index k = m; k <= n - 1; ++k)
+			{
+				const bool not_last = k != n - 1;
+				if (k != m)
+				{
+					p = H(k, k - 1);
+					q = H(k + 1, k - 1);
+					r = not_last ? H(k + 2, k - 1) : Element(0);
+					x = abs(p) + abs(q) + abs(r);
+					if (x == 0)
+						continue;
+					p = p / x;
+					q = q / x;
+					r = r / x;
+				}
+
+				s = sqrt(p * p + q * q + r * r);
+				if (p < 0)
+					s = -s;
+				if (s == 0)
+					continue;
+
+				if (k != m)
+					H(k, k - 1) = -s * x;
+				else if (l != m)
+					H(k, k - 1) = -H(k, k - 1);
+				p = p + s;
+				x = p / s;
+				y = q / s;
+				z = r / s;
+				q = q / p;
+				r = r / p;
+
+				// the reflector from the left mixes rows k:k+2
+				auto apply_to_rows = [&](const auto& target, Index first_col, Index last_col)
+				{
+					Element* row_k = target.row_data(static_cast<size_t>(k));
+					Element* row_k1 = target.row_data(static_cast<size_t>(k + 1));
+					Element* row_k2 = not_last ? target.row_data(static_cast<size_t>(k + 2)) : nullptr;
+					for (Index j = first_col; j < last_col; ++j)
+					{
+						Element product = row_k[j] + q * row_k1[j];
+						if (not_last)
+						{
+							product = product + r * row_k2[j];
+							row_k2[j] = row_k2[j] - product * z;
+						}
+						row_k[j] = row_k[j] - product * x;
+						row_k1[j] = row_k1[j] - product * y;
+					}
+				};
+				apply_to_rows(h_rows, k, full_update ? size : n + 1);
+
+				for (Index i = full_update ? 0 : l; i <= std::min(n, k + 3); ++i)
+				{
+					Element* row = &H(i, k);
+					p = x * row[0] + y * row[1];
+					if (not_last)
+					{
+						p = p + z * row[2];
+						row[2] = row[2] - p * r;
+					}
+					row[0] = row[0] - p;
+					row[1] = row[1] - p * q;
+				}
+				// the reflector is symmetric, so V * P is P * V^T in the transposed storage
+				if (compute_eigenvectors)
+					apply_to_rows(vectors_rows, 0, size);
+			}
+		}
+	}
+}
+
+// EISPACK hqr2 back substitution: solve (T - lambda * I) * x = 0 upwards for every eigenvalue of the Schur form T,
+// storing x over the upper triangle of T
+template <Elementable Element>
+void EigenDecomposition<Element>::back_substitute(Matrix<Element>& h)
+{
+	using std::abs;
+	using Index = std::ptrdiff_t;
+	using Complex = std::complex<Element>;
+
+	const Index size = static_cast<Index>(get_size());
+	const Element eps = std::numeric_limits<Element>::epsilon();
+	const auto h_rows = h.mutable_rows();
+	auto H = [&h_rows](Index i, Index j) -> Element& { return h_rows.row_data(static_cast<size_t>(i))[j]; };
+	if (norm == 0)
+		return;
+
+	Element r = 0, s = 0, t, w, x, y, z = 0;
+	for (Index n = size - 1; n >= 0; --n)
+	{
+		const Element p = real_part[n];
+		const Element q = imaginary_part[n];
+
+		if (q == 0)
+		{
+			// real vector
+			Index l = n;
+			H(n, n) = 1;
+			for (Index i = n - 1; i >= 0; --i)
+			{
+				w = H(i, i) - p;
+				r = 0;
+				for (Index j = l; j <= n; ++j)
+					r = r + H(i, j) * H(j, n);
+				if (imaginary_part[i] < 0)
+				{
+					z = w;
+					s = r;
+					continue;
+				}
+
+				l = i;
+				if (imaginary_part[i] == 0)
+				{
+					H(i, n) = w != 0 ? -r / w : -r / (eps * norm);
+				}
+				else
+				{
+					x = H(i, i + 1);
+					y = H(i + 1, i);
+					const Element denominator =
+							(real_part[i] - p) * (real_part[i] - p) + imaginary_part[i] * imaginary_part[i];
+					t = (x * s - z * r) / denominator;
+					H(i, n) = t;
+					H(i + 1, n) = abs(x) > abs(z) ? (-r - w * t) / x : (-s - y * t) / z;
+				}
+
+				// overflow control
+				t = abs(H(i, n));
+				if ((eps * t) * t > 1)
+				{
+					for (Index j = i; j <= n; ++j)
+						H(j, n) = H(j, n) / t;
+				}
+			}
+		}
+		else if (q < 0)
+		{
+			// complex vector of the pair (n - 1, n), real part in column n - 1 and imaginary part in column n
+			Index l = n - 1;
+			if (abs(H(n, n - 1)) > abs(H(n - 1, n)))
+			{
+				H(n - 1, n - 1) = q / H(n, n - 1);
+				H(n - 1, n) = -(H(n, n) - p) / H(n, n - 1);
+			}
+			else
+			{
+				const Complex value = Complex(0, -H(n - 1, n)) / Complex(H(n - 1, n - 1) - p, q);
+				H(n - 1, n - 1) = value.real();
+				H(n - 1, n) = value.imag();
+			}
+			H(n, n - 1) = 0;
+			H(n, n) = 1;
+
+			Element ra, sa;
+			for (Index i = n - 2; i >= 0; --i)
+			{
+				ra = 0;
+				sa = 0;
+				for (Index j = l; j <= n; ++j)
+				{
+					ra = ra + H(i, j) * H(j, n - 1);
+					sa = sa + H(i, j) * H(j, n);
+				}
+				w = H(i, i) - p;
+
+				if (imaginary_part[i] < 0)
+				{
+					z = w;
+					r = ra;
+					s = sa;
+					continue;
+				}
+
+				l = i;
+				if (imaginary_part[i] == 0)
+				{
+					const Complex value = Complex(-ra, -sa) / Complex(w, q);
+					H(i, n - 1) = value.real();
+					H(i, n) = value.imag();
+				}
+				else
+				{
+					x = H(i, i + 1);
+					y = H(i + 1, i);
+					Element vr = (real_part[i] - p) * (real_part[i] - p) + imaginary_part[i] * imaginary_part[i] -
+							q * q;
+					const Element vi = (real_part[i] - p) * 2 * q;
+					if (vr == 0 and vi == 0)
+						vr = eps * norm * (abs(w) + abs(q) + abs(x) + abs(y) + abs(z));
+					const Complex value =
+							Complex(x * r - z * ra + q * sa, x * s - z * sa - q * ra) / Complex(vr, vi);
+					H(i, n - 1) = value.real();
+					H(i, n) = value.imag();
+					if (abs(x) > (abs(z) + abs(q)))
+					{
+						H(i + 1, n - 1) = (-ra - w * H(i, n - 1) + q * H(i, n)) / x;
+						H(i + 1, n) = (-sa - w * H(i, n) - q * H(i, n - 1)) / x;
+					}
+					else
+					{
+						const Complex next = Complex(-r - y * H(i, n - 1), -s - y * H(i, n)) / Complex(z, q);
+						H(i + 1, n - 1) = next.real();
+						H(i + 1, n) = next.imag();
+					}
+				}
+
+				// overflow control
+				t = std::max(abs(H(i, n - 1)), abs(H(i, n)));
+				if ((eps * t) * t > 1)
+				{
+					for (Index j = i; j <= n; ++j)
+					{
+						H(j, n - 1) = H(j, n - 1) / t;
+						H(j, n) = H(j, n) / t;
+					}
+				}
+			}
+		}
+	}
+
+	// V = V * X with X the upper triangle of h, i.e. V^T = X^T * V^T in the transposed storage
+	const size_t number_of_col = get_size();
+	for (size_t row_index = 1; row_index < number_of_col; ++row_index)
+		std::fill_n(h_rows.row_data(row_index), row_index, Element(0));
+	const Matrix<Element> x_transpose = h.transpose();
+	Matrix<Element> result(number_of_col, number_of_col);
+	matrix_kernel::gemm(number_of_col, number_of_col, number_of_col, x_transpose.get_data(), x_transpose.get_stride(),
+			vectors.get_data(), vectors.get_stride(), result.mutable_rows().row_data(0), result.get_stride());
+	vectors = std::move(result);
+}
+
+template <Elementable Element>
+size_t EigenDecomposition<Element>::get_size() const noexcept
+{
+	return real_part.size();
+}
+
+template <Elementable Element>
+auto EigenDecomposition<Element>::get_eigenvalues() const noexcept -> const std::vector<std::complex<Element>>&
+{
+	return eigenvalues;
+}
+
+template <Elementable Element>
+std::vector<Element> EigenDecomposition<Element>::get_real_eigenvalues() const
+{
+	std::vector<Element> result;
+	for (const std::complex<Element>& eigenvalue : eigenvalues)
+	{
+		if (eigenvalue.imag() == 0)
+			result.push_back(eigenvalue.real());
+	}
+	return result;
+}
+
+template <Elementable Element>
+bool EigenDecomposition<Element>::has_eigenvectors() const noexcept
+{
+	return compute_eigenvectors;
+}
+
+template <Elementable Element>
+auto EigenDecomposition<Element>::get_eigenvectors() const -> std::vector<std::vector<std::complex<Element>>>
+{
+	if (not compute_eigenvectors)
+		throw std::invalid_argument("the eigenvectors were not computed!");
+
+	using std::sqrt;
+	const size_t size = get_size();
+	std::vector<std::vector<std::complex<Element>>> result(size, std::vector<std::complex<Element>>(size));
+	for (size_t j = 0; j < size; ++j)
+	{
+		std::vector<std::complex<Element>>& eigenvector = result[j];
+		if (imaginary_part[j] == 0)
+		{
+			for (size_t i = 0; i < size; ++i)
+				eigenvector[i] = vectors[j][i];
+		}
+		else
+		{
+			// rows (j, j + 1) for the first of the pair, the conjugate for the second
+			const size_t real_row = imaginary_part[j] > 0 ? j : j - 1;
+			const Element sign = imaginary_part[j] > 0 ? 1 : -1;
+			for (size_t i = 0; i < size; ++i)
+				eigenvector[i] = std::complex<Element>(vectors[real_row][i], sign * vectors[real_row + 1][i]);
+		}
+
+		Element norm_square = 0;
+		for (const std::complex<Element>& element : eigenvector)
+			norm_square += std::norm(element);
+		if (norm_square > 0)
+		{
+			const Element inverse_norm = 1 / sqrt(norm_square);
+			for (std::complex<Element>& element : eigenvector)
+				element *= inverse_norm;
+		}
+	}
+	return result;
+}
+
+#endif
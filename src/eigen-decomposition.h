@@ -0,0 +1,51 @@
+#ifndef MATRIX_EIGEN_DECOMPOSITION_H
+#define MATRIX_EIGEN_DECOMPOSITION_H
+
+#include <complex>
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+
+// Eigenvalues of a real square matrix: Householder reduction to Hessenberg form, then implicitly shifted Francis
+// double-shift QR down to real Schur form. Complex eigenvalues come in conjugate pairs, positive imaginary part
+// first. Eigenvectors are back-substituted from the Schur form only when asked for.
+template <Elementable Element>
+class EigenDecomposition
+{
+public:
+	explicit EigenDecomposition(const Matrix<Element>& matrix, bool compute_eigenvectors = false);
+
+	[[nodiscard]] size_t get_size() const noexcept;
+	[[nodiscard]] const std::vector<std::complex<Element>>& get_eigenvalues() const noexcept;
+	// eigenvalues whose imaginary part is zero, in the same order
+	[[nodiscard]] std::vector<Element> get_real_eigenvalues() const;
+
+	[[nodiscard]] bool has_eigenvectors() const noexcept;
+	// eigenvectors[j] belongs to get_eigenvalues()[j], scaled to unit 2-norm
+	[[nodiscard]] std::vector<std::vector<std::complex<Element>>> get_eigenvectors() const;
+
+private:
+	static constexpr size_t MAX_ITERATION_PER_EIGENVALUE = 100;
+
+	// h is reduced to real Schur form in place, transformations are accumulated into vectors when compute_eigenvectors
+	void francis_qr(Matrix<Element>& h);
+	// eigenvectors of the Schur form, then multiplied back by the accumulated transformations
+	void back_substitute(Matrix<Element>& h);
+
+	// real parts and imaginary parts of the eigenvalues while iterating
+	std::vector<Element> real_part;
+	std::vector<Element> imaginary_part;
+	std::vector<std::complex<Element>> eigenvalues;
+	bool compute_eigenvectors;
+	// transposed so that every update of the QR sweep is a row update: row j is a real eigenvector, or rows (j, j + 1)
+	// are the real and imaginary parts of the eigenvector of a complex pair
+	Matrix<Element> vectors;
+	Element norm = 0;
+};
+
+#include "eigen-decomposition-tmp.h"
+
+#endif
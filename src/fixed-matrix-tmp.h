@@ -0,0 +1,576 @@
+#ifndef MATRIX_FIXED_MATRIX_TMP_H
+#define MATRIX_FIXED_MATRIX_TMP_H
+
+#include <limits>
+#include <stdexcept>
+
+#include "fixed-matrix.h"
+#include "matrix-helper.h"
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col>::FixedMatrix() noexcept
+: storage{}
+{
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col>::FixedMatrix(
+		const std::initializer_list<std::initializer_list<Element>>& matrix)
+: storage{}
+{
+	if (matrix.size() != Row)
+		throw std::invalid_argument("Cannot creat matrix with different row size.");
+
+	size_t index = 0;
+	for (const auto& row_of_matrix : matrix)
+	{
+		if (row_of_matrix.size() != Col)
+			throw std::invalid_argument("Cannot creat matrix with different column size.");
+
+		for (const Element& element : row_of_matrix)
+			storage[index++] = element;
+	}
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+template <typename ViewElement>
+	requires std::same_as<std::remove_const_t<ViewElement>, Element>
+FixedMatrix<Element, Row, Col>::FixedMatrix(const MatrixView<ViewElement>& matrix)
+: storage{}
+{
+	if (matrix.get_number_of_row() != Row or matrix.get_number_of_col() != Col)
+		throw std::invalid_argument("Cannot creat fixed matrix from a matrix of different size.");
+
+	for (size_t row_index = 0; row_index < Row; ++row_index)
+	{
+		const RowView<ViewElement> row_of_matrix = matrix[row_index];
+		std::copy(row_of_matrix.begin(), row_of_matrix.end(), storage.begin() + row_index * Col);
+	}
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+FixedMatrix<Element, Row, Col>::FixedMatrix(const Matrix<Element>& matrix)
+: FixedMatrix(matrix.view())
+{
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col> FixedMatrix<Element, Row, Col>::create_i_matrix() noexcept
+	requires(Row == Col)
+{
+	FixedMatrix result;
+	matrix_helper::static_for<Row>([&result](size_t i) { result.storage[i * Col + i] = 1; });
+	return result;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+auto FixedMatrix<Element, Row, Col>::get_table() const -> TableType
+{
+	TableType result;
+	result.reserve(Row);
+	for (size_t row_index = 0; row_index < Row; ++row_index)
+		result.emplace_back(storage.begin() + row_index * Col, storage.begin() + (row_index + 1) * Col);
+	return result;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr size_t FixedMatrix<Element, Row, Col>::get_number_of_row() noexcept
+{
+	return Row;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr size_t FixedMatrix<Element, Row, Col>::get_number_of_col() noexcept
+{
+	return Col;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr size_t FixedMatrix<Element, Row, Col>::get_stride() noexcept
+{
+	return Col;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr const Element* FixedMatrix<Element, Row, Col>::get_data() const noexcept
+{
+	return storage.data();
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+MatrixView<const Element> FixedMatrix<Element, Row, Col>::view() const noexcept
+{
+	return MatrixView<const Element>(storage.data(), Row, Col, Col);
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+FixedMatrix<Element, Row, Col>::operator MatrixView<const Element>() const noexcept
+{
+	return view();
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+FixedMatrix<Element, Row, Col>::operator Matrix<Element>() const
+{
+	return Matrix<Element>(view());
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr std::span<Element, Col> FixedMatrix<Element, Row, Col>::operator[](size_t idx) noexcept
+{
+	return std::span<Element, Col>(storage.data() + idx * Col, Col);
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr std::span<const Element, Col> FixedMatrix<Element, Row, Col>::operator[](size_t idx) const noexcept
+{
+	return std::span<const Element, Col>(storage.data() + idx * Col, Col);
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr Element FixedMatrix<Element, Row, Col>::at(size_t row_index, size_t col_index) const noexcept
+{
+	return storage[row_index * Col + col_index];
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col> FixedMatrix<Element, Row, Col>::sum(const FixedMatrix& other) const noexcept
+{
+	FixedMatrix result = *this;
+	result += other;
+	return result;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col> FixedMatrix<Element, Row, Col>::operator+(
+		const FixedMatrix& other) const noexcept
+{
+	return sum(other);
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col>& FixedMatrix<Element, Row, Col>::operator+=(const FixedMatrix& other) noexcept
+{
+	matrix_helper::static_for<Row * Col>([&](size_t i) { storage[i] += other.storage[i]; });
+	return *this;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col> FixedMatrix<Element, Row, Col>::operator-() const noexcept
+{
+	FixedMatrix result;
+	matrix_helper::static_for<Row * Col>([&](size_t i) { result.storage[i] = -storage[i]; });
+	return result;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col> FixedMatrix<Element, Row, Col>::submission(
+		const FixedMatrix& other) const noexcept
+{
+	FixedMatrix result = *this;
+	result -= other;
+	return result;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col> FixedMatrix<Element, Row, Col>::operator-(
+		const FixedMatrix& other) const noexcept
+{
+	return submission(other);
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col>& FixedMatrix<Element, Row, Col>::operator-=(const FixedMatrix& other) noexcept
+{
+	matrix_helper::static_for<Row * Col>([&](size_t i) { storage[i] -= other.storage[i]; });
+	return *this;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+template <size_t OtherCol>
+constexpr FixedMatrix<Element, Row, OtherCol> FixedMatrix<Element, Row, Col>::multiple(
+		const FixedMatrix<Element, Col, OtherCol>& other) const noexcept
+{
+	FixedMatrix<Element, Row, OtherCol> result;
+	matrix_helper::static_for<Row>([&](size_t i)
+	{
+		matrix_helper::static_for<OtherCol>([&](size_t j)
+		{
+			Element element = Element(0);
+			matrix_helper::static_for<Col>([&](size_t k)
+			{
+				element += storage[i * Col + k] * other.storage[k * OtherCol + j];
+			});
+			result.storage[i * OtherCol + j] = element;
+		});
+	});
+	return result;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+template <typename OtherElement>
+	requires(not IsMatrixable<OtherElement>) and MultiplableDifferentType<Element, OtherElement>
+constexpr FixedMatrix<Element, Row, Col> FixedMatrix<Element, Row, Col>::multiple(
+		const OtherElement& other) const noexcept
+{
+	FixedMatrix result = *this;
+	result *= other;
+	return result;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+template <size_t OtherCol>
+constexpr FixedMatrix<Element, Row, OtherCol> FixedMatrix<Element, Row, Col>::operator*(
+		const FixedMatrix<Element, Col, OtherCol>& other) const noexcept
+{
+	return multiple(other);
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+template <typename OtherElement>
+	requires(not IsMatrixable<OtherElement>) and MultiplableDifferentType<Element, OtherElement>
+constexpr FixedMatrix<Element, Row, Col> FixedMatrix<Element, Row, Col>::operator*(
+		const OtherElement& other) const noexcept
+{
+	return multiple(other);
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col>& FixedMatrix<Element, Row, Col>::operator*=(const FixedMatrix& other) noexcept
+	requires(Row == Col)
+{
+	*this = multiple(other);
+	return *this;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+template <typename OtherElement>
+	requires(not IsMatrixable<OtherElement>) and MultiplableDifferentType<Element, OtherElement>
+constexpr FixedMatrix<Element, Row, Col>& FixedMatrix<Element, Row, Col>::operator*=(const OtherElement& other) noexcept
+{
+	matrix_helper::static_for<Row * Col>([&](size_t i)
+	{
+		Element& element = storage[i];
+		if constexpr (MultipleAssignableDifferentType<Element, OtherElement>)
+			element *= other;
+		else if constexpr (MultiplableDifferentTypeReturnFirstType<Element, OtherElement>)
+			element = element * other;
+		else if constexpr (MultiplableDifferentTypeReturnSecondType<Element, OtherElement>)
+			element = other * element;
+	});
+	return *this;
+}
+
+template <typename OtherElement, Elementable Element, size_t Row, size_t Col>
+	requires(not IsMatrixable<OtherElement>) and MultiplableDifferentType<Element, OtherElement>
+constexpr FixedMatrix<Element, Row, Col> operator*(const OtherElement& number,
+		const FixedMatrix<Element, Row, Col>& matrix) noexcept
+{
+	return matrix * number;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr Element FixedMatrix<Element, Row, Col>::minor(size_t first_row, size_t second_row, size_t first_col,
+		size_t second_col) const noexcept
+{
+	return at(first_row, first_col) * at(second_row, second_col) -
+			at(second_row, first_col) * at(first_row, second_col);
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr Element FixedMatrix<Element, Row, Col>::determinant() const
+	requires(Row == Col)
+{
+	if constexpr (Row == 0)
+	{
+		return 1;
+	}
+	else if constexpr (Row == 1)
+	{
+		return storage[0];
+	}
+	else if constexpr (Row == 2)
+	{
+		return minor(0, 1, 0, 1);
+	}
+	else if constexpr (Row == 3)
+	{
+		return at(0, 0) * minor(1, 2, 1, 2) - at(0, 1) * minor(1, 2, 0, 2) + at(0, 2) * minor(1, 2, 0, 1);
+	}
+	else if constexpr (Row == 4)
+	{
+		// Laplace expansion over the 2x2 minors of the first two and the last two rows
+		return minor(0, 1, 0, 1) * minor(2, 3, 2, 3) - minor(0, 1, 0, 2) * minor(2, 3, 1, 3) +
+				minor(0, 1, 0, 3) * minor(2, 3, 1, 2) + minor(0, 1, 1, 2) * minor(2, 3, 0, 3) -
+				minor(0, 1, 1, 3) * minor(2, 3, 0, 2) + minor(0, 1, 2, 3) * minor(2, 3, 0, 1);
+	}
+	else if constexpr (Integrable<Element>)
+	{
+		// elimination in Element would truncate every ratio
+		std::array<matrix_helper::WideInteger, Row * Col> right{};
+		bool negative = false;
+		bool overflow = false;
+		const matrix_helper::WideInteger pivot = bareiss(false, right, negative, overflow);
+		// a minor outgrew the wide type, the determinant itself may still fit
+		if (overflow)
+			return Matrix<Element>(view()).modular_determinant();
+		return narrow(negative ? -pivot : pivot);
+	}
+	else
+	{
+		FixedMatrix tmp_table = *this;
+		bool is_negative = false;
+		for (size_t col_index = 0; col_index < Col; ++col_index)
+		{
+			size_t pivot_row_index = col_index;
+			while (pivot_row_index < Row and tmp_table.at(pivot_row_index, col_index) == 0)
+				++pivot_row_index;
+
+			if (pivot_row_index == Row)
+				return 0;
+			if (pivot_row_index != col_index)
+			{
+				std::swap_ranges(tmp_table.storage.begin() + pivot_row_index * Col,
+						tmp_table.storage.begin() + (pivot_row_index + 1) * Col,
+						tmp_table.storage.begin() + col_index * Col);
+				is_negative = not is_negative;
+			}
+
+			const Element pivot = tmp_table.at(col_index, col_index);
+			for (size_t row_index = col_index + 1; row_index < Row; ++row_index)
+			{
+				const Element ratio = tmp_table.at(row_index, col_index) / pivot;
+				for (size_t i = col_index; i < Col; ++i)
+					tmp_table.storage[row_index * Col + i] -= ratio * tmp_table.storage[col_index * Col + i];
+			}
+		}
+
+		Element det = 1;
+		matrix_helper::static_for<Row>([&](size_t i) { det *= tmp_table.at(i, i); });
+		return is_negative ? -det : det;
+	}
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Col, Row> FixedMatrix<Element, Row, Col>::transpose() const noexcept
+{
+	FixedMatrix<Element, Col, Row> result;
+	matrix_helper::static_for<Row>([&](size_t i)
+	{
+		matrix_helper::static_for<Col>([&](size_t j) { result.storage[j * Row + i] = storage[i * Col + j]; });
+	});
+	return result;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr FixedMatrix<Element, Row, Col> FixedMatrix<Element, Row, Col>::inverse() const
+	requires(Row == Col)
+{
+	if constexpr (Row > 4 and Integrable<Element>)
+	{
+		// one elimination finds both the determinant and pivot * A^-1, which is exact, so each element is truncated
+		// once like the adjugate over determinant below
+		std::array<matrix_helper::WideInteger, Row * Col> right{};
+		bool negative = false;
+		bool overflow = false;
+		const matrix_helper::WideInteger pivot = bareiss(true, right, negative, overflow);
+		if (overflow)
+			throw std::overflow_error("a minor of the matrix does not fit in the wide integer type!");
+		if (pivot == 0)
+			throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+
+		FixedMatrix result;
+		matrix_helper::static_for<Row * Col>([&](size_t i) { result.storage[i] = narrow(right[i] / pivot); });
+		return result;
+	}
+	else
+	{
+		const Element det = determinant();
+		if (det == 0)
+			throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+
+		FixedMatrix result;
+		if constexpr (Row == 1)
+		{
+			result.storage[0] = 1 / det;
+			return result;
+		}
+		else if constexpr (Row == 2)
+		{
+			result.storage = {at(1, 1), -at(0, 1), -at(1, 0), at(0, 0)};
+		}
+		else if constexpr (Row == 3)
+		{
+			result.storage = {minor(1, 2, 1, 2), -minor(0, 2, 1, 2), minor(0, 1, 1, 2), -minor(1, 2, 0, 2),
+					minor(0, 2, 0, 2), -minor(0, 1, 0, 2), minor(1, 2, 0, 1), -minor(0, 2, 0, 1), minor(0, 1, 0, 1)};
+		}
+		else if constexpr (Row == 4)
+		{
+			const Element s0 = minor(0, 1, 0, 1), s1 = minor(0, 1, 0, 2), s2 = minor(0, 1, 0, 3);
+			const Element s3 = minor(0, 1, 1, 2), s4 = minor(0, 1, 1, 3), s5 = minor(0, 1, 2, 3);
+			const Element c0 = minor(2, 3, 0, 1), c1 = minor(2, 3, 0, 2), c2 = minor(2, 3, 0, 3);
+			const Element c3 = minor(2, 3, 1, 2), c4 = minor(2, 3, 1, 3), c5 = minor(2, 3, 2, 3);
+			result.storage = {
+					at(1, 1) * c5 - at(1, 2) * c4 + at(1, 3) * c3,
+					-at(0, 1) * c5 + at(0, 2) * c4 - at(0, 3) * c3,
+					at(3, 1) * s5 - at(3, 2) * s4 + at(3, 3) * s3,
+					-at(2, 1) * s5 + at(2, 2) * s4 - at(2, 3) * s3,
+					-at(1, 0) * c5 + at(1, 2) * c2 - at(1, 3) * c1,
+					at(0, 0) * c5 - at(0, 2) * c2 + at(0, 3) * c1,
+					-at(3, 0) * s5 + at(3, 2) * s2 - at(3, 3) * s1,
+					at(2, 0) * s5 - at(2, 2) * s2 + at(2, 3) * s1,
+					at(1, 0) * c4 - at(1, 1) * c2 + at(1, 3) * c0,
+					-at(0, 0) * c4 + at(0, 1) * c2 - at(0, 3) * c0,
+					at(3, 0) * s4 - at(3, 1) * s2 + at(3, 3) * s0,
+					-at(2, 0) * s4 + at(2, 1) * s2 - at(2, 3) * s0,
+					-at(1, 0) * c3 + at(1, 1) * c1 - at(1, 2) * c0,
+					at(0, 0) * c3 - at(0, 1) * c1 + at(0, 2) * c0,
+					-at(3, 0) * s3 + at(3, 1) * s1 - at(3, 2) * s0,
+					at(2, 0) * s3 - at(2, 1) * s1 + at(2, 2) * s0,
+			};
+		}
+		else
+		{
+			// Gauss-Jordan, the pivot is never zero because the determinant is not
+			FixedMatrix gauss_table = *this;
+			result = create_i_matrix();
+			for (size_t col_index = 0; col_index < Col; ++col_index)
+			{
+				size_t pivot_row_index = col_index;
+				while (gauss_table.at(pivot_row_index, col_index) == 0)
+					++pivot_row_index;
+				for (size_t i = 0; i < Col; ++i)
+				{
+					std::swap(gauss_table.storage[pivot_row_index * Col + i], gauss_table.storage[col_index * Col + i]);
+					std::swap(result.storage[pivot_row_index * Col + i], result.storage[col_index * Col + i]);
+				}
+
+				const Element pivot = gauss_table.at(col_index, col_index);
+				for (size_t i = 0; i < Col; ++i)
+				{
+					gauss_table.storage[col_index * Col + i] /= pivot;
+					result.storage[col_index * Col + i] /= pivot;
+				}
+				for (size_t row_index = 0; row_index < Row; ++row_index)
+				{
+					const Element coefficient = gauss_table.at(row_index, col_index);
+					if (row_index == col_index or coefficient == 0)
+						continue;
+
+					for (size_t i = 0; i < Col; ++i)
+					{
+						gauss_table.storage[row_index * Col + i] -=
+								coefficient * gauss_table.storage[col_index * Col + i];
+						result.storage[row_index * Col + i] -= coefficient * result.storage[col_index * Col + i];
+					}
+				}
+			}
+			return result;
+		}
+
+		// adjugate over determinant
+		matrix_helper::static_for<Row * Col>([&](size_t i) { result.storage[i] /= det; });
+		return result;
+	}
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr matrix_helper::WideInteger FixedMatrix<Element, Row, Col>::bareiss(bool with_inverse,
+		std::array<matrix_helper::WideInteger, Row * Col>& right, bool& negative, bool& overflow) const
+	requires(Row == Col and Integrable<Element>)
+{
+	using Wide = matrix_helper::WideInteger;
+	std::array<Wide, Row * Col> left{};
+	matrix_helper::static_for<Row * Col>([&](size_t i) { left[i] = storage[i]; });
+	matrix_helper::static_for<Row>([&](size_t i) { right[i * Col + i] = 1; });
+
+	Wide previous_pivot = 1;
+	for (size_t col_index = 0; col_index < Col; ++col_index)
+	{
+		size_t pivot_row_index = col_index;
+		while (pivot_row_index < Row and left[pivot_row_index * Col + col_index] == 0)
+			++pivot_row_index;
+		if (pivot_row_index == Row)
+			return 0;
+		if (pivot_row_index != col_index)
+		{
+			for (size_t i = 0; i < Col; ++i)
+			{
+				std::swap(left[pivot_row_index * Col + i], left[col_index * Col + i]);
+				std::swap(right[pivot_row_index * Col + i], right[col_index * Col + i]);
+			}
+			negative = not negative;
+		}
+
+		const Wide pivot = left[col_index * Col + col_index];
+		for (size_t row_index = with_inverse ? 0 : col_index + 1; row_index < Row; ++row_index)
+		{
+			if (row_index == col_index)
+				continue;
+			const Wide coefficient = left[row_index * Col + col_index];
+			for (size_t i = 0; i < Col; ++i)
+			{
+				Wide& left_element = left[row_index * Col + i];
+				Wide& right_element = right[row_index * Col + i];
+				if (i != col_index and
+						not matrix_helper::checked_cross_difference(pivot, left_element, coefficient,
+								left[col_index * Col + i], left_element))
+					overflow = true;
+				if (with_inverse and
+						not matrix_helper::checked_cross_difference(pivot, right_element, coefficient,
+								right[col_index * Col + i], right_element))
+					overflow = true;
+				if (overflow)
+					return 0;
+				if (i != col_index)
+					left_element /= previous_pivot;
+				if (with_inverse)
+					right_element /= previous_pivot;
+			}
+			left[row_index * Col + col_index] = 0;
+		}
+		previous_pivot = pivot;
+	}
+	return previous_pivot;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr Element FixedMatrix<Element, Row, Col>::narrow(matrix_helper::WideInteger value)
+	requires Integrable<Element>
+{
+	using Wide = matrix_helper::WideInteger;
+	if (value < static_cast<Wide>(std::numeric_limits<Element>::min()) or
+			value > static_cast<Wide>(std::numeric_limits<Element>::max()))
+		throw std::overflow_error("the result does not fit in the element type!");
+	return static_cast<Element>(value);
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+constexpr Element FixedMatrix<Element, Row, Col>::tr() const noexcept
+	requires(Row == Col)
+{
+	Element result = Element(0);
+	matrix_helper::static_for<Row>([&](size_t i) { result += storage[i * Col + i]; });
+	return result;
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+std::string FixedMatrix<Element, Row, Col>::to_string() const noexcept
+{
+	return Matrix<Element>(view()).to_string();
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+FixedMatrix<Element, Row, Col>::operator std::string() const noexcept
+{
+	return to_string();
+}
+
+template <Elementable Element, size_t Row, size_t Col>
+std::ostream& operator<<(std::ostream& os, const FixedMatrix<Element, Row, Col>& matrix)
+{
+	os << matrix.to_string();
+	return os;
+}
+
+#endif
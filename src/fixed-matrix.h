@@ -0,0 +1,127 @@
+#ifndef MATRIX_FIXED_MATRIX_H
+#define MATRIX_FIXED_MATRIX_H
+
+#include <cstddef>
+
+#include <array>
+#include <initializer_list>
+#include <span>
+#include <string>
+
+#include "concept.h"
+#include "matrix.h"
+
+// Matrix whose size is part of its type: storage lives inside the object, every loop has a constant trip count and
+// is unrolled, and mismatched dimensions do not compile.
+template <Elementable Element, size_t Row, size_t Col>
+class FixedMatrix
+{
+private:
+	typedef std::vector<Element> RowType;
+	typedef std::vector<RowType> TableType;
+	typedef std::array<Element, Row * Col> StorageType;
+
+public:
+	constexpr FixedMatrix() noexcept;
+
+	constexpr FixedMatrix(const std::initializer_list<std::initializer_list<Element>>& matrix);
+
+	template <typename ViewElement>
+		requires std::same_as<std::remove_const_t<ViewElement>, Element>
+	explicit FixedMatrix(const MatrixView<ViewElement>& matrix);
+	explicit FixedMatrix(const Matrix<Element>& matrix);
+
+	static constexpr FixedMatrix create_i_matrix() noexcept
+		requires(Row == Col);
+
+	[[nodiscard]] TableType get_table() const;
+	[[nodiscard]] static constexpr size_t get_number_of_row() noexcept;
+	[[nodiscard]] static constexpr size_t get_number_of_col() noexcept;
+	[[nodiscard]] static constexpr size_t get_stride() noexcept;
+	[[nodiscard]] constexpr const Element* get_data() const noexcept;
+
+	[[nodiscard]] MatrixView<const Element> view() const noexcept;
+	operator MatrixView<const Element>() const noexcept;
+	[[nodiscard]] explicit operator Matrix<Element>() const;
+
+	constexpr std::span<Element, Col> operator[](size_t idx) noexcept;
+	constexpr std::span<const Element, Col> operator[](size_t idx) const noexcept;
+
+	[[nodiscard]] constexpr Element at(size_t row_index, size_t col_index) const noexcept;
+
+	[[nodiscard]] constexpr FixedMatrix sum(const FixedMatrix& other) const noexcept;
+	[[nodiscard]] constexpr FixedMatrix operator+(const FixedMatrix& other) const noexcept;
+	constexpr FixedMatrix& operator+=(const FixedMatrix& other) noexcept;
+
+	[[nodiscard]] constexpr FixedMatrix operator-() const noexcept;
+
+	[[nodiscard]] constexpr FixedMatrix submission(const FixedMatrix& other) const noexcept;
+	[[nodiscard]] constexpr FixedMatrix operator-(const FixedMatrix& other) const noexcept;
+	constexpr FixedMatrix& operator-=(const FixedMatrix& other) noexcept;
+
+	template <size_t OtherCol>
+	[[nodiscard]] constexpr FixedMatrix<Element, Row, OtherCol> multiple(
+			const FixedMatrix<Element, Col, OtherCol>& other) const noexcept;
+	template <typename OtherElement>
+		requires(not IsMatrixable<OtherElement>) and MultiplableDifferentType<Element, OtherElement>
+	[[nodiscard]] constexpr FixedMatrix multiple(const OtherElement& other) const noexcept;
+	template <size_t OtherCol>
+	[[nodiscard]] constexpr FixedMatrix<Element, Row, OtherCol> operator*(
+			const FixedMatrix<Element, Col, OtherCol>& other) const noexcept;
+	template <typename OtherElement>
+		requires(not IsMatrixable<OtherElement>) and MultiplableDifferentType<Element, OtherElement>
+	[[nodiscard]] constexpr FixedMatrix operator*(const OtherElement& other) const noexcept;
+	constexpr FixedMatrix& operator*=(const FixedMatrix& other) noexcept
+		requires(Row == Col);
+	template <typename OtherElement>
+		requires(not IsMatrixable<OtherElement>) and MultiplableDifferentType<Element, OtherElement>
+	constexpr FixedMatrix& operator*=(const OtherElement& other) noexcept;
+
+	constexpr bool operator==(const FixedMatrix& other) const noexcept = default;
+
+	// integer elements past 4x4 throw std::overflow_error when the determinant does not fit in Element
+	[[nodiscard]] constexpr Element determinant() const
+		requires(Row == Col);
+
+	[[nodiscard]] constexpr FixedMatrix<Element, Col, Row> transpose() const noexcept;
+	[[nodiscard]] constexpr FixedMatrix inverse() const
+		requires(Row == Col);
+	[[nodiscard]] constexpr Element tr() const noexcept
+		requires(Row == Col);
+
+	[[nodiscard]] std::string to_string() const noexcept;
+	[[nodiscard]] explicit operator std::string() const noexcept;
+
+private:
+	template <Elementable OtherElement, size_t OtherRow, size_t OtherCol>
+	friend class FixedMatrix;
+
+	// 2x2 minor built from rows (first_row, second_row) and columns (first_col, second_col)
+	[[nodiscard]] constexpr Element minor(size_t first_row, size_t second_row, size_t first_col,
+			size_t second_col) const noexcept;
+	// fraction-free Gauss-Jordan (Bareiss) on [A | I] for integer elements: every intermediate value is a minor kept in
+	// matrix_helper::WideInteger, so each division is exact. Returns the last pivot, det(A) or its negation when
+	// negative is set, and 0 for a singular A; with_inverse also clears above the pivots, leaving pivot * A^-1 in
+	// right. Sets overflow and stops when a minor does not fit in the wide type.
+	[[nodiscard]] constexpr matrix_helper::WideInteger bareiss(bool with_inverse,
+			std::array<matrix_helper::WideInteger, Row * Col>& right, bool& negative, bool& overflow) const
+		requires(Row == Col and Integrable<Element>);
+	// value as an Element, std::overflow_error outside its range
+	[[nodiscard]] static constexpr Element narrow(matrix_helper::WideInteger value)
+		requires Integrable<Element>;
+
+	// row-major
+	StorageType storage;
+};
+
+template <Elementable Element, size_t Row, size_t Col>
+std::ostream& operator<<(std::ostream& os, const FixedMatrix<Element, Row, Col>& matrix);
+
+template <typename OtherElement, Elementable Element, size_t Row, size_t Col>
+	requires(not IsMatrixable<OtherElement>) and MultiplableDifferentType<Element, OtherElement>
+constexpr FixedMatrix<Element, Row, Col> operator*(const OtherElement& number,
+		const FixedMatrix<Element, Row, Col>& matrix) noexcept;
+
+#include "fixed-matrix-tmp.h"
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef MATRIX_HESSENBERG_DECOMPOSITION_TMP_H
+#define MATRIX_HESSENBERG_DECOMPOSITION_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "hessenberg-decomposition.h"
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+
+template <Elementable Element>
+HessenbergDecomposition<Element>::HessenbergDecomposition(const Matrix<Element>& matrix, bool compute_q)
+: hessenberg(matrix)
+, q(Matrix<Element>::create_i_matrix(matrix.get_number_of_row()))
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	const size_t size = get_size();
+	std::vector<Element> reflector(size);
+	std::vector<Element> row_of_product(size);
+	const auto hessenberg_rows = hessenberg.mutable_rows();
+	for (size_t col_index = 0; col_index + 2 < size; ++col_index)
+	{
+		const size_t first_row = col_index + 1;
+		const Element beta = make_reflector(col_index, reflector);
+		if (beta == 0)
+			continue;
+
+		// H = (I - beta * v * v^T) * H on rows first_row:, w^T = v^T * H accumulated row by row
+		std::fill(row_of_product.begin() + col_index, row_of_product.end(), Element(0));
+		for (size_t row_index = first_row; row_index < size; ++row_index)
+			matrix_kernel::axpy(size - col_index, reflector[row_index], hessenberg.row_data(row_index) + col_index,
+					row_of_product.data() + col_index);
+		for (size_t row_index = first_row; row_index < size; ++row_index)
+			matrix_kernel::axpy(size - col_index, -beta * reflector[row_index], row_of_product.data() + col_index,
+					hessenberg_rows.row_data(row_index) + col_index);
+
+		// H = H * (I - beta * v * v^T) and Q = Q * (I - beta * v * v^T), every row on its own
+		auto apply_from_right = [&](Matrix<Element>& target)
+		{
+			const auto target_rows = target.mutable_rows();
+			matrix_helper::parallel_for(size, 4 * (size - first_row), [&](size_t begin, size_t end)
+			{
+				for (size_t row_index = begin; row_index < end; ++row_index)
+				{
+					Element* row = target_rows.row_data(row_index) + first_row;
+					const Element* v = reflector.data() + first_row;
+					const Element factor = -beta * matrix_kernel::dot(size - first_row, row, v);
+					matrix_kernel::axpy(size - first_row, factor, v, row);
+				}
+			});
+		};
+		apply_from_right(hessenberg);
+		if (compute_q)
+			apply_from_right(q);
+
+		for (size_t row_index = first_row + 1; row_index < size; ++row_index)
+			hessenberg_rows.row_data(row_index)[col_index] = 0;
+	}
+}
+
+template <Elementable Element>
+Element HessenbergDecomposition<Element>::make_reflector(size_t col_index, std::vector<Element>& reflector) const
+{
+	using std::abs;
+	using std::sqrt;
+	const size_t size = get_size();
+	const size_t first_row = col_index + 1;
+
+	Element tail_norm_square = 0;
+	for (size_t row_index = first_row + 1; row_index < size; ++row_index)
+	{
+		const Element element = hessenberg.row_data(row_index)[col_index];
+		tail_norm_square += element * element;
+	}
+	if (tail_norm_square == 0)
+		return 0;
+
+	const Element head = hessenberg.row_data(first_row)[col_index];
+	const Element norm = sqrt(head * head + tail_norm_square);
+	// sign chosen against head so that v[first_row] never cancels; v is scaled to v[first_row] = 1, which keeps beta
+	// in [1, 2] however small the column is
+	const Element alpha = head > 0 ? -norm : norm;
+	const Element pivot = head - alpha;
+	reflector[first_row] = 1;
+	for (size_t row_index = first_row + 1; row_index < size; ++row_index)
+		reflector[row_index] = hessenberg.row_data(row_index)[col_index] / pivot;
+	return abs(pivot) / norm;
+}
+
+template <Elementable Element>
+size_t HessenbergDecomposition<Element>::get_size() const noexcept
+{
+	return hessenberg.get_number_of_row();
+}
+
+template <Elementable Element>
+const Matrix<Element>& HessenbergDecomposition<Element>::get_hessenberg() const noexcept
+{
+	return hessenberg;
+}
+
+template <Elementable Element>
+const Matrix<Element>& HessenbergDecomposition<Element>::get_q() const noexcept
+{
+	return q;
+}
+
+template <Elementable Element>
+std::vector<Element> HessenbergDecomposition<Element>::characteristic_coefficients() const
+{
+	const size_t size = get_size();
+	// p_k(x) = det(x * I - H[0:k, 0:k]):
+	// p_k = (x - h[k-1][k-1]) * p_{k-1} - sum_{i<k-1} h[i][k-1] * h[i+1][i] * ... * h[k-1][k-2] * p_i
+	std::vector<std::vector<Element>> polynomials(size + 1);
+	polynomials[0] = {Element(1)};
+	for (size_t k = 1; k <= size; ++k)
+	{
+		std::vector<Element>& current = polynomials[k];
+		const std::vector<Element>& previous = polynomials[k - 1];
+		current.assign(k + 1, Element(0));
+		for (size_t degree = 0; degree < k; ++degree)
+		{
+			current[degree + 1] += previous[degree];
+			current[degree] -= hessenberg.row_data(k - 1)[k - 1] * previous[degree];
+		}
+
+		Element subdiagonal_product = 1;
+		for (size_t i = k - 1; i-- > 0;)
+		{
+			subdiagonal_product *= hessenberg.row_data(i + 1)[i];
+			if (subdiagonal_product == 0)
+				break;
+			const Element factor = -hessenberg.row_data(i)[k - 1] * subdiagonal_product;
+			matrix_kernel::axpy(i + 1, factor, polynomials[i].data(), current.data());
+		}
+	}
+
+	// det(A - x * I) = (-1)^n * det(x * I - A)
+	std::vector<Element> coefficients = std::move(polynomials[size]);
+	if (size % 2 == 1)
+	{
+		for (Element& coefficient : coefficients)
+			coefficient = -coefficient;
+	}
+	return coefficients;
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef MATRIX_HESSENBERG_DECOMPOSITION_H
+#define MATRIX_HESSENBERG_DECOMPOSITION_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+
+// A = Q * H * Q^T with H upper Hessenberg, by Householder reflections. Q is only accumulated when asked for.
+template <Elementable Element>
+class HessenbergDecomposition
+{
+public:
+	explicit HessenbergDecomposition(const Matrix<Element>& matrix, bool compute_q = false);
+
+	[[nodiscard]] size_t get_size() const noexcept;
+	[[nodiscard]] const Matrix<Element>& get_hessenberg() const noexcept;
+	// identity when Q was not accumulated
+	[[nodiscard]] const Matrix<Element>& get_q() const noexcept;
+
+	// det(A - x * I), same convention as Matrix::characteristic_polynomial
+	[[nodiscard]] std::vector<Element> characteristic_coefficients() const;
+
+private:
+	// v (stored in reflector[first_row:]) and beta of the reflection zeroing H[first_row + 1:, col_index]
+	Element make_reflector(size_t col_index, std::vector<Element>& reflector) const;
+
+	Matrix<Element> hessenberg;
+	Matrix<Element> q;
+};
+
+#include "hessenberg-decomposition-tmp.h"
+
+#endif
@@ -0,0 +1,304 @@
+#ifndef MATRIX_KRYLOV_SOLVER_TMP_H
+#define MATRIX_KRYLOV_SOLVER_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "krylov-solver.h"
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+
+template <Elementable Element>
+template <typename Operator>
+	requires LinearOperator<Operator, Element>
+KrylovSolver<Element>::KrylovSolver(const Operator& apply, const std::vector<Element>& b, KrylovMethod method,
+		Element tolerance, size_t max_iteration)
+: KrylovSolver(apply, b, method, IdentityPreconditioner<Element>(b.size()), tolerance, max_iteration)
+{
+}
+
+template <Elementable Element>
+template <typename Operator, typename Preconditioner>
+	requires LinearOperator<Operator, Element> and LinearOperator<Preconditioner, Element>
+KrylovSolver<Element>::KrylovSolver(const Operator& apply, const std::vector<Element>& b, KrylovMethod method,
+		const Preconditioner& preconditioner, Element tolerance, size_t max_iteration)
+: solution(b.size(), Element(0))
+, b_norm(norm(b))
+, tolerance(tolerance)
+, max_iteration(max_iteration)
+{
+	// x = 0 solves b = 0 exactly
+	if (b_norm == 0)
+	{
+		residual_history.push_back(0);
+		converged = true;
+		return;
+	}
+	if (record(b_norm))
+		return;
+
+	if (method == KrylovMethod::conjugate_gradient)
+		conjugate_gradient(apply, b, preconditioner);
+	else if (method == KrylovMethod::bicgstab)
+		bicgstab(apply, b, preconditioner);
+	else
+		gmres(apply, b, preconditioner);
+}
+
+template <Elementable Element>
+Element KrylovSolver<Element>::default_tolerance()
+{
+	return std::sqrt(std::numeric_limits<Element>::epsilon());
+}
+
+template <Elementable Element>
+template <typename Operator, typename Preconditioner>
+void KrylovSolver<Element>::conjugate_gradient(const Operator& apply, const std::vector<Element>& b,
+		const Preconditioner& preconditioner)
+{
+	const size_t size = b.size();
+	std::vector<Element> r = b;
+	std::vector<Element> z(size);
+	matrix_helper::apply_operator(preconditioner, r.data(), z.data());
+	std::vector<Element> p = z;
+	std::vector<Element> q(size);
+	Element rz = matrix_kernel::dot(size, r.data(), z.data());
+
+	while (can_iterate())
+	{
+		multiply(apply, p, q);
+		const Element curvature = matrix_kernel::dot(size, p.data(), q.data());
+		// A is not positive definite along p
+		if (curvature <= 0)
+			return;
+
+		const Element alpha = rz / curvature;
+		matrix_kernel::axpy(size, alpha, p.data(), solution.data());
+		matrix_kernel::axpy(size, -alpha, q.data(), r.data());
+		if (record(norm(r)))
+			return;
+
+		matrix_helper::apply_operator(preconditioner, r.data(), z.data());
+		const Element next_rz = matrix_kernel::dot(size, r.data(), z.data());
+		matrix_kernel::scale(size, p.data(), next_rz / rz, p.data());
+		matrix_kernel::axpy(size, Element(1), z.data(), p.data());
+		rz = next_rz;
+	}
+}
+
+template <Elementable Element>
+template <typename Operator, typename Preconditioner>
+void KrylovSolver<Element>::bicgstab(const Operator& apply, const std::vector<Element>& b,
+		const Preconditioner& preconditioner)
+{
+	const size_t size = b.size();
+	std::vector<Element> r = b;
+	const std::vector<Element> shadow = b;
+	std::vector<Element> p(size, Element(0));
+	std::vector<Element> v(size, Element(0));
+	std::vector<Element> preconditioned(size);
+	std::vector<Element> s(size);
+	std::vector<Element> t(size);
+	Element rho = 1;
+	Element alpha = 1;
+	Element omega = 1;
+
+	while (can_iterate())
+	{
+		const Element next_rho = matrix_kernel::dot(size, shadow.data(), r.data());
+		// the shadow residual became orthogonal to r, the recurrence cannot go on
+		if (next_rho == 0)
+			return;
+
+		// p = r + beta * (p - omega * v)
+		const Element beta = (next_rho / rho) * (alpha / omega);
+		matrix_kernel::axpy(size, -omega, v.data(), p.data());
+		matrix_kernel::scale(size, p.data(), beta, p.data());
+		matrix_kernel::axpy(size, Element(1), r.data(), p.data());
+		rho = next_rho;
+
+		matrix_helper::apply_operator(preconditioner, p.data(), preconditioned.data());
+		multiply(apply, preconditioned, v);
+		const Element shadow_v = matrix_kernel::dot(size, shadow.data(), v.data());
+		// the same breakdown one step later, alpha would be infinite
+		if (shadow_v == 0)
+			return;
+		alpha = rho / shadow_v;
+		matrix_kernel::axpy(size, alpha, preconditioned.data(), solution.data());
+		s = r;
+		matrix_kernel::axpy(size, -alpha, v.data(), s.data());
+		// the half step is already good enough
+		if (norm(s) <= tolerance * b_norm)
+		{
+			record(norm(s));
+			return;
+		}
+
+		matrix_helper::apply_operator(preconditioner, s.data(), preconditioned.data());
+		multiply(apply, preconditioned, t);
+		const Element tt = matrix_kernel::dot(size, t.data(), t.data());
+		omega = tt == 0 ? Element(0) : matrix_kernel::dot(size, t.data(), s.data()) / tt;
+		matrix_kernel::axpy(size, omega, preconditioned.data(), solution.data());
+		r = s;
+		matrix_kernel::axpy(size, -omega, t.data(), r.data());
+		if (record(norm(r)) or omega == 0)
+			return;
+	}
+}
+
+template <Elementable Element>
+template <typename Operator, typename Preconditioner>
+void KrylovSolver<Element>::gmres(const Operator& apply, const std::vector<Element>& b,
+		const Preconditioner& preconditioner)
+{
+	const size_t size = b.size();
+	std::vector<std::vector<Element>> basis(GMRES_RESTART + 1, std::vector<Element>(size));
+	// Hessenberg matrix column by column, reduced to upper triangular by Givens rotations as it grows
+	std::vector<std::vector<Element>> hessenberg(GMRES_RESTART, std::vector<Element>(GMRES_RESTART + 1));
+	std::vector<Element> cosines(GMRES_RESTART);
+	std::vector<Element> sines(GMRES_RESTART);
+	std::vector<Element> g(GMRES_RESTART + 1);
+	std::vector<Element> preconditioned(size);
+	std::vector<Element> w(size);
+
+	std::vector<Element>& r = basis[0];
+	r = b;
+	Element beta = b_norm;
+	while (can_iterate())
+	{
+		matrix_kernel::scale(size, r.data(), 1 / beta, r.data());
+		std::fill(g.begin(), g.end(), Element(0));
+		g[0] = beta;
+
+		size_t number_of_column = 0;
+		bool breakdown = false;
+		while (number_of_column < GMRES_RESTART and can_iterate() and not converged and not breakdown)
+		{
+			const size_t j = number_of_column++;
+			std::vector<Element>& column = hessenberg[j];
+			matrix_helper::apply_operator(preconditioner, basis[j].data(), preconditioned.data());
+			multiply(apply, preconditioned, w);
+			// modified Gram-Schmidt against the basis so far
+			for (size_t i = 0; i <= j; ++i)
+			{
+				column[i] = matrix_kernel::dot(size, w.data(), basis[i].data());
+				matrix_kernel::axpy(size, -column[i], basis[i].data(), w.data());
+			}
+			column[j + 1] = norm(w);
+			// a zero norm means the Krylov space is invariant and the least-squares solution exact
+			breakdown = column[j + 1] == 0;
+			if (not breakdown)
+				matrix_kernel::scale(size, w.data(), 1 / column[j + 1], basis[j + 1].data());
+
+			for (size_t i = 0; i < j; ++i)
+			{
+				const Element rotated = cosines[i] * column[i] + sines[i] * column[i + 1];
+				column[i + 1] = cosines[i] * column[i + 1] - sines[i] * column[i];
+				column[i] = rotated;
+			}
+			const Element radius = std::hypot(column[j], column[j + 1]);
+			cosines[j] = radius == 0 ? Element(1) : column[j] / radius;
+			sines[j] = radius == 0 ? Element(0) : column[j + 1] / radius;
+			column[j] = radius;
+			column[j + 1] = 0;
+			g[j + 1] = -sines[j] * g[j];
+			g[j] = cosines[j] * g[j];
+			record(std::abs(g[j + 1]));
+		}
+
+		// x += M^-1 * V * y with R * y = g
+		std::vector<Element> y(g.begin(), g.begin() + static_cast<std::ptrdiff_t>(number_of_column));
+		for (size_t i = number_of_column; i-- > 0;)
+		{
+			for (size_t k = i + 1; k < number_of_column; ++k)
+				y[i] -= hessenberg[k][i] * y[k];
+			y[i] = hessenberg[i][i] == 0 ? Element(0) : y[i] / hessenberg[i][i];
+		}
+		std::fill(w.begin(), w.end(), Element(0));
+		for (size_t i = 0; i < number_of_column; ++i)
+			matrix_kernel::axpy(size, y[i], basis[i].data(), w.data());
+		matrix_helper::apply_operator(preconditioner, w.data(), preconditioned.data());
+		matrix_kernel::axpy(size, Element(1), preconditioned.data(), solution.data());
+		if (converged or breakdown)
+			return;
+
+		// restart from the true residual, the rotated estimate drifts from it
+		multiply(apply, solution, w);
+		for (size_t i = 0; i < size; ++i)
+			r[i] = b[i] - w[i];
+		beta = norm(r);
+		residual_history.back() = beta / b_norm;
+		if (beta <= tolerance * b_norm)
+		{
+			converged = true;
+			return;
+		}
+	}
+}
+
+template <Elementable Element>
+template <typename Operator>
+void KrylovSolver<Element>::multiply(const Operator& apply, const std::vector<Element>& x, std::vector<Element>& y)
+{
+	matrix_helper::apply_operator(apply, x.data(), y.data());
+	++number_of_matvec;
+}
+
+template <Elementable Element>
+bool KrylovSolver<Element>::record(Element residual_norm)
+{
+	residual_history.push_back(residual_norm / b_norm);
+	converged = residual_history.back() <= tolerance;
+	return converged;
+}
+
+template <Elementable Element>
+bool KrylovSolver<Element>::can_iterate() const noexcept
+{
+	return get_number_of_iteration() < max_iteration;
+}
+
+template <Elementable Element>
+Element KrylovSolver<Element>::norm(const std::vector<Element>& x)
+{
+	return std::sqrt(matrix_kernel::dot(x.size(), x.data(), x.data()));
+}
+
+template <Elementable Element>
+const std::vector<Element>& KrylovSolver<Element>::get_solution() const noexcept
+{
+	return solution;
+}
+
+template <Elementable Element>
+bool KrylovSolver<Element>::is_converged() const noexcept
+{
+	return converged;
+}
+
+template <Elementable Element>
+size_t KrylovSolver<Element>::get_number_of_iteration() const noexcept
+{
+	return residual_history.empty() ? 0 : residual_history.size() - 1;
+}
+
+template <Elementable Element>
+size_t KrylovSolver<Element>::get_number_of_matvec() const noexcept
+{
+	return number_of_matvec;
+}
+
+template <Elementable Element>
+Element KrylovSolver<Element>::get_relative_residual() const noexcept
+{
+	return residual_history.empty() ? Element(0) : residual_history.back();
+}
+
+template <Elementable Element>
+const std::vector<Element>& KrylovSolver<Element>::get_residual_history() const noexcept
+{
+	return residual_history;
+}
+
+#endif
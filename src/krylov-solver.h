@@ -0,0 +1,79 @@
+#ifndef MATRIX_KRYLOV_SOLVER_H
+#define MATRIX_KRYLOV_SOLVER_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "preconditioner.h"
+
+enum class KrylovMethod
+{
+	// symmetric positive definite A and M
+	conjugate_gradient,
+	// any non-singular A, short recurrences
+	bicgstab,
+	// any non-singular A, restarted every GMRES_RESTART iterations
+	gmres,
+};
+
+// x with A * x = b, starting from x = 0, where A is only applied to vectors: a Matrix, a SparseMatrix or a callback.
+// The preconditioner M is applied on the right for BiCGSTAB and GMRES, so the residuals they report are those of the
+// original system. Running out of iterations is not an error: is_converged and the residual history tell how far the
+// method got.
+template <Elementable Element>
+class KrylovSolver
+{
+public:
+	template <typename Operator>
+		requires LinearOperator<Operator, Element>
+	KrylovSolver(const Operator& apply, const std::vector<Element>& b, KrylovMethod method,
+			Element tolerance = default_tolerance(), size_t max_iteration = DEFAULT_MAX_ITERATION);
+	template <typename Operator, typename Preconditioner>
+		requires LinearOperator<Operator, Element> and LinearOperator<Preconditioner, Element>
+	KrylovSolver(const Operator& apply, const std::vector<Element>& b, KrylovMethod method,
+			const Preconditioner& preconditioner, Element tolerance = default_tolerance(),
+			size_t max_iteration = DEFAULT_MAX_ITERATION);
+
+	[[nodiscard]] const std::vector<Element>& get_solution() const noexcept;
+	// ||b - A * x|| <= tolerance * ||b||
+	[[nodiscard]] bool is_converged() const noexcept;
+	[[nodiscard]] size_t get_number_of_iteration() const noexcept;
+	[[nodiscard]] size_t get_number_of_matvec() const noexcept;
+	[[nodiscard]] Element get_relative_residual() const noexcept;
+	// ||r|| / ||b|| before the first iteration and after every one
+	[[nodiscard]] const std::vector<Element>& get_residual_history() const noexcept;
+
+private:
+	static constexpr size_t DEFAULT_MAX_ITERATION = 1000;
+	static constexpr size_t GMRES_RESTART = 30;
+
+	[[nodiscard]] static Element default_tolerance();
+
+	template <typename Operator, typename Preconditioner>
+	void conjugate_gradient(const Operator& apply, const std::vector<Element>& b, const Preconditioner& preconditioner);
+	template <typename Operator, typename Preconditioner>
+	void bicgstab(const Operator& apply, const std::vector<Element>& b, const Preconditioner& preconditioner);
+	template <typename Operator, typename Preconditioner>
+	void gmres(const Operator& apply, const std::vector<Element>& b, const Preconditioner& preconditioner);
+
+	template <typename Operator>
+	void multiply(const Operator& apply, const std::vector<Element>& x, std::vector<Element>& y);
+	// appends residual_norm / ||b|| to the history, true once it is below the tolerance
+	bool record(Element residual_norm);
+	[[nodiscard]] bool can_iterate() const noexcept;
+	[[nodiscard]] static Element norm(const std::vector<Element>& x);
+
+	std::vector<Element> solution;
+	Element b_norm = 0;
+	Element tolerance;
+	size_t max_iteration;
+	bool converged = false;
+	size_t number_of_matvec = 0;
+	std::vector<Element> residual_history;
+};
+
+#include "krylov-solver-tmp.h"
+
+#endif
@@ -0,0 +1,212 @@
+#ifndef MATRIX_LDLT_DECOMPOSITION_TMP_H
+#define MATRIX_LDLT_DECOMPOSITION_TMP_H
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "ldlt-decomposition.h"
+#include "lu-decomposition.h"
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+
+template <Elementable Element>
+LDLTDecomposition<Element>::LDLTDecomposition(const Matrix<Element>& matrix, bool check_symmetric)
+: ldlt(matrix)
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+	if (check_symmetric and not matrix.is_symmetric())
+		throw std::invalid_argument("the matrix should be symmetric!");
+
+	// same blocking as Cholesky, the trailing update is L21 * (L21 * D11)^T
+	const size_t size = get_size();
+	const size_t stride = ldlt.get_stride();
+	const auto ldlt_rows = ldlt.mutable_rows();
+	std::vector<Element, matrix_helper::AlignedAllocator<Element>> scaled_panel(size * std::min(BLOCK_SIZE, size));
+	for (size_t first_col = 0; first_col < size and not singular and not broken_down; first_col += BLOCK_SIZE)
+	{
+		const size_t last_col = std::min(first_col + BLOCK_SIZE, size);
+		const size_t panel_width = last_col - first_col;
+		const size_t zero_pivot = factorize_panel(first_col, last_col, scaled_panel.data());
+		// a zero last pivot makes det(A) zero, an earlier one says nothing about it
+		if (zero_pivot + 1 == size)
+			singular = true;
+		else if (zero_pivot < last_col)
+		{
+			broken_down = true;
+			Matrix<Element> symmetric = matrix;
+			const auto symmetric_rows = symmetric.mutable_rows();
+			for (size_t row_index = 0; row_index < size; ++row_index)
+			{
+				for (size_t col_index = row_index + 1; col_index < size; ++col_index)
+					symmetric_rows.row_data(row_index)[col_index] = matrix.row_data(col_index)[row_index];
+			}
+			singular = LUDecomposition<Element>(symmetric).is_singular();
+		}
+		else if (last_col < size)
+			matrix_kernel::syrk_lower(size - last_col, panel_width, ldlt.row_data(last_col) + first_col, stride,
+					scaled_panel.data() + last_col * panel_width, panel_width, ldlt_rows.row_data(last_col) + last_col,
+					stride);
+	}
+
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		Element* row = ldlt_rows.row_data(row_index);
+		std::fill(row + row_index + 1, row + size, Element(0));
+	}
+}
+
+template <Elementable Element>
+size_t LDLTDecomposition<Element>::factorize_panel(size_t first_col, size_t last_col, Element* scaled_panel)
+{
+	const size_t size = get_size();
+	const size_t panel_width = last_col - first_col;
+	const auto ldlt_rows = ldlt.mutable_rows();
+
+	// scaled[j] = L[i][j] * D[j] is built alongside L[i][j], so every step is one dot product of contiguous rows
+	auto eliminate_row = [&](size_t row_index, size_t last_col_of_row)
+	{
+		Element* row = ldlt_rows.row_data(row_index);
+		Element* scaled = scaled_panel + row_index * panel_width;
+		for (size_t col_index = first_col; col_index < last_col_of_row; ++col_index)
+		{
+			const Element* pivot_row = ldlt.row_data(col_index);
+			const Element value =
+					row[col_index] - matrix_kernel::dot(col_index - first_col, scaled, pivot_row + first_col);
+			scaled[col_index - first_col] = value;
+			row[col_index] = value / pivot_row[col_index];
+		}
+	};
+
+	for (size_t row_index = first_col; row_index < last_col; ++row_index)
+	{
+		eliminate_row(row_index, row_index);
+		Element* row = ldlt_rows.row_data(row_index);
+		const Element* scaled = scaled_panel + row_index * panel_width;
+		row[row_index] = row[row_index] - matrix_kernel::dot(row_index - first_col, scaled, row + first_col);
+		if (row[row_index] == 0)
+			return row_index;
+	}
+
+	matrix_helper::parallel_for(size - last_col, panel_width * panel_width, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = last_col + begin; row_index < last_col + end; ++row_index)
+			eliminate_row(row_index, last_col);
+	});
+	return last_col;
+}
+
+template <Elementable Element>
+size_t LDLTDecomposition<Element>::get_size() const noexcept
+{
+	return ldlt.get_number_of_row();
+}
+
+template <Elementable Element>
+Matrix<Element> LDLTDecomposition<Element>::get_lower() const
+{
+	Matrix<Element> result = ldlt;
+	const auto result_rows = result.mutable_rows();
+	for (size_t i = 0; i < get_size(); ++i)
+		result_rows.row_data(i)[i] = 1;
+	return result;
+}
+
+template <Elementable Element>
+std::vector<Element> LDLTDecomposition<Element>::get_diagonal() const
+{
+	std::vector<Element> diagonal(get_size());
+	for (size_t i = 0; i < get_size(); ++i)
+		diagonal[i] = ldlt.row_data(i)[i];
+	return diagonal;
+}
+
+template <Elementable Element>
+bool LDLTDecomposition<Element>::is_singular() const noexcept
+{
+	return singular;
+}
+
+template <Elementable Element>
+bool LDLTDecomposition<Element>::has_broken_down() const noexcept
+{
+	return broken_down;
+}
+
+template <Elementable Element>
+Element LDLTDecomposition<Element>::determinant() const
+{
+	if (singular)
+		return 0;
+	check_factorized();
+
+	Element det = 1;
+	for (size_t i = 0; i < get_size(); ++i)
+		det *= ldlt.row_data(i)[i];
+	return det;
+}
+
+template <Elementable Element>
+Matrix<Element> LDLTDecomposition<Element>::inverse() const
+{
+	return solve(Matrix<Element>::create_i_matrix(get_size()));
+}
+
+template <Elementable Element>
+Matrix<Element> LDLTDecomposition<Element>::solve(const Matrix<Element>& b) const
+{
+	const size_t size = get_size();
+	if (b.get_number_of_row() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+	if (singular)
+		throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+	check_factorized();
+
+	Matrix<Element> x = b;
+	Element* const x_data = x.mutable_rows().row_data(0);
+	const size_t number_of_rhs = x.get_number_of_col();
+	matrix_helper::parallel_for(number_of_rhs, size * size, [&](size_t begin, size_t end)
+	{
+		substitute(x_data + begin, end - begin, x.get_stride());
+	});
+	return x;
+}
+
+template <Elementable Element>
+std::vector<Element> LDLTDecomposition<Element>::solve(const std::vector<Element>& b) const
+{
+	if (b.size() != get_size())
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+	if (singular)
+		throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+	check_factorized();
+
+	std::vector<Element> x = b;
+	substitute(x.data(), 1, 1);
+	return x;
+}
+
+template <Elementable Element>
+void LDLTDecomposition<Element>::check_factorized() const
+{
+	if (broken_down)
+		throw std::invalid_argument("the matrix should have nonzero leading minors!");
+}
+
+template <Elementable Element>
+void LDLTDecomposition<Element>::substitute(Element* x, size_t number_of_rhs, size_t x_stride) const
+{
+	const size_t size = get_size();
+	const size_t stride = ldlt.get_stride();
+	matrix_kernel::trsm_lower(size, number_of_rhs, ldlt.get_data(), stride, true, x, x_stride);
+	for (size_t i = 0; i < size; ++i)
+	{
+		const Element pivot = ldlt.row_data(i)[i];
+		Element* x_row = x + i * x_stride;
+		for (size_t k = 0; k < number_of_rhs; ++k)
+			x_row[k] = x_row[k] / pivot;
+	}
+	matrix_kernel::trsm_lower_transpose(size, number_of_rhs, ldlt.get_data(), stride, true, x, x_stride);
+}
+
+#endif
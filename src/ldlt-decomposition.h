@@ -0,0 +1,57 @@
+#ifndef MATRIX_LDLT_DECOMPOSITION_H
+#define MATRIX_LDLT_DECOMPOSITION_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+
+// A = L * D * L^T for a symmetric A, without square roots and without pivoting. It exists exactly when every leading
+// minor but the last is nonzero, which holds for definite matrices but not for every nonsingular indefinite one
+// ({{0, 1}, {1, 0}}); an earlier zero pivot marks the factorization as broken down instead of throwing, so callers
+// can fall back to LU. L (unit diagonal, not stored) and D share one packed matrix; only the lower triangle of A is
+// read unless check_symmetric is set.
+template <Elementable Element>
+class LDLTDecomposition
+{
+public:
+	explicit LDLTDecomposition(const Matrix<Element>& matrix, bool check_symmetric = false);
+
+	[[nodiscard]] size_t get_size() const noexcept;
+	[[nodiscard]] Matrix<Element> get_lower() const;
+	[[nodiscard]] std::vector<Element> get_diagonal() const;
+	// det(A) == 0, found by LU of A when the factorization broke down
+	[[nodiscard]] bool is_singular() const noexcept;
+	// a zero pivot before the last one stopped the factorization, get_lower and get_diagonal are then incomplete
+	[[nodiscard]] bool has_broken_down() const noexcept;
+
+	// throw std::invalid_argument for a nonsingular matrix whose factorization broke down
+	[[nodiscard]] Element determinant() const;
+	[[nodiscard]] Matrix<Element> inverse() const;
+
+	// A * X = B for every column of B
+	[[nodiscard]] Matrix<Element> solve(const Matrix<Element>& b) const;
+	[[nodiscard]] std::vector<Element> solve(const std::vector<Element>& b) const;
+
+private:
+	static constexpr size_t BLOCK_SIZE = 64;
+
+	// fills scaled_panel with L21 * D11 for the trailing update, returns the column of the first zero pivot or last_col
+	size_t factorize_panel(size_t first_col, size_t last_col, Element* scaled_panel);
+
+	void check_factorized() const;
+
+	// X = L^-T * D^-1 * L^-1 * X for the n x number_of_rhs row-major block X
+	void substitute(Element* x, size_t number_of_rhs, size_t x_stride) const;
+
+	// strict lower triangle is L, diagonal is D, upper triangle is zero
+	Matrix<Element> ldlt;
+	bool singular = false;
+	bool broken_down = false;
+};
+
+#include "ldlt-decomposition-tmp.h"
+
+#endif
@@ -0,0 +1,314 @@
+#ifndef MATRIX_LU_DECOMPOSITION_TMP_H
+#define MATRIX_LU_DECOMPOSITION_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "lu-decomposition.h"
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+
+template <Elementable Element>
+LUDecomposition<Element>::LUDecomposition(const Matrix<Element>& matrix)
+: lu(matrix)
+, permutation(matrix.get_number_of_row())
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	const size_t size = get_size();
+	std::iota(permutation.begin(), permutation.end(), 0);
+	if constexpr (std::floating_point<Element>)
+	{
+		for (size_t col_index = 0; col_index < size; ++col_index)
+		{
+			Element col_sum = 0;
+			for (size_t row_index = 0; row_index < size; ++row_index)
+				col_sum += std::abs(lu.row_data(row_index)[col_index]);
+			one_norm = std::max(one_norm, col_sum);
+		}
+	}
+
+	// right-looking blocked elimination: factorize a panel of columns, then push it into the trailing matrix with
+	// one triangular solve and one GEMM
+	for (size_t first_col = 0; first_col < size; first_col += BLOCK_SIZE)
+	{
+		const size_t last_col = std::min(first_col + BLOCK_SIZE, size);
+		factorize_panel(first_col, last_col);
+		update_trailing_matrix(first_col, last_col);
+	}
+}
+
+template <Elementable Element>
+void LUDecomposition<Element>::factorize_panel(size_t first_col, size_t last_col)
+{
+	const size_t size = get_size();
+	for (size_t col_index = first_col; col_index < last_col; ++col_index)
+	{
+		size_t pivot_row_index = col_index;
+		for (size_t row_index = col_index + 1; row_index < size; ++row_index)
+		{
+			if (matrix_helper::is_better_pivot(lu.row_data(row_index)[col_index],
+						lu.row_data(pivot_row_index)[col_index]))
+				pivot_row_index = row_index;
+		}
+		swap_rows(col_index, pivot_row_index);
+
+		const auto lu_rows = lu.mutable_rows();
+		const Element* pivot_row = lu.row_data(col_index);
+		const Element pivot = pivot_row[col_index];
+		if (pivot == 0)
+		{
+			singular = true;
+			continue;
+		}
+
+		// only the panel columns, the rest of the row waits for update_trailing_matrix
+		const size_t first_row_index = col_index + 1;
+		matrix_helper::parallel_for(size - first_row_index, last_col - col_index, [&](size_t begin, size_t end)
+		{
+			for (size_t row_index = first_row_index + begin; row_index < first_row_index + end; ++row_index)
+			{
+				Element* row = lu_rows.row_data(row_index);
+				row[col_index] = row[col_index] / pivot;
+				matrix_kernel::axpy(last_col - col_index - 1, -row[col_index], pivot_row + col_index + 1,
+						row + col_index + 1);
+			}
+		});
+	}
+}
+
+template <Elementable Element>
+void LUDecomposition<Element>::update_trailing_matrix(size_t first_col, size_t last_col)
+{
+	const size_t size = get_size();
+	if (last_col == size)
+		return;
+
+	const size_t stride = lu.get_stride();
+	const size_t panel_width = last_col - first_col;
+	const size_t trailing_size = size - last_col;
+	const auto lu_rows = lu.mutable_rows();
+
+	// U12 = L11^-1 * A12, columns are independent
+	matrix_helper::parallel_for(trailing_size, panel_width * panel_width, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = first_col + 1; row_index < last_col; ++row_index)
+		{
+			Element* row = lu_rows.row_data(row_index);
+			for (size_t i = first_col; i < row_index; ++i)
+				matrix_kernel::axpy(end - begin, -row[i], lu.row_data(i) + last_col + begin, row + last_col + begin);
+		}
+	});
+
+	// A22 -= L21 * U12
+	std::vector<Element, matrix_helper::AlignedAllocator<Element>> negative_lower(trailing_size * panel_width);
+	for (size_t row_index = 0; row_index < trailing_size; ++row_index)
+	{
+		const Element* row = lu.row_data(last_col + row_index) + first_col;
+		for (size_t i = 0; i < panel_width; ++i)
+			negative_lower[row_index * panel_width + i] = -row[i];
+	}
+	matrix_kernel::gemm(trailing_size, trailing_size, panel_width, negative_lower.data(), panel_width,
+			lu.row_data(first_col) + last_col, stride, lu_rows.row_data(last_col) + last_col, stride);
+}
+
+template <Elementable Element>
+void LUDecomposition<Element>::swap_rows(size_t first_row_index, size_t second_row_index) noexcept
+{
+	if (first_row_index == second_row_index)
+		return;
+
+	lu.swap_rows(first_row_index, second_row_index);
+	std::swap(permutation[first_row_index], permutation[second_row_index]);
+	++number_of_swap;
+}
+
+template <Elementable Element>
+size_t LUDecomposition<Element>::get_size() const noexcept
+{
+	return lu.get_number_of_row();
+}
+
+template <Elementable Element>
+const Matrix<Element>& LUDecomposition<Element>::get_packed() const noexcept
+{
+	return lu;
+}
+
+template <Elementable Element>
+const std::vector<size_t>& LUDecomposition<Element>::get_permutation() const noexcept
+{
+	return permutation;
+}
+
+template <Elementable Element>
+Matrix<Element> LUDecomposition<Element>::get_lower() const
+{
+	const size_t size = get_size();
+	Matrix<Element> result = Matrix<Element>::create_i_matrix(size);
+	const auto result_rows = result.mutable_rows();
+	for (size_t row_index = 0; row_index < size; ++row_index)
+		std::copy_n(lu.row_data(row_index), row_index, result_rows.row_data(row_index));
+	return result;
+}
+
+template <Elementable Element>
+Matrix<Element> LUDecomposition<Element>::get_upper() const
+{
+	const size_t size = get_size();
+	Matrix<Element> result(size, size);
+	const auto result_rows = result.mutable_rows();
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		const Element* row = lu.row_data(row_index);
+		std::copy(row + row_index, row + size, result_rows.row_data(row_index) + row_index);
+	}
+	return result;
+}
+
+template <Elementable Element>
+bool LUDecomposition<Element>::is_singular() const noexcept
+{
+	return singular;
+}
+
+template <Elementable Element>
+Element LUDecomposition<Element>::determinant() const noexcept
+{
+	if (singular)
+		return 0;
+
+	Element det = 1;
+	for (size_t i = 0; i < get_size(); ++i)
+		det *= lu.row_data(i)[i];
+
+	if (number_of_swap % 2 == 0)
+		return det;
+	else
+		return -det;
+}
+
+template <Elementable Element>
+Matrix<Element> LUDecomposition<Element>::inverse() const
+{
+	return solve(Matrix<Element>::create_i_matrix(get_size()));
+}
+
+template <Elementable Element>
+Matrix<Element> LUDecomposition<Element>::solve(const Matrix<Element>& b) const
+{
+	const size_t size = get_size();
+	if (b.get_number_of_row() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+	if (singular)
+		throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+
+	const size_t number_of_rhs = b.get_number_of_col();
+	Matrix<Element> x(size, number_of_rhs);
+	const auto x_rows = x.mutable_rows();
+	for (size_t row_index = 0; row_index < size; ++row_index)
+		std::copy_n(b.row_data(permutation[row_index]), number_of_rhs, x_rows.row_data(row_index));
+
+	// right-hand sides are independent, each task substitutes its own columns
+	matrix_helper::parallel_for(number_of_rhs, size * size, [&](size_t begin, size_t end)
+	{
+		substitute(x_rows.row_data(0) + begin, end - begin, x.get_stride());
+	});
+	return x;
+}
+
+template <Elementable Element>
+std::vector<Element> LUDecomposition<Element>::solve(const std::vector<Element>& b) const
+{
+	const size_t size = get_size();
+	if (b.size() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+	if (singular)
+		throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+
+	std::vector<Element> x(size);
+	for (size_t row_index = 0; row_index < size; ++row_index)
+		x[row_index] = b[permutation[row_index]];
+	substitute(x.data(), 1, 1);
+	return x;
+}
+
+template <Elementable Element>
+std::vector<Element> LUDecomposition<Element>::solve_transpose(const std::vector<Element>& b) const
+{
+	const size_t size = get_size();
+	if (b.size() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+	if (singular)
+		throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+
+	// U^T * y = b, then L^T * w = y, both walking rows of the packed matrix
+	std::vector<Element> y = b;
+	for (size_t i = 0; i < size; ++i)
+	{
+		const Element* row = lu.row_data(i);
+		y[i] = y[i] / row[i];
+		matrix_kernel::axpy(size - i - 1, -y[i], row + i + 1, y.data() + i + 1);
+	}
+	for (size_t i = size; i-- > 0;)
+		matrix_kernel::axpy(i, -y[i], lu.row_data(i), y.data());
+
+	std::vector<Element> x(size);
+	for (size_t i = 0; i < size; ++i)
+		x[permutation[i]] = y[i];
+	return x;
+}
+
+template <Elementable Element>
+void LUDecomposition<Element>::substitute(Element* x, size_t number_of_rhs, size_t x_stride) const
+{
+	const size_t size = get_size();
+	matrix_kernel::trsm_lower(size, number_of_rhs, lu.get_data(), lu.get_stride(), true, x, x_stride);
+	matrix_kernel::trsm_upper(size, number_of_rhs, lu.get_data(), lu.get_stride(), false, x, x_stride);
+}
+
+template <Elementable Element>
+Element LUDecomposition<Element>::reciprocal_condition_number() const
+	requires std::floating_point<Element>
+{
+	const size_t size = get_size();
+	if (singular or one_norm == 0)
+		return 0;
+	if (size == 0)
+		return 1;
+
+	// Hager: maximize ||A^-1 x||_1 over the unit 1-norm ball by a few gradient steps
+	std::vector<Element> x(size, Element(1) / static_cast<Element>(size));
+	Element inverse_norm = 0;
+	for (size_t iteration = 0; iteration < 5; ++iteration)
+	{
+		const std::vector<Element> y = solve(x);
+		inverse_norm = 0;
+		std::vector<Element> sign(size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			inverse_norm += std::abs(y[i]);
+			sign[i] = y[i] < 0 ? -1 : 1;
+		}
+
+		const std::vector<Element> z = solve_transpose(sign);
+		size_t max_index = 0;
+		for (size_t i = 1; i < size; ++i)
+		{
+			if (std::abs(z[i]) > std::abs(z[max_index]))
+				max_index = i;
+		}
+		if (iteration > 0 and std::abs(z[max_index]) <= matrix_kernel::dot(size, z.data(), x.data()))
+			break;
+
+		std::fill(x.begin(), x.end(), Element(0));
+		x[max_index] = 1;
+	}
+
+	return 1 / (one_norm * inverse_norm);
+}
+
+#endif
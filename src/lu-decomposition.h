@@ -0,0 +1,59 @@
+#ifndef MATRIX_LU_DECOMPOSITION_H
+#define MATRIX_LU_DECOMPOSITION_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+
+// P * A = L * U with partial pivoting, computed once and reused by every query. L (unit diagonal, not stored) and U
+// share one packed matrix.
+template <Elementable Element>
+class LUDecomposition
+{
+public:
+	explicit LUDecomposition(const Matrix<Element>& matrix);
+
+	[[nodiscard]] size_t get_size() const noexcept;
+	[[nodiscard]] const Matrix<Element>& get_packed() const noexcept;
+	// row i of P * A is row permutation[i] of A
+	[[nodiscard]] const std::vector<size_t>& get_permutation() const noexcept;
+	[[nodiscard]] Matrix<Element> get_lower() const;
+	[[nodiscard]] Matrix<Element> get_upper() const;
+	[[nodiscard]] bool is_singular() const noexcept;
+
+	[[nodiscard]] Element determinant() const noexcept;
+	[[nodiscard]] Matrix<Element> inverse() const;
+
+	// A * X = B for every column of B
+	[[nodiscard]] Matrix<Element> solve(const Matrix<Element>& b) const;
+	[[nodiscard]] std::vector<Element> solve(const std::vector<Element>& b) const;
+	// A^T * x = b
+	[[nodiscard]] std::vector<Element> solve_transpose(const std::vector<Element>& b) const;
+
+	// 1 / (||A||_1 * ||A^-1||_1) with Hager's estimate of ||A^-1||_1, 0 for a singular matrix
+	[[nodiscard]] Element reciprocal_condition_number() const
+		requires std::floating_point<Element>;
+
+private:
+	static constexpr size_t BLOCK_SIZE = 64;
+
+	void factorize_panel(size_t first_col, size_t last_col);
+	void update_trailing_matrix(size_t first_col, size_t last_col);
+	void swap_rows(size_t first_row_index, size_t second_row_index) noexcept;
+
+	// X = U^-1 * L^-1 * X for the n x number_of_rhs row-major block X
+	void substitute(Element* x, size_t number_of_rhs, size_t x_stride) const;
+
+	Matrix<Element> lu;
+	std::vector<size_t> permutation;
+	size_t number_of_swap = 0;
+	bool singular = false;
+	Element one_norm = Element(0);
+};
+
+#include "lu-decomposition-tmp.h"
+
+#endif
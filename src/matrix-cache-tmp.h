@@ -0,0 +1,108 @@
+#ifndef MATRIX_MATRIX_CACHE_TMP_H
+#define MATRIX_MATRIX_CACHE_TMP_H
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <tuple>
+
+#include "matrix-cache.h"
+
+template <Elementable Element>
+struct MatrixCache<Element>::State
+{
+	template <typename Value>
+	struct Entry
+	{
+		using value_type = Value;
+
+		std::optional<Value> value;
+		// the matrix version value was computed at
+		uint64_t version = 0;
+	};
+
+	std::shared_mutex mutex;
+	std::atomic<uint64_t> version = 0;
+	// whether any entry may be current, so that writes to a matrix nobody has queried do not bump the version
+	std::atomic<bool> holds_result = false;
+	// indexed by CachedProperty
+	std::tuple<Entry<Element>, Entry<Element>, Entry<Matrix<Element>>, Entry<LUDecomposition<Element>>,
+			Entry<typename CharacteristicPolynomialType<Element>::type>>
+			entries;
+};
+
+template <Elementable Element>
+MatrixCache<Element>::MatrixCache(const MatrixCache&) noexcept
+{
+}
+
+template <Elementable Element>
+MatrixCache<Element>& MatrixCache<Element>::operator=(const MatrixCache&) noexcept
+{
+	invalidate();
+	return *this;
+}
+
+template <Elementable Element>
+MatrixCache<Element>& MatrixCache<Element>::operator=(MatrixCache&&) noexcept
+{
+	invalidate();
+	return *this;
+}
+
+template <Elementable Element>
+MatrixCache<Element>::~MatrixCache() = default;
+
+template <Elementable Element>
+void MatrixCache<Element>::set_enabled(bool enabled)
+{
+	if (not enabled)
+		state.reset();
+	else if (not state)
+		state = std::make_unique<State>();
+}
+
+template <Elementable Element>
+bool MatrixCache<Element>::is_enabled() const noexcept
+{
+	return state != nullptr;
+}
+
+template <Elementable Element>
+void MatrixCache<Element>::invalidate() noexcept
+{
+	// a matrix is not written while it is read, so relaxed is enough
+	if (state and state->holds_result.load(std::memory_order_relaxed))
+	{
+		state->holds_result.store(false, std::memory_order_relaxed);
+		state->version.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+template <Elementable Element>
+template <CachedProperty Property, typename Compute>
+auto MatrixCache<Element>::get(Compute&& compute) const
+{
+	using Value = typename std::tuple_element_t<static_cast<size_t>(Property), decltype(State::entries)>::value_type;
+
+	if (not state)
+		return Value(compute());
+
+	auto& entry = std::get<static_cast<size_t>(Property)>(state->entries);
+	const uint64_t version = state->version.load(std::memory_order_relaxed);
+	{
+		const std::shared_lock lock(state->mutex);
+		if (entry.value and entry.version == version)
+			return Value(*entry.value);
+	}
+
+	Value value = compute();
+	const std::unique_lock lock(state->mutex);
+	entry.value = value;
+	entry.version = version;
+	state->holds_result.store(true, std::memory_order_relaxed);
+	return value;
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef MATRIX_MATRIX_CACHE_H
+#define MATRIX_MATRIX_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+#include <variant>
+
+#include "concept.h"
+#include "polynomial.h"
+
+template <Elementable Element>
+class Matrix;
+
+template <Elementable Element>
+class LUDecomposition;
+
+// the results a Matrix can remember, in the order MatrixCache stores them
+enum class CachedProperty : size_t
+{
+	determinant,
+	trace,
+	inverse,
+	lu_decomposition,
+	characteristic_polynomial,
+};
+
+// Polynomial<Element> for elements that have polynomials, a placeholder for the others
+template <typename Element>
+struct CharacteristicPolynomialType
+{
+	using type = std::monostate;
+};
+
+template <Polynomialable Element>
+struct CharacteristicPolynomialType<Element>
+{
+	using type = Polynomial<Element>;
+};
+
+// Opt-in memo of a Matrix's derived results. Every write to the matrix bumps a version and a result is only returned
+// while the version it was computed at is current; writes cost one relaxed load until something has been stored.
+// Concurrent const callers share a reader lock, and two of them missing at once both compute and store the same value.
+// The cache belongs to one object: copies start without one, and assigning to a matrix keeps its own setting.
+template <Elementable Element>
+class MatrixCache
+{
+public:
+	MatrixCache() noexcept = default;
+	MatrixCache(const MatrixCache& other) noexcept;
+	MatrixCache(MatrixCache&& other) noexcept = default;
+	MatrixCache& operator=(const MatrixCache& other) noexcept;
+	MatrixCache& operator=(MatrixCache&& other) noexcept;
+	~MatrixCache();
+
+	void set_enabled(bool enabled);
+	[[nodiscard]] bool is_enabled() const noexcept;
+	// called by every public member function writing the matrix
+	void invalidate() noexcept;
+
+	// the stored result if it is current, otherwise compute() stored for the next call; compute runs without any lock
+	// held, so it may look up other properties
+	template <CachedProperty Property, typename Compute>
+	[[nodiscard]] auto get(Compute&& compute) const;
+
+private:
+	struct State;
+
+	std::unique_ptr<State> state;
+};
+
+#include "matrix-cache-tmp.h"
+
+#endif
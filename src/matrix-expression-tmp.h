@@ -0,0 +1,341 @@
+#ifndef MATRIX_MATRIX_EXPRESSION_TMP_H
+#define MATRIX_MATRIX_EXPRESSION_TMP_H
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "matrix-expression.h"
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+
+template <typename Derived>
+const Derived& MatrixExpression<Derived>::derived() const noexcept
+{
+	return static_cast<const Derived&>(*this);
+}
+
+template <typename Derived>
+auto MatrixExpression<Derived>::evaluate() const
+{
+	return Matrix<typename Derived::value_type>(derived());
+}
+
+template <typename Derived>
+template <typename Element>
+void MatrixExpression<Derived>::evaluate_into(Element* data, size_t stride) const
+{
+	const Derived& expression = derived();
+	const size_t number_of_col = expression.get_number_of_col();
+	matrix_helper::parallel_for(expression.get_number_of_row(), number_of_col, [&](size_t row_begin, size_t row_end)
+	{
+		for (size_t row_index = row_begin; row_index < row_end; ++row_index)
+		{
+			Element* row_of_result = data + row_index * stride;
+			for (size_t col_index = 0; col_index < number_of_col; ++col_index)
+				row_of_result[col_index] = expression.element(row_index, col_index);
+		}
+	});
+}
+
+template <typename Derived>
+std::string MatrixExpression<Derived>::to_string() const
+{
+	return evaluate().to_string();
+}
+
+namespace matrix_expression
+{
+template <typename T>
+struct is_matrix_terminal : std::false_type
+{
+};
+
+template <typename Storage>
+struct is_matrix_terminal<MatrixTerminal<Storage>> : std::true_type
+{
+};
+
+// lvalue matrices and views are referenced, temporaries are moved into the tree
+template <typename Operand>
+auto make_operand(Operand&& operand)
+{
+	using Type = std::remove_cvref_t<Operand>;
+	using Element = value_type_t<Type>;
+
+	if constexpr (is_matrix_v<Type> and not std::is_lvalue_reference_v<Operand>)
+		return MatrixTerminal<Type>(std::move(operand));
+	else if constexpr (is_matrix_v<Type> or is_matrix_view_v<Type>)
+		return MatrixTerminal<MatrixView<const Element>>(operand);
+	else if constexpr (Type::is_element_wise)
+		return Type(std::forward<Operand>(operand));
+	else
+		return MatrixTerminal<Matrix<Element>>(operand.evaluate());
+}
+
+template <typename Operand>
+auto make_dense_operand(Operand&& operand)
+{
+	using Type = std::remove_cvref_t<Operand>;
+
+	if constexpr (is_matrix_v<Type> or is_matrix_view_v<Type> or is_matrix_terminal<Type>::value)
+		return make_operand(std::forward<Operand>(operand));
+	else
+		return MatrixTerminal<Matrix<value_type_t<Type>>>(operand.evaluate());
+}
+}		 // namespace matrix_expression
+
+template <typename Storage>
+MatrixTerminal<Storage>::MatrixTerminal(Storage storage) noexcept
+: storage(std::move(storage))
+{
+}
+
+template <typename Storage>
+size_t MatrixTerminal<Storage>::get_number_of_row() const noexcept
+{
+	return storage.get_number_of_row();
+}
+
+template <typename Storage>
+size_t MatrixTerminal<Storage>::get_number_of_col() const noexcept
+{
+	return storage.get_number_of_col();
+}
+
+template <typename Storage>
+size_t MatrixTerminal<Storage>::get_stride() const noexcept
+{
+	return storage.get_stride();
+}
+
+template <typename Storage>
+auto MatrixTerminal<Storage>::get_data() const noexcept -> const value_type*
+{
+	return storage.get_data();
+}
+
+template <typename Storage>
+auto MatrixTerminal<Storage>::element(size_t row_index, size_t col_index) const noexcept -> value_type
+{
+	return storage.get_data()[row_index * storage.get_stride() + col_index];
+}
+
+template <typename Left, typename Right>
+MatrixSum<Left, Right>::MatrixSum(Left left, Right right)
+: left(std::move(left))
+, right(std::move(right))
+{
+	if (this->left.get_number_of_row() != this->right.get_number_of_row() or
+			this->left.get_number_of_col() != this->right.get_number_of_col())
+		throw std::invalid_argument("Cannot sum spans of different sizes");
+}
+
+template <typename Left, typename Right>
+size_t MatrixSum<Left, Right>::get_number_of_row() const noexcept
+{
+	return left.get_number_of_row();
+}
+
+template <typename Left, typename Right>
+size_t MatrixSum<Left, Right>::get_number_of_col() const noexcept
+{
+	return left.get_number_of_col();
+}
+
+template <typename Left, typename Right>
+auto MatrixSum<Left, Right>::element(size_t row_index, size_t col_index) const -> value_type
+{
+	return left.element(row_index, col_index) + right.element(row_index, col_index);
+}
+
+template <typename Left, typename Right>
+MatrixDifference<Left, Right>::MatrixDifference(Left left, Right right)
+: left(std::move(left))
+, right(std::move(right))
+{
+	if (this->left.get_number_of_row() != this->right.get_number_of_row() or
+			this->left.get_number_of_col() != this->right.get_number_of_col())
+		throw std::invalid_argument("Cannot submission spans of different sizes");
+}
+
+template <typename Left, typename Right>
+size_t MatrixDifference<Left, Right>::get_number_of_row() const noexcept
+{
+	return left.get_number_of_row();
+}
+
+template <typename Left, typename Right>
+size_t MatrixDifference<Left, Right>::get_number_of_col() const noexcept
+{
+	return left.get_number_of_col();
+}
+
+template <typename Left, typename Right>
+auto MatrixDifference<Left, Right>::element(size_t row_index, size_t col_index) const -> value_type
+{
+	return left.element(row_index, col_index) - right.element(row_index, col_index);
+}
+
+template <typename Operand>
+MatrixNegation<Operand>::MatrixNegation(Operand operand) noexcept
+: operand(std::move(operand))
+{
+}
+
+template <typename Operand>
+size_t MatrixNegation<Operand>::get_number_of_row() const noexcept
+{
+	return operand.get_number_of_row();
+}
+
+template <typename Operand>
+size_t MatrixNegation<Operand>::get_number_of_col() const noexcept
+{
+	return operand.get_number_of_col();
+}
+
+template <typename Operand>
+auto MatrixNegation<Operand>::element(size_t row_index, size_t col_index) const -> value_type
+{
+	return -operand.element(row_index, col_index);
+}
+
+template <typename Operand, typename Scalar>
+MatrixScale<Operand, Scalar>::MatrixScale(Operand operand, Scalar scalar)
+: operand(std::move(operand))
+, scalar(std::move(scalar))
+{
+}
+
+template <typename Operand, typename Scalar>
+size_t MatrixScale<Operand, Scalar>::get_number_of_row() const noexcept
+{
+	return operand.get_number_of_row();
+}
+
+template <typename Operand, typename Scalar>
+size_t MatrixScale<Operand, Scalar>::get_number_of_col() const noexcept
+{
+	return operand.get_number_of_col();
+}
+
+template <typename Operand, typename Scalar>
+auto MatrixScale<Operand, Scalar>::element(size_t row_index, size_t col_index) const -> value_type
+{
+	value_type element = operand.element(row_index, col_index);
+	if constexpr (MultipleAssignableDifferentType<value_type, Scalar>)
+		element *= scalar;
+	else if constexpr (MultiplableDifferentTypeReturnFirstType<value_type, Scalar>)
+		element = element * scalar;
+	else if constexpr (MultiplableDifferentTypeReturnSecondType<value_type, Scalar>)
+		element = scalar * element;
+	return element;
+}
+
+template <typename Left, typename Right>
+MatrixProduct<Left, Right>::MatrixProduct(Left left, Right right)
+: left(std::move(left))
+, right(std::move(right))
+{
+	if (this->left.get_number_of_col() != this->right.get_number_of_row())
+		throw std::invalid_argument("the number of rows must match the number of columns.");
+}
+
+template <typename Left, typename Right>
+size_t MatrixProduct<Left, Right>::get_number_of_row() const noexcept
+{
+	return left.get_number_of_row();
+}
+
+template <typename Left, typename Right>
+size_t MatrixProduct<Left, Right>::get_number_of_col() const noexcept
+{
+	return right.get_number_of_col();
+}
+
+template <typename Left, typename Right>
+template <typename Element>
+void MatrixProduct<Left, Right>::evaluate_into(Element* data, size_t stride) const
+{
+	const size_t number_of_row = get_number_of_row();
+	const size_t number_of_col = get_number_of_col();
+	for (size_t row_index = 0; row_index < number_of_row; ++row_index)
+		std::fill_n(data + row_index * stride, number_of_col, Element(0));
+
+	matrix_kernel::gemm(number_of_row, number_of_col, left.get_number_of_col(), left.get_data(), left.get_stride(),
+			right.get_data(), right.get_stride(), data, stride);
+}
+
+template <typename Left, typename Right>
+	requires MatrixOperand<Left> and MatrixOperand<Right> and
+		SumableDifferentType<matrix_expression::value_type_t<Left>, matrix_expression::value_type_t<Right>>
+auto operator+(Left&& left, Right&& right)
+{
+	using LeftOperand = decltype(matrix_expression::make_operand(std::forward<Left>(left)));
+	using RightOperand = decltype(matrix_expression::make_operand(std::forward<Right>(right)));
+	return MatrixSum<LeftOperand, RightOperand>(matrix_expression::make_operand(std::forward<Left>(left)),
+			matrix_expression::make_operand(std::forward<Right>(right)));
+}
+
+template <typename Left, typename Right>
+	requires MatrixOperand<Left> and MatrixOperand<Right>
+auto operator-(Left&& left, Right&& right)
+{
+	using LeftOperand = decltype(matrix_expression::make_operand(std::forward<Left>(left)));
+	using RightOperand = decltype(matrix_expression::make_operand(std::forward<Right>(right)));
+	return MatrixDifference<LeftOperand, RightOperand>(matrix_expression::make_operand(std::forward<Left>(left)),
+			matrix_expression::make_operand(std::forward<Right>(right)));
+}
+
+template <typename Operand>
+	requires MatrixOperand<Operand>
+auto operator-(Operand&& operand)
+{
+	using InnerOperand = decltype(matrix_expression::make_operand(std::forward<Operand>(operand)));
+	return MatrixNegation<InnerOperand>(matrix_expression::make_operand(std::forward<Operand>(operand)));
+}
+
+template <typename Left, typename Right>
+	requires MatrixOperand<Left> and MatrixOperand<Right> and
+		MultiplableDifferentTypeReturnFirstType<matrix_expression::value_type_t<Left>,
+				matrix_expression::value_type_t<Right>>
+auto operator*(Left&& left, Right&& right)
+{
+	using LeftOperand = decltype(matrix_expression::make_dense_operand(std::forward<Left>(left)));
+	using RightOperand = decltype(matrix_expression::make_dense_operand(std::forward<Right>(right)));
+	return MatrixProduct<LeftOperand, RightOperand>(matrix_expression::make_dense_operand(std::forward<Left>(left)),
+			matrix_expression::make_dense_operand(std::forward<Right>(right)));
+}
+
+template <typename Operand, typename Scalar>
+	requires MatrixOperand<Operand> and (not MatrixOperand<Scalar>) and
+		MultiplableDifferentType<matrix_expression::value_type_t<Operand>, Scalar>
+auto operator*(Operand&& operand, const Scalar& scalar)
+{
+	using InnerOperand = decltype(matrix_expression::make_operand(std::forward<Operand>(operand)));
+	return MatrixScale<InnerOperand, Scalar>(matrix_expression::make_operand(std::forward<Operand>(operand)), scalar);
+}
+
+template <typename Scalar, typename Operand>
+	requires MatrixOperand<Operand> and (not MatrixOperand<Scalar>) and
+		MultiplableDifferentType<matrix_expression::value_type_t<Operand>, Scalar>
+auto operator*(const Scalar& scalar, Operand&& operand)
+{
+	return std::forward<Operand>(operand) * scalar;
+}
+
+template <MatrixExpressionNode Expression, typename Other>
+	requires MatrixOperand<Other>
+bool operator==(const Expression& expression, const Other& other)
+{
+	return expression.evaluate() == other;
+}
+
+template <MatrixExpressionNode Expression>
+std::ostream& operator<<(std::ostream& os, const Expression& expression)
+{
+	os << expression.to_string();
+	return os;
+}
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef MATRIX_MATRIX_EXPRESSION_H
+#define MATRIX_MATRIX_EXPRESSION_H
+
+#include <cstddef>
+
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "concept.h"
+#include "matrix-view.h"
+
+template <Elementable Element>
+class Matrix;
+
+// Base of the lazy nodes returned by +, -, unary - and scalar *. Nothing is computed until the tree is assigned to a
+// Matrix, which then writes every element in a single fused pass.
+template <typename Derived>
+class MatrixExpression
+{
+public:
+	// element-wise trees read element (i, j) only to write element (i, j), so they may alias their destination
+	static constexpr bool is_element_wise = true;
+
+	[[nodiscard]] auto evaluate() const;
+
+	template <typename Element>
+	void evaluate_into(Element* data, size_t stride) const;
+
+	[[nodiscard]] std::string to_string() const;
+
+protected:
+	[[nodiscard]] const Derived& derived() const noexcept;
+};
+
+template <typename Expression>
+concept MatrixExpressionNode = std::derived_from<Expression, MatrixExpression<Expression>>;
+
+namespace matrix_expression
+{
+template <typename T>
+struct is_matrix : std::false_type
+{
+};
+
+template <typename Element>
+struct is_matrix<Matrix<Element>> : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr bool is_matrix_v = is_matrix<T>::value;
+
+template <typename T>
+struct is_matrix_view : std::false_type
+{
+};
+
+template <typename Element>
+struct is_matrix_view<MatrixView<Element>> : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr bool is_matrix_view_v = is_matrix_view<T>::value;
+
+template <typename T>
+struct value_type
+{
+	using type = typename T::value_type;
+};
+
+template <typename Element>
+struct value_type<Matrix<Element>>
+{
+	using type = Element;
+};
+
+template <typename Element>
+struct value_type<MatrixView<Element>>
+{
+	using type = std::remove_const_t<Element>;
+};
+
+template <typename T>
+using value_type_t = typename value_type<std::remove_cvref_t<T>>::type;
+}		 // namespace matrix_expression
+
+template <typename Operand>
+concept MatrixOperand = MatrixExpressionNode<std::remove_cvref_t<Operand>> or
+		matrix_expression::is_matrix_v<std::remove_cvref_t<Operand>> or
+		matrix_expression::is_matrix_view_v<std::remove_cvref_t<Operand>>;
+
+// Leaf of a tree. Storage is a MatrixView<const Element> for operands that outlive the expression, or a Matrix that
+// the expression owns for temporaries.
+template <typename Storage>
+class MatrixTerminal : public MatrixExpression<MatrixTerminal<Storage>>
+{
+public:
+	using value_type = matrix_expression::value_type_t<Storage>;
+
+	explicit MatrixTerminal(Storage storage) noexcept;
+
+	[[nodiscard]] size_t get_number_of_row() const noexcept;
+	[[nodiscard]] size_t get_number_of_col() const noexcept;
+	[[nodiscard]] size_t get_stride() const noexcept;
+	[[nodiscard]] const value_type* get_data() const noexcept;
+
+	[[nodiscard]] value_type element(size_t row_index, size_t col_index) const noexcept;
+
+private:
+	Storage storage;
+};
+
+template <typename Left, typename Right>
+class MatrixSum : public MatrixExpression<MatrixSum<Left, Right>>
+{
+public:
+	using value_type = typename Left::value_type;
+
+	MatrixSum(Left left, Right right);
+
+	[[nodiscard]] size_t get_number_of_row() const noexcept;
+	[[nodiscard]] size_t get_number_of_col() const noexcept;
+
+	[[nodiscard]] value_type element(size_t row_index, size_t col_index) const;
+
+private:
+	Left left;
+	Right right;
+};
+
+template <typename Left, typename Right>
+class MatrixDifference : public MatrixExpression<MatrixDifference<Left, Right>>
+{
+public:
+	using value_type = typename Left::value_type;
+
+	MatrixDifference(Left left, Right right);
+
+	[[nodiscard]] size_t get_number_of_row() const noexcept;
+	[[nodiscard]] size_t get_number_of_col() const noexcept;
+
+	[[nodiscard]] value_type element(size_t row_index, size_t col_index) const;
+
+private:
+	Left left;
+	Right right;
+};
+
+template <typename Operand>
+class MatrixNegation : public MatrixExpression<MatrixNegation<Operand>>
+{
+public:
+	using value_type = typename Operand::value_type;
+
+	explicit MatrixNegation(Operand operand) noexcept;
+
+	[[nodiscard]] size_t get_number_of_row() const noexcept;
+	[[nodiscard]] size_t get_number_of_col() const noexcept;
+
+	[[nodiscard]] value_type element(size_t row_index, size_t col_index) const;
+
+private:
+	Operand operand;
+};
+
+template <typename Operand, typename Scalar>
+class MatrixScale : public MatrixExpression<MatrixScale<Operand, Scalar>>
+{
+public:
+	using value_type = typename Operand::value_type;
+
+	MatrixScale(Operand operand, Scalar scalar);
+
+	[[nodiscard]] size_t get_number_of_row() const noexcept;
+	[[nodiscard]] size_t get_number_of_col() const noexcept;
+
+	[[nodiscard]] value_type element(size_t row_index, size_t col_index) const;
+
+private:
+	Operand operand;
+	Scalar scalar;
+};
+
+// Both operands are terminals: GEMM reads each of them many times, so a lazy operand is evaluated once up front.
+// The product itself is handed to matrix_kernel::gemm when assigned, and evaluated into a terminal when it appears
+// inside an element-wise tree.
+template <typename Left, typename Right>
+class MatrixProduct : public MatrixExpression<MatrixProduct<Left, Right>>
+{
+public:
+	using value_type = typename Left::value_type;
+
+	static constexpr bool is_element_wise = false;
+
+	MatrixProduct(Left left, Right right);
+
+	[[nodiscard]] size_t get_number_of_row() const noexcept;
+	[[nodiscard]] size_t get_number_of_col() const noexcept;
+
+	template <typename Element>
+	void evaluate_into(Element* data, size_t stride) const;
+
+private:
+	Left left;
+	Right right;
+};
+
+template <typename Left, typename Right>
+	requires MatrixOperand<Left> and MatrixOperand<Right> and
+		SumableDifferentType<matrix_expression::value_type_t<Left>, matrix_expression::value_type_t<Right>>
+auto operator+(Left&& left, Right&& right);
+
+template <typename Left, typename Right>
+	requires MatrixOperand<Left> and MatrixOperand<Right>
+auto operator-(Left&& left, Right&& right);
+
+template <typename Operand>
+	requires MatrixOperand<Operand>
+auto operator-(Operand&& operand);
+
+template <typename Left, typename Right>
+	requires MatrixOperand<Left> and MatrixOperand<Right> and
+		MultiplableDifferentTypeReturnFirstType<matrix_expression::value_type_t<Left>,
+				matrix_expression::value_type_t<Right>>
+auto operator*(Left&& left, Right&& right);
+
+template <typename Operand, typename Scalar>
+	requires MatrixOperand<Operand> and (not MatrixOperand<Scalar>) and
+		MultiplableDifferentType<matrix_expression::value_type_t<Operand>, Scalar>
+auto operator*(Operand&& operand, const Scalar& scalar);
+
+template <typename Scalar, typename Operand>
+	requires MatrixOperand<Operand> and (not MatrixOperand<Scalar>) and
+		MultiplableDifferentType<matrix_expression::value_type_t<Operand>, Scalar>
+auto operator*(const Scalar& scalar, Operand&& operand);
+
+template <MatrixExpressionNode Expression, typename Other>
+	requires MatrixOperand<Other>
+bool operator==(const Expression& expression, const Other& other);
+
+template <MatrixExpressionNode Expression>
+std::ostream& operator<<(std::ostream& os, const Expression& expression);
+
+#include "matrix-expression-tmp.h"
+
+#endif
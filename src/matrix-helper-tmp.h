@@ -0,0 +1,147 @@
+#ifndef MATRIX_HELPER_TMP_H
+#define MATRIX_HELPER_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "matrix-helper.h"
+#include "thread-pool.h"
+
+namespace matrix_helper
+{
+
+template <typename Element, size_t Alignment>
+template <typename OtherElement>
+constexpr AlignedAllocator<Element, Alignment>::AlignedAllocator(
+		const AlignedAllocator<OtherElement, Alignment>&) noexcept
+{
+}
+
+template <typename Element, size_t Alignment>
+Element* AlignedAllocator<Element, Alignment>::allocate(size_t size)
+{
+	if (size > std::numeric_limits<size_t>::max() / sizeof(Element))
+		throw std::bad_array_new_length();
+
+	return static_cast<Element*>(::operator new(size * sizeof(Element), std::align_val_t(Alignment)));
+}
+
+template <typename Element, size_t Alignment>
+void AlignedAllocator<Element, Alignment>::deallocate(Element* pointer, size_t) noexcept
+{
+	::operator delete(pointer, std::align_val_t(Alignment));
+}
+
+template <typename Element, size_t Alignment>
+template <typename OtherElement>
+constexpr bool AlignedAllocator<Element, Alignment>::operator==(
+		const AlignedAllocator<OtherElement, Alignment>&) const noexcept
+{
+	return true;
+}
+
+template <typename Function>
+void parallel_for(size_t size, size_t work_per_index, Function&& function)
+{
+	const size_t grain_size = std::max<size_t>(1, PARALLEL_GRAIN / std::max<size_t>(1, work_per_index));
+	ThreadPool::get_instance().parallel_for(0, size, grain_size, std::forward<Function>(function));
+}
+
+template <typename Operator, typename Element>
+void apply_operator(const Operator& apply, const Element* x, Element* y)
+{
+	if constexpr (requires { apply.multiply(x, y); })
+		apply.multiply(x, y);
+	else
+		apply(x, y);
+}
+
+template <typename Value>
+CopyableAtomic<Value>::CopyableAtomic(const CopyableAtomic&) noexcept
+{
+}
+
+template <typename Value>
+CopyableAtomic<Value>& CopyableAtomic<Value>::operator=(const CopyableAtomic&) noexcept
+{
+	store(Value{});
+	return *this;
+}
+
+template <typename Value>
+Value CopyableAtomic<Value>::load() const noexcept
+{
+	return value.load(std::memory_order_relaxed);
+}
+
+template <typename Value>
+void CopyableAtomic<Value>::store(Value value) noexcept
+{
+	this->value.store(value, std::memory_order_relaxed);
+}
+
+template <typename Element>
+bool is_better_pivot(const Element& candidate, const Element& pivot)
+{
+	if constexpr (std::is_floating_point_v<Element>)
+		return std::abs(candidate) > std::abs(pivot);
+	else
+		return pivot == 0 and candidate != 0;
+}
+
+template <typename Integer>
+constexpr bool checked_multiply(Integer a, Integer b, Integer& result) noexcept
+{
+#if defined(__GNUC__) or defined(__clang__)
+	return not __builtin_mul_overflow(a, b, &result);
+#else
+	constexpr Integer MAX = std::numeric_limits<Integer>::max();
+	constexpr Integer MIN = std::numeric_limits<Integer>::min();
+	if (a > 0 ? (b > 0 ? a > MAX / b : b < MIN / a) : (b > 0 ? a < MIN / b : a != 0 and b < MAX / a))
+		return false;
+	result = a * b;
+	return true;
+#endif
+}
+
+template <typename Integer>
+constexpr bool checked_cross_difference(Integer a, Integer b, Integer c, Integer d, Integer& result) noexcept
+{
+	Integer first, second;
+	if (not checked_multiply(a, b, first) or not checked_multiply(c, d, second))
+		return false;
+#if defined(__GNUC__) or defined(__clang__)
+	return not __builtin_sub_overflow(first, second, &result);
+#else
+	constexpr Integer MAX = std::numeric_limits<Integer>::max();
+	constexpr Integer MIN = std::numeric_limits<Integer>::min();
+	if (second > 0 ? first < MIN + second : first > MAX + second)
+		return false;
+	result = first - second;
+	return true;
+#endif
+}
+
+template <typename Element>
+std::string element_to_string(const Element& element)
+{
+	using std::to_string;
+	return to_string(element);
+}
+
+template <size_t Count, typename Function>
+constexpr void static_for(Function&& function)
+{
+	[&function]<size_t... Index>(std::index_sequence<Index...>)
+	{
+		(function(Index), ...);
+	}(std::make_index_sequence<Count>{});
+}
+
+}		 // namespace matrix_helper
+
+#endif
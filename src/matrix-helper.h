@@ -0,0 +1,101 @@
+#ifndef MATRIX_HELPER_H
+#define MATRIX_HELPER_H
+
+#include <cstddef>
+
+#include <atomic>
+#include <new>
+#include <string>
+
+namespace matrix_helper
+{
+
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+// amount of scalar work handed to one task, smaller operations stay on the calling thread
+inline constexpr size_t PARALLEL_GRAIN = 1 << 15;
+
+// widest signed integer, exact integer algorithms keep their intermediate values in it
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 WideInteger;
+__extension__ typedef unsigned __int128 WideUnsignedInteger;
+#else
+typedef long long WideInteger;
+typedef unsigned long long WideUnsignedInteger;
+#endif
+
+template <typename Element, size_t Alignment = CACHE_LINE_SIZE>
+class AlignedAllocator
+{
+public:
+	using value_type = Element;
+
+	template <typename OtherElement>
+	struct rebind
+	{
+		using other = AlignedAllocator<OtherElement, Alignment>;
+	};
+
+	AlignedAllocator() noexcept = default;
+
+	template <typename OtherElement>
+	constexpr AlignedAllocator(const AlignedAllocator<OtherElement, Alignment>& other) noexcept;
+
+	[[nodiscard]] Element* allocate(size_t size);
+	void deallocate(Element* pointer, size_t size) noexcept;
+
+	template <typename OtherElement>
+	constexpr bool operator==(const AlignedAllocator<OtherElement, Alignment>& other) const noexcept;
+};
+
+// an atomic that keeps its owner copyable; a copy starts from Value{} rather than the current value, so what the owner
+// caches in it is found again by the copy instead of outliving writes made to the copy. Loads and stores are relaxed,
+// the cached value must be derivable from the state the owner already publishes
+template <typename Value>
+class CopyableAtomic
+{
+public:
+	CopyableAtomic() noexcept = default;
+	CopyableAtomic(const CopyableAtomic& other) noexcept;
+	CopyableAtomic& operator=(const CopyableAtomic& other) noexcept;
+
+	[[nodiscard]] Value load() const noexcept;
+	void store(Value value) noexcept;
+
+private:
+	std::atomic<Value> value{};
+};
+
+// splits [0, size) over the shared thread pool, work_per_index is the cost of one index in scalar operations
+template <typename Function>
+void parallel_for(size_t size, size_t work_per_index, Function&& function);
+
+// y = A * x for any LinearOperator
+template <typename Operator, typename Element>
+void apply_operator(const Operator& apply, const Element* x, Element* y);
+
+// largest magnitude when it is defined, otherwise the first non-zero element
+template <typename Element>
+[[nodiscard]] bool is_better_pivot(const Element& candidate, const Element& pivot);
+
+// result = a * b, false instead when the product overflows
+template <typename Integer>
+[[nodiscard]] constexpr bool checked_multiply(Integer a, Integer b, Integer& result) noexcept;
+
+// result = a * b - c * d, false instead when a product or the difference overflows
+template <typename Integer>
+[[nodiscard]] constexpr bool checked_cross_difference(Integer a, Integer b, Integer c, Integer d,
+		Integer& result) noexcept;
+
+// std::to_string for arithmetic types, otherwise the to_string found by ADL
+template <typename Element>
+[[nodiscard]] std::string element_to_string(const Element& element);
+
+// calls function(0), ..., function(Count - 1) as one unrolled sequence
+template <size_t Count, typename Function>
+constexpr void static_for(Function&& function);
+
+}		 // namespace matrix_helper
+
+#include "matrix-helper-tmp.h"
+
+#endif
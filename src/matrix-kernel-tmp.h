@@ -0,0 +1,307 @@
+#ifndef MATRIX_KERNEL_TMP_H
+#define MATRIX_KERNEL_TMP_H
+
+#include <algorithm>
+#include <vector>
+
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+#include "thread-pool.h"
+
+namespace matrix_kernel
+{
+
+template <typename Element, typename OtherElement>
+void gemm(size_t m, size_t n, size_t k, const Element* a, size_t lda, const OtherElement* b, size_t ldb, Element* c,
+		size_t ldc)
+{
+	constexpr size_t SMALL_GEMM_VOLUME = 32 * 32 * 32;
+
+	if constexpr (is_packable_v<Element, OtherElement>)
+	{
+		if (m * n * k > SMALL_GEMM_VOLUME)
+		{
+			gemm_blocked(m, n, k, a, lda, b, ldb, c, ldc);
+			return;
+		}
+	}
+
+	gemm_naive(m, n, k, a, lda, b, ldb, c, ldc);
+}
+
+template <typename Element, typename OtherElement>
+void gemm_naive(size_t m, size_t n, size_t k, const Element* a, size_t lda, const OtherElement* b, size_t ldb,
+		Element* c, size_t ldc)
+{
+	for (size_t i = 0; i < m; ++i)
+	{
+		Element* row_of_c = c + i * ldc;
+		for (size_t p = 0; p < k; ++p)
+		{
+			const Element a_element = a[i * lda + p];
+			const OtherElement* row_of_b = b + p * ldb;
+			if constexpr (is_packable_v<Element, OtherElement>)
+			{
+				axpy(n, a_element, row_of_b, row_of_c);
+			}
+			else
+			{
+				for (size_t j = 0; j < n; ++j)
+					row_of_c[j] += a_element * row_of_b[j];
+			}
+		}
+	}
+}
+
+template <typename Element>
+void gemm_blocked(size_t m, size_t n, size_t k, const Element* a, size_t lda, const Element* b, size_t ldb, Element* c,
+		size_t ldc)
+{
+	using Blocking = GemmBlocking<Element>;
+	using Buffer = std::vector<Element, matrix_helper::AlignedAllocator<Element>>;
+
+	const size_t max_nc = std::min(Blocking::NC, (n + Blocking::NR - 1) / Blocking::NR * Blocking::NR);
+	const size_t max_kc = std::min(Blocking::KC, k);
+	Buffer packed_b(max_kc * max_nc);
+	Buffer shared_packed_a;
+
+	const size_t number_of_m_block = (m + Blocking::MC - 1) / Blocking::MC;
+	// with enough row blocks every task owns one; otherwise the tasks share a packed A and split its columns
+	const bool split_by_row_block = number_of_m_block >= ThreadPool::get_instance().get_number_of_thread();
+
+	for (size_t jc = 0; jc < n; jc += Blocking::NC)
+	{
+		const size_t nc = std::min(Blocking::NC, n - jc);
+		const size_t number_of_n_sliver = (nc + Blocking::NR - 1) / Blocking::NR;
+		for (size_t pc = 0; pc < k; pc += Blocking::KC)
+		{
+			const size_t kc = std::min(Blocking::KC, k - pc);
+			matrix_helper::parallel_for(number_of_n_sliver, kc * Blocking::NR, [&](size_t begin, size_t end)
+			{
+				const size_t jr = begin * Blocking::NR;
+				pack_b(kc, std::min(nc, end * Blocking::NR) - jr, b + pc * ldb + jc + jr, ldb,
+						packed_b.data() + jr * kc);
+			});
+
+			if (split_by_row_block)
+			{
+				matrix_helper::parallel_for(number_of_m_block, 2 * Blocking::MC * kc * nc, [&](size_t begin, size_t end)
+				{
+					static thread_local Buffer packed_a;
+					packed_a.resize(Blocking::MC * Blocking::KC);
+					for (size_t ic = begin * Blocking::MC; ic < std::min(m, end * Blocking::MC); ic += Blocking::MC)
+					{
+						const size_t mc = std::min(Blocking::MC, m - ic);
+						pack_a(mc, kc, a + ic * lda + pc, lda, packed_a.data());
+						macro_kernel(mc, nc, kc, packed_a.data(), packed_b.data(), c + ic * ldc + jc, ldc, 0,
+								number_of_n_sliver);
+					}
+				});
+				continue;
+			}
+
+			shared_packed_a.resize(Blocking::MC * Blocking::KC);
+			for (size_t ic = 0; ic < m; ic += Blocking::MC)
+			{
+				const size_t mc = std::min(Blocking::MC, m - ic);
+				pack_a(mc, kc, a + ic * lda + pc, lda, shared_packed_a.data());
+				matrix_helper::parallel_for(number_of_n_sliver, 2 * mc * kc * Blocking::NR,
+						[&](size_t begin, size_t end)
+						{
+							macro_kernel(mc, nc, kc, shared_packed_a.data(), packed_b.data(), c + ic * ldc + jc, ldc,
+									begin, end);
+						});
+			}
+		}
+	}
+}
+
+template <typename Element>
+void macro_kernel(size_t mc, size_t nc, size_t kc, const Element* packed_a, const Element* packed_b, Element* c,
+		size_t ldc, size_t first_n_sliver, size_t last_n_sliver) noexcept
+{
+	using Blocking = GemmBlocking<Element>;
+
+	for (size_t jr = first_n_sliver * Blocking::NR; jr < std::min(nc, last_n_sliver * Blocking::NR);
+			jr += Blocking::NR)
+	{
+		const size_t nr = std::min(Blocking::NR, nc - jr);
+		for (size_t ir = 0; ir < mc; ir += Blocking::MR)
+		{
+			const size_t mr = std::min(Blocking::MR, mc - ir);
+			micro_kernel(kc, packed_a + ir * kc, packed_b + jr * kc, c + ir * ldc + jr, ldc, mr, nr);
+		}
+	}
+}
+
+// Diagonal blocks are solved by substitution, everything below (or above) them is updated with one GEMM per block.
+template <typename Element>
+void trsm_lower(size_t n, size_t nrhs, const Element* t, size_t ldt, bool unit_diagonal, Element* x, size_t ldx)
+{
+	constexpr size_t BLOCK_SIZE = 64;
+	std::vector<Element, matrix_helper::AlignedAllocator<Element>> negative_x;
+
+	for (size_t first = 0; first < n; first += BLOCK_SIZE)
+	{
+		const size_t last = std::min(first + BLOCK_SIZE, n);
+		for (size_t i = first; i < last; ++i)
+		{
+			const Element* row = t + i * ldt;
+			Element* x_row = x + i * ldx;
+			for (size_t j = first; j < i; ++j)
+				axpy(nrhs, -row[j], x + j * ldx, x_row);
+			if (not unit_diagonal)
+			{
+				for (size_t k = 0; k < nrhs; ++k)
+					x_row[k] = x_row[k] / row[i];
+			}
+		}
+		if (last == n)
+			break;
+
+		// X2 -= T21 * X1
+		negative_x.resize((last - first) * nrhs);
+		for (size_t i = first; i < last; ++i)
+			scale(nrhs, x + i * ldx, Element(-1), negative_x.data() + (i - first) * nrhs);
+		gemm(n - last, nrhs, last - first, t + last * ldt + first, ldt, negative_x.data(), nrhs, x + last * ldx, ldx);
+	}
+}
+
+template <typename Element>
+void trsm_upper(size_t n, size_t nrhs, const Element* t, size_t ldt, bool unit_diagonal, Element* x, size_t ldx)
+{
+	constexpr size_t BLOCK_SIZE = 64;
+	std::vector<Element, matrix_helper::AlignedAllocator<Element>> negative_x;
+
+	for (size_t last = n; last > 0;)
+	{
+		const size_t first = last > BLOCK_SIZE ? last - BLOCK_SIZE : 0;
+		for (size_t i = last; i-- > first;)
+		{
+			const Element* row = t + i * ldt;
+			Element* x_row = x + i * ldx;
+			for (size_t j = i + 1; j < last; ++j)
+				axpy(nrhs, -row[j], x + j * ldx, x_row);
+			if (not unit_diagonal)
+			{
+				for (size_t k = 0; k < nrhs; ++k)
+					x_row[k] = x_row[k] / row[i];
+			}
+		}
+
+		// X0 -= T01 * X1
+		if (first > 0)
+		{
+			negative_x.resize((last - first) * nrhs);
+			for (size_t i = first; i < last; ++i)
+				scale(nrhs, x + i * ldx, Element(-1), negative_x.data() + (i - first) * nrhs);
+			gemm(first, nrhs, last - first, t + first, ldt, negative_x.data(), nrhs, x, ldx);
+		}
+		last = first;
+	}
+}
+
+template <typename Element>
+void trsm_lower_transpose(size_t n, size_t nrhs, const Element* t, size_t ldt, bool unit_diagonal, Element* x,
+		size_t ldx)
+{
+	constexpr size_t BLOCK_SIZE = 64;
+	std::vector<Element, matrix_helper::AlignedAllocator<Element>> negative_panel;
+
+	for (size_t last = n; last > 0;)
+	{
+		const size_t first = last > BLOCK_SIZE ? last - BLOCK_SIZE : 0;
+		// column i of T^T is row i of T, so each solved row is pushed into the rows above it
+		for (size_t i = last; i-- > first;)
+		{
+			const Element* row = t + i * ldt;
+			Element* x_row = x + i * ldx;
+			if (not unit_diagonal)
+			{
+				for (size_t k = 0; k < nrhs; ++k)
+					x_row[k] = x_row[k] / row[i];
+			}
+			for (size_t j = first; j < i; ++j)
+				axpy(nrhs, -row[j], x_row, x + j * ldx);
+		}
+
+		// X0 -= T10^T * X1
+		if (first > 0)
+		{
+			const size_t width = last - first;
+			negative_panel.resize(first * width);
+			for (size_t i = 0; i < width; ++i)
+			{
+				const Element* row = t + (first + i) * ldt;
+				for (size_t j = 0; j < first; ++j)
+					negative_panel[j * width + i] = -row[j];
+			}
+			gemm(first, nrhs, width, negative_panel.data(), width, x + first * ldx, ldx, x, ldx);
+		}
+		last = first;
+	}
+}
+
+template <typename Element>
+void syrk_lower(size_t n, size_t k, const Element* x, size_t ldx, const Element* y, size_t ldy, Element* c,
+		size_t ldc)
+{
+	constexpr size_t BLOCK_SIZE = 64;
+
+	std::vector<Element, matrix_helper::AlignedAllocator<Element>> negative_y_transpose(k * n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		const Element* row = y + i * ldy;
+		for (size_t p = 0; p < k; ++p)
+			negative_y_transpose[p * n + i] = -row[p];
+	}
+
+	for (size_t first = 0; first < n; first += BLOCK_SIZE)
+	{
+		const size_t last = std::min(first + BLOCK_SIZE, n);
+		gemm(last - first, last, k, x + first * ldx, ldx, negative_y_transpose.data(), n, c + first * ldc, ldc);
+	}
+}
+
+// A panel is stored as MR-row slivers, each sliver column by column and zero padded to MR rows.
+template <typename Element>
+void pack_a(size_t mc, size_t kc, const Element* a, size_t lda, Element* packed_a) noexcept
+{
+	constexpr size_t MR = GemmBlocking<Element>::MR;
+
+	for (size_t ir = 0; ir < mc; ir += MR)
+	{
+		const size_t mr = std::min(MR, mc - ir);
+		for (size_t p = 0; p < kc; ++p)
+		{
+			for (size_t i = 0; i < mr; ++i)
+				packed_a[p * MR + i] = a[(ir + i) * lda + p];
+			for (size_t i = mr; i < MR; ++i)
+				packed_a[p * MR + i] = Element(0);
+		}
+		packed_a += MR * kc;
+	}
+}
+
+// B panel is stored as NR-column slivers, each sliver row by row and zero padded to NR columns.
+template <typename Element>
+void pack_b(size_t kc, size_t nc, const Element* b, size_t ldb, Element* packed_b) noexcept
+{
+	constexpr size_t NR = GemmBlocking<Element>::NR;
+
+	for (size_t jr = 0; jr < nc; jr += NR)
+	{
+		const size_t nr = std::min(NR, nc - jr);
+		for (size_t p = 0; p < kc; ++p)
+		{
+			const Element* row_of_b = b + p * ldb + jr;
+			std::copy(row_of_b, row_of_b + nr, packed_b + p * NR);
+			std::fill(packed_b + p * NR + nr, packed_b + (p + 1) * NR, Element(0));
+		}
+		packed_b += NR * kc;
+	}
+}
+
+}		 // namespace matrix_kernel
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef MATRIX_KERNEL_H
+#define MATRIX_KERNEL_H
+
+#include <cstddef>
+
+#include <type_traits>
+
+#include "matrix-simd.h"
+
+namespace matrix_kernel
+{
+
+template <typename Element, typename OtherElement>
+inline constexpr bool is_packable_v = std::is_arithmetic_v<Element> and std::is_same_v<Element, OtherElement>;
+
+// C (m x n) += A (m x k) * B (k x n), all row-major with the given leading dimensions
+template <typename Element, typename OtherElement>
+void gemm(size_t m, size_t n, size_t k, const Element* a, size_t lda, const OtherElement* b, size_t ldb, Element* c,
+		size_t ldc);
+
+template <typename Element, typename OtherElement>
+void gemm_naive(size_t m, size_t n, size_t k, const Element* a, size_t lda, const OtherElement* b, size_t ldb,
+		Element* c, size_t ldc);
+
+template <typename Element>
+void gemm_blocked(size_t m, size_t n, size_t k, const Element* a, size_t lda, const Element* b, size_t ldb, Element* c,
+		size_t ldc);
+
+// packed slivers [first_n_sliver, last_n_sliver) of one MC x NC block of C
+template <typename Element>
+void macro_kernel(size_t mc, size_t nc, size_t kc, const Element* packed_a, const Element* packed_b, Element* c,
+		size_t ldc, size_t first_n_sliver, size_t last_n_sliver) noexcept;
+
+// X (n x nrhs) = T^-1 * X in place for a lower triangular T (n x n), diagonal taken as one when unit_diagonal
+template <typename Element>
+void trsm_lower(size_t n, size_t nrhs, const Element* t, size_t ldt, bool unit_diagonal, Element* x, size_t ldx);
+
+// X = T^-1 * X for an upper triangular T
+template <typename Element>
+void trsm_upper(size_t n, size_t nrhs, const Element* t, size_t ldt, bool unit_diagonal, Element* x, size_t ldx);
+
+// X = T^-T * X for a lower triangular T, without forming the transpose
+template <typename Element>
+void trsm_lower_transpose(size_t n, size_t nrhs, const Element* t, size_t ldt, bool unit_diagonal, Element* x,
+		size_t ldx);
+
+// lower triangle of C (n x n) -= X (n x k) * Y^T, block row by block row so the strict upper triangle costs at most
+// one diagonal block per row; whatever lands above the diagonal is garbage
+template <typename Element>
+void syrk_lower(size_t n, size_t k, const Element* x, size_t ldx, const Element* y, size_t ldy, Element* c,
+		size_t ldc);
+
+template <typename Element>
+void pack_a(size_t mc, size_t kc, const Element* a, size_t lda, Element* packed_a) noexcept;
+
+template <typename Element>
+void pack_b(size_t kc, size_t nc, const Element* b, size_t ldb, Element* packed_b) noexcept;
+
+}		 // namespace matrix_kernel
+
+#include "matrix-kernel-tmp.h"
+
+#endif
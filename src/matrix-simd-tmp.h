@@ -0,0 +1,689 @@
+#ifndef MATRIX_SIMD_TMP_H
+#define MATRIX_SIMD_TMP_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "matrix-simd.h"
+
+#if MATRIX_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace matrix_kernel
+{
+
+inline InstructionSet detect_instruction_set() noexcept
+{
+#if MATRIX_X86_SIMD
+	static const InstructionSet DETECTED_INSTRUCTION_SET = []
+	{
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512dq"))
+			return InstructionSet::avx512;
+		if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma"))
+			return InstructionSet::avx2;
+		if (__builtin_cpu_supports("sse4.2"))
+			return InstructionSet::sse4_2;
+		return InstructionSet::scalar;
+	}();
+	return DETECTED_INSTRUCTION_SET;
+#else
+	return InstructionSet::scalar;
+#endif
+}
+
+inline std::atomic<InstructionSet>& active_instruction_set() noexcept
+{
+	static std::atomic<InstructionSet> instruction_set(detect_instruction_set());
+	return instruction_set;
+}
+
+inline InstructionSet get_instruction_set() noexcept
+{
+	return active_instruction_set().load(std::memory_order_relaxed);
+}
+
+inline void set_instruction_set(InstructionSet instruction_set) noexcept
+{
+	active_instruction_set().store(std::min(instruction_set, detect_instruction_set()), std::memory_order_relaxed);
+}
+
+#if MATRIX_X86_SIMD
+template <typename Element, size_t WIDTH>
+struct VectorOf
+{
+	typedef Element type __attribute__((vector_size(WIDTH)));
+	static constexpr size_t LANE = WIDTH / sizeof(Element);
+};
+
+// vectors are passed by reference so that no vector ever crosses a function boundary by value
+template <size_t WIDTH, typename Element>
+MATRIX_ALWAYS_INLINE void load_vector(typename VectorOf<Element, WIDTH>::type& vector, const Element* data) noexcept
+{
+	std::memcpy(&vector, data, WIDTH);
+}
+
+template <size_t WIDTH, typename Element>
+MATRIX_ALWAYS_INLINE void store_vector(Element* data, const typename VectorOf<Element, WIDTH>::type& vector) noexcept
+{
+	std::memcpy(data, &vector, WIDTH);
+}
+#endif
+
+// Each kernel is written once against a vector width in bytes (0 means scalar) and is stamped out
+// for every instruction set by the run_* wrappers below.
+template <typename Element>
+struct AddKernel
+{
+	using ElementType = Element;
+
+	template <size_t WIDTH>
+	MATRIX_ALWAYS_INLINE static void run(size_t size, const Element* first, const Element* second,
+			Element* result) noexcept
+	{
+		size_t i = 0;
+#if MATRIX_X86_SIMD
+		if constexpr (WIDTH != 0)
+		{
+			typename VectorOf<Element, WIDTH>::type first_vector, second_vector;
+			constexpr size_t LANE = VectorOf<Element, WIDTH>::LANE;
+			for (; i + LANE <= size; i += LANE)
+			{
+				load_vector<WIDTH>(first_vector, first + i);
+				load_vector<WIDTH>(second_vector, second + i);
+				store_vector<WIDTH>(result + i, first_vector + second_vector);
+			}
+		}
+#endif
+		for (; i < size; ++i)
+			result[i] = first[i] + second[i];
+	}
+};
+
+template <typename Element>
+struct SubtractKernel
+{
+	using ElementType = Element;
+
+	template <size_t WIDTH>
+	MATRIX_ALWAYS_INLINE static void run(size_t size, const Element* first, const Element* second,
+			Element* result) noexcept
+	{
+		size_t i = 0;
+#if MATRIX_X86_SIMD
+		if constexpr (WIDTH != 0)
+		{
+			typename VectorOf<Element, WIDTH>::type first_vector, second_vector;
+			constexpr size_t LANE = VectorOf<Element, WIDTH>::LANE;
+			for (; i + LANE <= size; i += LANE)
+			{
+				load_vector<WIDTH>(first_vector, first + i);
+				load_vector<WIDTH>(second_vector, second + i);
+				store_vector<WIDTH>(result + i, first_vector - second_vector);
+			}
+		}
+#endif
+		for (; i < size; ++i)
+			result[i] = first[i] - second[i];
+	}
+};
+
+template <typename Element>
+struct ScaleKernel
+{
+	using ElementType = Element;
+
+	template <size_t WIDTH>
+	MATRIX_ALWAYS_INLINE static void run(size_t size, const Element* source, Element factor,
+			Element* result) noexcept
+	{
+		size_t i = 0;
+#if MATRIX_X86_SIMD
+		if constexpr (WIDTH != 0)
+		{
+			typename VectorOf<Element, WIDTH>::type source_vector;
+			constexpr size_t LANE = VectorOf<Element, WIDTH>::LANE;
+			for (; i + LANE <= size; i += LANE)
+			{
+				load_vector<WIDTH>(source_vector, source + i);
+				store_vector<WIDTH>(result + i, source_vector * factor);
+			}
+		}
+#endif
+		for (; i < size; ++i)
+			result[i] = source[i] * factor;
+	}
+};
+
+template <typename Element>
+struct AxpyKernel
+{
+	using ElementType = Element;
+
+	template <size_t WIDTH>
+	MATRIX_ALWAYS_INLINE static void run(size_t size, Element factor, const Element* source, Element* result) noexcept
+	{
+		size_t i = 0;
+#if MATRIX_X86_SIMD
+		if constexpr (WIDTH != 0)
+		{
+			typename VectorOf<Element, WIDTH>::type source_vector, result_vector;
+			constexpr size_t LANE = VectorOf<Element, WIDTH>::LANE;
+			for (; i + LANE <= size; i += LANE)
+			{
+				load_vector<WIDTH>(source_vector, source + i);
+				load_vector<WIDTH>(result_vector, result + i);
+				store_vector<WIDTH>(result + i, result_vector + source_vector * factor);
+			}
+		}
+#endif
+		for (; i < size; ++i)
+			result[i] += factor * source[i];
+	}
+};
+
+template <typename Element>
+struct RotateKernel
+{
+	using ElementType = Element;
+
+	template <size_t WIDTH>
+	MATRIX_ALWAYS_INLINE static void run(size_t size, Element cosine, Element sine, Element* first,
+			Element* second) noexcept
+	{
+		size_t i = 0;
+#if MATRIX_X86_SIMD
+		if constexpr (WIDTH != 0)
+		{
+			typename VectorOf<Element, WIDTH>::type first_vector, second_vector;
+			constexpr size_t LANE = VectorOf<Element, WIDTH>::LANE;
+			for (; i + LANE <= size; i += LANE)
+			{
+				load_vector<WIDTH>(first_vector, first + i);
+				load_vector<WIDTH>(second_vector, second + i);
+				store_vector<WIDTH>(first + i, first_vector * cosine - second_vector * sine);
+				store_vector<WIDTH>(second + i, first_vector * sine + second_vector * cosine);
+			}
+		}
+#endif
+		for (; i < size; ++i)
+		{
+			const Element first_element = first[i];
+			first[i] = first_element * cosine - second[i] * sine;
+			second[i] = first_element * sine + second[i] * cosine;
+		}
+	}
+};
+
+template <typename Element>
+struct DotKernel
+{
+	using ElementType = Element;
+
+	template <size_t WIDTH>
+	MATRIX_ALWAYS_INLINE static Element run(size_t size, const Element* first, const Element* second) noexcept
+	{
+		Element result = Element(0);
+		size_t i = 0;
+#if MATRIX_X86_SIMD
+		if constexpr (WIDTH != 0)
+		{
+			using Vector = typename VectorOf<Element, WIDTH>::type;
+			constexpr size_t LANE = VectorOf<Element, WIDTH>::LANE;
+			// two independent accumulators hide the latency of the vector add
+			Vector first_accumulator = {};
+			Vector second_accumulator = {};
+			Vector first_vector, second_vector;
+			for (; i + 2 * LANE <= size; i += 2 * LANE)
+			{
+				load_vector<WIDTH>(first_vector, first + i);
+				load_vector<WIDTH>(second_vector, second + i);
+				first_accumulator += first_vector * second_vector;
+				load_vector<WIDTH>(first_vector, first + i + LANE);
+				load_vector<WIDTH>(second_vector, second + i + LANE);
+				second_accumulator += first_vector * second_vector;
+			}
+			first_accumulator += second_accumulator;
+			for (size_t lane = 0; lane < LANE; ++lane)
+				result += first_accumulator[lane];
+		}
+#endif
+		for (; i < size; ++i)
+			result += first[i] * second[i];
+		return result;
+	}
+};
+
+template <typename Element>
+struct StridedSumKernel
+{
+	using ElementType = Element;
+
+	// a diagonal walk touches one element per cache line, so independent accumulators matter more than lanes
+	template <size_t WIDTH>
+	MATRIX_ALWAYS_INLINE static Element run(size_t size, const Element* data, size_t stride) noexcept
+	{
+		Element accumulator[4] = {Element(0), Element(0), Element(0), Element(0)};
+		size_t i = 0;
+		for (; i + 4 <= size; i += 4)
+			for (size_t lane = 0; lane < 4; ++lane)
+				accumulator[lane] += data[(i + lane) * stride];
+		for (; i < size; ++i)
+			accumulator[0] += data[i * stride];
+		return (accumulator[0] + accumulator[1]) + (accumulator[2] + accumulator[3]);
+	}
+};
+
+template <typename Element>
+struct MicroKernel
+{
+	using ElementType = Element;
+
+	template <size_t WIDTH>
+	MATRIX_ALWAYS_INLINE static void run(size_t kc, const Element* packed_a, const Element* packed_b, Element* c,
+			size_t ldc, size_t mr, size_t nr) noexcept
+	{
+		constexpr size_t MR = GemmBlocking<Element>::MR;
+		constexpr size_t NR = GemmBlocking<Element>::NR;
+
+		alignas(64) Element tile[MR][NR] = {};
+#if MATRIX_X86_SIMD
+		if constexpr (WIDTH != 0 and NR * sizeof(Element) % WIDTH == 0)
+		{
+			using Vector = typename VectorOf<Element, WIDTH>::type;
+			constexpr size_t LANE = VectorOf<Element, WIDTH>::LANE;
+			constexpr size_t VECTOR_PER_ROW = NR / LANE;
+
+			Vector accumulator[MR][VECTOR_PER_ROW] = {};
+			for (size_t p = 0; p < kc; ++p)
+			{
+				Vector row_of_b[VECTOR_PER_ROW];
+#pragma GCC unroll 8
+				for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+					load_vector<WIDTH>(row_of_b[v], packed_b + p * NR + v * LANE);
+#pragma GCC unroll 8
+				for (size_t i = 0; i < MR; ++i)
+#pragma GCC unroll 8
+					for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+						accumulator[i][v] += packed_a[p * MR + i] * row_of_b[v];
+			}
+#pragma GCC unroll 8
+			for (size_t i = 0; i < MR; ++i)
+#pragma GCC unroll 8
+				for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+					store_vector<WIDTH>(tile[i] + v * LANE, accumulator[i][v]);
+		}
+		else
+#endif
+		{
+			for (size_t p = 0; p < kc; ++p)
+				for (size_t i = 0; i < MR; ++i)
+					for (size_t j = 0; j < NR; ++j)
+						tile[i][j] += packed_a[p * MR + i] * packed_b[p * NR + j];
+		}
+
+		for (size_t i = 0; i < mr; ++i)
+			for (size_t j = 0; j < nr; ++j)
+				c[i * ldc + j] += tile[i][j];
+	}
+};
+
+#if MATRIX_X86_SIMD
+template <typename Kernel, typename... Arguments>
+MATRIX_TARGET_SSE4_2 auto run_sse4_2(Arguments... arguments) noexcept
+{
+	return Kernel::template run<16>(arguments...);
+}
+
+template <typename Kernel, typename... Arguments>
+MATRIX_TARGET_AVX2 auto run_avx2(Arguments... arguments) noexcept
+{
+	return Kernel::template run<32>(arguments...);
+}
+
+template <typename Kernel, typename... Arguments>
+MATRIX_TARGET_AVX512 auto run_avx512(Arguments... arguments) noexcept
+{
+	return Kernel::template run<64>(arguments...);
+}
+
+template <typename Element>
+struct Avx2Register;
+
+template <>
+struct Avx2Register<double>
+{
+	using Vector = __m256d;
+	static constexpr size_t LANE = 4;
+
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static Vector zero() noexcept
+	{
+		return _mm256_setzero_pd();
+	}
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static Vector load(const double* data) noexcept
+	{
+		return _mm256_loadu_pd(data);
+	}
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static Vector broadcast(const double* data) noexcept
+	{
+		return _mm256_broadcast_sd(data);
+	}
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static Vector fmadd(Vector a, Vector b, Vector c) noexcept
+	{
+		return _mm256_fmadd_pd(a, b, c);
+	}
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static Vector add(Vector a, Vector b) noexcept
+	{
+		return _mm256_add_pd(a, b);
+	}
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static void store(double* data, Vector vector) noexcept
+	{
+		_mm256_storeu_pd(data, vector);
+	}
+};
+
+template <>
+struct Avx2Register<float>
+{
+	using Vector = __m256;
+	static constexpr size_t LANE = 8;
+
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static Vector zero() noexcept
+	{
+		return _mm256_setzero_ps();
+	}
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static Vector load(const float* data) noexcept
+	{
+		return _mm256_loadu_ps(data);
+	}
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static Vector broadcast(const float* data) noexcept
+	{
+		return _mm256_broadcast_ss(data);
+	}
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static Vector fmadd(Vector a, Vector b, Vector c) noexcept
+	{
+		return _mm256_fmadd_ps(a, b, c);
+	}
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static Vector add(Vector a, Vector b) noexcept
+	{
+		return _mm256_add_ps(a, b);
+	}
+	MATRIX_TARGET_AVX2 MATRIX_ALWAYS_INLINE static void store(float* data, Vector vector) noexcept
+	{
+		_mm256_storeu_ps(data, vector);
+	}
+};
+
+template <typename Element>
+struct Avx512Register;
+
+template <>
+struct Avx512Register<double>
+{
+	using Vector = __m512d;
+	static constexpr size_t LANE = 8;
+
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static Vector zero() noexcept
+	{
+		return _mm512_setzero_pd();
+	}
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static Vector load(const double* data) noexcept
+	{
+		return _mm512_loadu_pd(data);
+	}
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static Vector broadcast(const double* data) noexcept
+	{
+		return _mm512_set1_pd(*data);
+	}
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static Vector fmadd(Vector a, Vector b, Vector c) noexcept
+	{
+		return _mm512_fmadd_pd(a, b, c);
+	}
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static Vector add(Vector a, Vector b) noexcept
+	{
+		return _mm512_add_pd(a, b);
+	}
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static void store(double* data, Vector vector) noexcept
+	{
+		_mm512_storeu_pd(data, vector);
+	}
+};
+
+template <>
+struct Avx512Register<float>
+{
+	using Vector = __m512;
+	static constexpr size_t LANE = 16;
+
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static Vector zero() noexcept
+	{
+		return _mm512_setzero_ps();
+	}
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static Vector load(const float* data) noexcept
+	{
+		return _mm512_loadu_ps(data);
+	}
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static Vector broadcast(const float* data) noexcept
+	{
+		return _mm512_set1_ps(*data);
+	}
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static Vector fmadd(Vector a, Vector b, Vector c) noexcept
+	{
+		return _mm512_fmadd_ps(a, b, c);
+	}
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static Vector add(Vector a, Vector b) noexcept
+	{
+		return _mm512_add_ps(a, b);
+	}
+	MATRIX_TARGET_AVX512 MATRIX_ALWAYS_INLINE static void store(float* data, Vector vector) noexcept
+	{
+		_mm512_storeu_ps(data, vector);
+	}
+};
+
+// Floating point tiles are written with intrinsics so that the accumulation is fused even without -ffp-contract.
+template <typename Element>
+MATRIX_TARGET_AVX2 void fma_micro_kernel_avx2(size_t kc, const Element* packed_a, const Element* packed_b, Element* c,
+		size_t ldc, size_t mr, size_t nr) noexcept
+{
+	using Register = Avx2Register<Element>;
+	using Vector = typename Register::Vector;
+	constexpr size_t MR = GemmBlocking<Element>::MR;
+	constexpr size_t NR = GemmBlocking<Element>::NR;
+	constexpr size_t VECTOR_PER_ROW = NR / Register::LANE;
+
+	Vector accumulator[MR][VECTOR_PER_ROW];
+#pragma GCC unroll 8
+	for (size_t i = 0; i < MR; ++i)
+#pragma GCC unroll 4
+		for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+			accumulator[i][v] = Register::zero();
+
+	for (size_t p = 0; p < kc; ++p)
+	{
+		Vector row_of_b[VECTOR_PER_ROW];
+#pragma GCC unroll 4
+		for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+			row_of_b[v] = Register::load(packed_b + p * NR + v * Register::LANE);
+#pragma GCC unroll 8
+		for (size_t i = 0; i < MR; ++i)
+		{
+			const Vector element_of_a = Register::broadcast(packed_a + p * MR + i);
+#pragma GCC unroll 4
+			for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+				accumulator[i][v] = Register::fmadd(element_of_a, row_of_b[v], accumulator[i][v]);
+		}
+	}
+
+	if (mr == MR and nr == NR)
+	{
+#pragma GCC unroll 8
+		for (size_t i = 0; i < MR; ++i)
+#pragma GCC unroll 4
+			for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+			{
+				Element* row_of_c = c + i * ldc + v * Register::LANE;
+				Register::store(row_of_c, Register::add(Register::load(row_of_c), accumulator[i][v]));
+			}
+		return;
+	}
+
+	alignas(64) Element tile[MR][NR];
+#pragma GCC unroll 8
+	for (size_t i = 0; i < MR; ++i)
+#pragma GCC unroll 4
+		for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+			Register::store(tile[i] + v * Register::LANE, accumulator[i][v]);
+	for (size_t i = 0; i < mr; ++i)
+		for (size_t j = 0; j < nr; ++j)
+			c[i * ldc + j] += tile[i][j];
+}
+
+template <typename Element>
+MATRIX_TARGET_AVX512 void fma_micro_kernel_avx512(size_t kc, const Element* packed_a, const Element* packed_b,
+		Element* c, size_t ldc, size_t mr, size_t nr) noexcept
+{
+	using Register = Avx512Register<Element>;
+	using Vector = typename Register::Vector;
+	constexpr size_t MR = GemmBlocking<Element>::MR;
+	constexpr size_t NR = GemmBlocking<Element>::NR;
+	constexpr size_t VECTOR_PER_ROW = NR / Register::LANE;
+
+	Vector accumulator[MR][VECTOR_PER_ROW];
+#pragma GCC unroll 8
+	for (size_t i = 0; i < MR; ++i)
+#pragma GCC unroll 4
+		for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+			accumulator[i][v] = Register::zero();
+
+	for (size_t p = 0; p < kc; ++p)
+	{
+		Vector row_of_b[VECTOR_PER_ROW];
+#pragma GCC unroll 4
+		for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+			row_of_b[v] = Register::load(packed_b + p * NR + v * Register::LANE);
+#pragma GCC unroll 8
+		for (size_t i = 0; i < MR; ++i)
+		{
+			const Vector element_of_a = Register::broadcast(packed_a + p * MR + i);
+#pragma GCC unroll 4
+			for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+				accumulator[i][v] = Register::fmadd(element_of_a, row_of_b[v], accumulator[i][v]);
+		}
+	}
+
+	if (mr == MR and nr == NR)
+	{
+#pragma GCC unroll 8
+		for (size_t i = 0; i < MR; ++i)
+#pragma GCC unroll 4
+			for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+			{
+				Element* row_of_c = c + i * ldc + v * Register::LANE;
+				Register::store(row_of_c, Register::add(Register::load(row_of_c), accumulator[i][v]));
+			}
+		return;
+	}
+
+	alignas(64) Element tile[MR][NR];
+#pragma GCC unroll 8
+	for (size_t i = 0; i < MR; ++i)
+#pragma GCC unroll 4
+		for (size_t v = 0; v < VECTOR_PER_ROW; ++v)
+			Register::store(tile[i] + v * Register::LANE, accumulator[i][v]);
+	for (size_t i = 0; i < mr; ++i)
+		for (size_t j = 0; j < nr; ++j)
+			c[i * ldc + j] += tile[i][j];
+}
+#endif
+
+template <typename Kernel, typename... Arguments>
+auto dispatch(Arguments... arguments) noexcept
+{
+#if MATRIX_X86_SIMD
+	if constexpr (is_simd_element_v<typename Kernel::ElementType>)
+	{
+		switch (get_instruction_set())
+		{
+			case InstructionSet::avx512:
+				return run_avx512<Kernel>(arguments...);
+			case InstructionSet::avx2:
+				return run_avx2<Kernel>(arguments...);
+			case InstructionSet::sse4_2:
+				return run_sse4_2<Kernel>(arguments...);
+			case InstructionSet::scalar:
+				break;
+		}
+	}
+#endif
+	return Kernel::template run<0>(arguments...);
+}
+
+template <typename Element>
+void add(size_t size, const Element* first, const Element* second, Element* result) noexcept
+{
+	dispatch<AddKernel<Element>>(size, first, second, result);
+}
+
+template <typename Element>
+void subtract(size_t size, const Element* first, const Element* second, Element* result) noexcept
+{
+	dispatch<SubtractKernel<Element>>(size, first, second, result);
+}
+
+template <typename Element>
+void scale(size_t size, const Element* source, Element factor, Element* result) noexcept
+{
+	dispatch<ScaleKernel<Element>>(size, source, factor, result);
+}
+
+template <typename Element>
+void axpy(size_t size, Element factor, const Element* source, Element* result) noexcept
+{
+	dispatch<AxpyKernel<Element>>(size, factor, source, result);
+}
+
+template <typename Element>
+void rotate(size_t size, Element cosine, Element sine, Element* first, Element* second) noexcept
+{
+	dispatch<RotateKernel<Element>>(size, cosine, sine, first, second);
+}
+
+template <typename Element>
+Element dot(size_t size, const Element* first, const Element* second) noexcept
+{
+	return dispatch<DotKernel<Element>>(size, first, second);
+}
+
+template <typename Element>
+Element strided_sum(size_t size, const Element* data, size_t stride) noexcept
+{
+	return dispatch<StridedSumKernel<Element>>(size, data, stride);
+}
+
+template <typename Element>
+void micro_kernel(size_t kc, const Element* packed_a, const Element* packed_b, Element* c, size_t ldc, size_t mr,
+		size_t nr) noexcept
+{
+#if MATRIX_X86_SIMD
+	if constexpr (std::is_floating_point_v<Element> and is_simd_element_v<Element>)
+	{
+		switch (get_instruction_set())
+		{
+			case InstructionSet::avx512:
+				return fma_micro_kernel_avx512(kc, packed_a, packed_b, c, ldc, mr, nr);
+			case InstructionSet::avx2:
+				return fma_micro_kernel_avx2(kc, packed_a, packed_b, c, ldc, mr, nr);
+			default:
+				break;
+		}
+	}
+#endif
+	dispatch<MicroKernel<Element>>(kc, packed_a, packed_b, c, ldc, mr, nr);
+}
+
+}		 // namespace matrix_kernel
+
+#endif
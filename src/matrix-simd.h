@@ -0,0 +1,88 @@
+#ifndef MATRIX_SIMD_H
+#define MATRIX_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <type_traits>
+
+#if (defined(__x86_64__) or defined(__i386__)) and (defined(__GNUC__) or defined(__clang__))
+#define MATRIX_X86_SIMD 1
+#define MATRIX_ALWAYS_INLINE [[gnu::always_inline]] inline
+#define MATRIX_TARGET_SSE4_2 [[gnu::target("sse4.2")]]
+#define MATRIX_TARGET_AVX2 [[gnu::target("avx2,fma")]]
+#define MATRIX_TARGET_AVX512 [[gnu::target("avx512f,avx512dq,avx2,fma")]]
+#else
+#define MATRIX_X86_SIMD 0
+#define MATRIX_ALWAYS_INLINE inline
+#endif
+
+namespace matrix_kernel
+{
+
+enum class InstructionSet : uint8_t
+{
+	scalar,
+	sse4_2,
+	avx2,
+	avx512,
+};
+
+// widest instruction set supported by both the CPU and the OS, probed once at startup
+[[nodiscard]] InstructionSet detect_instruction_set() noexcept;
+[[nodiscard]] InstructionSet get_instruction_set() noexcept;
+// never goes above the detected instruction set
+void set_instruction_set(InstructionSet instruction_set) noexcept;
+
+template <typename Element>
+inline constexpr bool is_simd_element_v = std::is_same_v<Element, float> or std::is_same_v<Element, double> or
+		std::is_same_v<Element, int32_t> or std::is_same_v<Element, int64_t>;
+
+template <typename Element>
+struct GemmBlocking
+{
+	// register tile of the micro kernel
+	static constexpr size_t MR = 6;
+	static constexpr size_t NR = sizeof(Element) >= 8 ? 8 : 16;
+	// packed panel of A (MC x KC) stays in L2, packed panel of B (KC x NC) stays in L3
+	static constexpr size_t KC = 256;
+	static constexpr size_t MC = 120;
+	static constexpr size_t NC = 4096;
+};
+
+// result = first + second
+template <typename Element>
+void add(size_t size, const Element* first, const Element* second, Element* result) noexcept;
+
+// result = first - second
+template <typename Element>
+void subtract(size_t size, const Element* first, const Element* second, Element* result) noexcept;
+
+// result = factor * source
+template <typename Element>
+void scale(size_t size, const Element* source, Element factor, Element* result) noexcept;
+
+// result += factor * source
+template <typename Element>
+void axpy(size_t size, Element factor, const Element* source, Element* result) noexcept;
+
+// (first, second) = (cosine * first - sine * second, sine * first + cosine * second), a Givens rotation of two rows
+template <typename Element>
+void rotate(size_t size, Element cosine, Element sine, Element* first, Element* second) noexcept;
+
+template <typename Element>
+[[nodiscard]] Element dot(size_t size, const Element* first, const Element* second) noexcept;
+
+template <typename Element>
+[[nodiscard]] Element strided_sum(size_t size, const Element* data, size_t stride) noexcept;
+
+// C (mr x nr) += packed A sliver (kc x MR) * packed B sliver (kc x NR)
+template <typename Element>
+void micro_kernel(size_t kc, const Element* packed_a, const Element* packed_b, Element* c, size_t ldc, size_t mr,
+		size_t nr) noexcept;
+
+}		 // namespace matrix_kernel
+
+#include "matrix-simd-tmp.h"
+
+#endif
@@ -1,16 +1,33 @@
 #ifndef MATRIX_MATRIX_TMP_H
 #define MATRIX_MATRIX_TMP_H
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include "cholesky-decomposition.h"
+#include "eigen-decomposition.h"
+#include "hessenberg-decomposition.h"
+#include "ldlt-decomposition.h"
+#include "lu-decomposition.h"
+#include "modular-determinant.h"
+#include "partial-eigen-decomposition.h"
+#include "symmetric-eigen-decomposition.h"
+
 template <Elementable Element>
 Matrix<Element> Matrix<Element>::create_i_matrix(size_t size)
 {
 	Matrix<Element> result(size, size);
 	for (size_t i : std::views::iota(0LLU, size))
 	{
-		result[i][i] = 1;
+		result.mutable_rows()[i][i] = 1;
 	}
 	return result;
 }
@@ -19,7 +36,8 @@ template <Elementable Element>
 Matrix<Element>::Matrix(size_t row, size_t col)
 : number_of_row(row)
 , number_of_col(col)
-, table(row, RowType(col, Element(0)))
+, stride(col)
+, storage(row * col, Element(0))
 {
 }
 
@@ -28,14 +46,15 @@ template <template <Containerable> typename Container>
 Matrix<Element>::Matrix(const Container<Container<Element>>& matrix)
 : number_of_row(matrix.size())
 , number_of_col(matrix.begin()->size())
-, table(0)
+, stride(number_of_col)
 {
+	storage.reserve(number_of_row * number_of_col);
 	for (const auto& row_of_matrix : matrix)
 	{
 		if (row_of_matrix.size() != number_of_col)
 			throw std::invalid_argument("Cannot creat matrix with different column size.");
 
-		table.emplace_back(row_of_matrix);
+		storage.insert(storage.end(), row_of_matrix.begin(), row_of_matrix.end());
 	}
 }
 
@@ -43,96 +62,281 @@ template <Elementable Element>
 Matrix<Element>::Matrix(const std::initializer_list<std::initializer_list<Element>>& matrix)
 : number_of_row(matrix.size())
 , number_of_col(matrix.begin()->size())
-, table(0)
+, stride(number_of_col)
 {
+	storage.reserve(number_of_row * number_of_col);
 	for (const auto& row_of_matrix : matrix)
 	{
 		if (row_of_matrix.size() != number_of_col)
 			throw std::invalid_argument("Cannot creat matrix with different column size.");
 
-		table.emplace_back(row_of_matrix);
+		storage.insert(storage.end(), row_of_matrix.begin(), row_of_matrix.end());
+	}
+}
+
+template <Elementable Element>
+template <typename ViewElement>
+	requires std::same_as<std::remove_const_t<ViewElement>, Element>
+Matrix<Element>::Matrix(const MatrixView<ViewElement>& matrix)
+: number_of_row(matrix.get_number_of_row())
+, number_of_col(matrix.get_number_of_col())
+, stride(number_of_col)
+{
+	storage.reserve(number_of_row * number_of_col);
+	for (size_t row_index = 0; row_index < number_of_row; ++row_index)
+	{
+		const RowView<ViewElement> row_of_matrix = matrix[row_index];
+		storage.insert(storage.end(), row_of_matrix.begin(), row_of_matrix.end());
+	}
+}
+
+template <Elementable Element>
+template <MatrixExpressionNode Expression>
+	requires std::same_as<typename Expression::value_type, Element>
+Matrix<Element>::Matrix(const Expression& expression)
+: number_of_row(expression.get_number_of_row())
+, number_of_col(expression.get_number_of_col())
+, stride(number_of_col)
+, storage(number_of_row * number_of_col, Element(0))
+{
+	expression.evaluate_into(storage.data(), stride);
+}
+
+template <Elementable Element>
+template <MatrixExpressionNode Expression>
+	requires std::same_as<typename Expression::value_type, Element>
+Matrix<Element>& Matrix<Element>::operator=(const Expression& expression)
+{
+	// an element-wise tree may read this matrix, but only element (i, j) to write element (i, j)
+	if constexpr (Expression::is_element_wise)
+	{
+		if (number_of_row == expression.get_number_of_row() and number_of_col == expression.get_number_of_col())
+		{
+			invalidate_cache();
+			expression.evaluate_into(storage.data(), stride);
+			return *this;
+		}
 	}
+
+	*this = Matrix(expression);
+	return *this;
+}
+
+template <Elementable Element>
+MatrixView<const Element> Matrix<Element>::view() const noexcept
+{
+	return MatrixView<const Element>(storage.data(), number_of_row, number_of_col, stride);
+}
+
+template <Elementable Element>
+Matrix<Element>::operator MatrixView<const Element>() const noexcept
+{
+	return view();
+}
+
+template <Elementable Element>
+MatrixView<const Element> Matrix<Element>::sub_matrix(size_t first_row, size_t first_col, size_t row,
+		size_t col) const
+{
+	return view().sub_matrix(first_row, first_col, row, col);
+}
+
+template <Elementable Element>
+RowView<const Element> Matrix<Element>::row(size_t idx) const
+{
+	return view().row(idx);
+}
+
+template <Elementable Element>
+ColumnView<const Element> Matrix<Element>::column(size_t idx) const
+{
+	return view().column(idx);
 }
 
 template <Elementable Element>
 template <typename OtherElement>
 	requires SumableDifferentType<Element, OtherElement>
 Matrix<Element> Matrix<Element>::sum(const Matrix<OtherElement>& other) const
+{
+	return sum(other.view());
+}
+
+template <Elementable Element>
+template <typename OtherElement>
+	requires SumableDifferentType<Element, std::remove_const_t<OtherElement>>
+Matrix<Element> Matrix<Element>::sum(const MatrixView<OtherElement>& other) const
 {
 	if (number_of_row != other.get_number_of_row() or number_of_col != other.get_number_of_col())
 		throw std::invalid_argument("Cannot sum spans of different sizes");
 
 	Matrix<Element> result(number_of_row, number_of_col);
-	for (size_t row_index = 0; row_index < number_of_row; ++row_index)
-		for (size_t col_index = 0; col_index < number_of_col; ++col_index)
-			result[row_index][col_index] = table[row_index][col_index] + other[row_index][col_index];
+	const MutableRows result_rows = result.mutable_rows();
+	matrix_helper::parallel_for(number_of_row, number_of_col, [&](size_t row_begin, size_t row_end)
+	{
+		for (size_t row_index = row_begin; row_index < row_end; ++row_index)
+		{
+			const Element* row_of_table = row_data(row_index);
+			const RowView<OtherElement> row_of_other = other[row_index];
+			Element* row_of_result = result_rows.row_data(row_index);
+			if constexpr (std::is_same_v<Element, std::remove_const_t<OtherElement>>)
+			{
+				matrix_kernel::add(number_of_col, row_of_table, row_of_other.data(), row_of_result);
+			}
+			else
+			{
+				for (size_t col_index = 0; col_index < number_of_col; ++col_index)
+					row_of_result[col_index] = row_of_table[col_index] + row_of_other[col_index];
+			}
+		}
+	});
 
 	return result;
 }
 
 template <Elementable Element>
 template <typename OtherElement>
-Matrix<Element> Matrix<Element>::operator+(const Matrix<OtherElement>& other) const
+Matrix<Element>& Matrix<Element>::operator+=(const Matrix<OtherElement>& other)
 {
-	return sum(std::move(other));
+	return *this += other.view();
 }
 
 template <Elementable Element>
 template <typename OtherElement>
-Matrix<Element>& Matrix<Element>::operator+=(const Matrix<OtherElement>& other)
+	requires SumableDifferentType<Element, std::remove_const_t<OtherElement>>
+Matrix<Element>& Matrix<Element>::operator+=(const MatrixView<OtherElement>& other)
 {
-	*this = sum(other);
+	if (number_of_row != other.get_number_of_row() or number_of_col != other.get_number_of_col())
+		throw std::invalid_argument("Cannot sum spans of different sizes");
+
+	const MutableRows rows = mutable_rows();
+	matrix_helper::parallel_for(number_of_row, number_of_col, [&](size_t row_begin, size_t row_end)
+	{
+		for (size_t row_index = row_begin; row_index < row_end; ++row_index)
+		{
+			Element* row_of_table = rows.row_data(row_index);
+			const RowView<OtherElement> row_of_other = other[row_index];
+			if constexpr (std::is_same_v<Element, std::remove_const_t<OtherElement>>)
+			{
+				matrix_kernel::add(number_of_col, row_of_table, row_of_other.data(), row_of_table);
+			}
+			else
+			{
+				for (size_t col_index = 0; col_index < number_of_col; ++col_index)
+					row_of_table[col_index] = row_of_table[col_index] + row_of_other[col_index];
+			}
+		}
+	});
+
 	return *this;
 }
 
 template <Elementable Element>
-Matrix<Element> Matrix<Element>::operator-() const
+template <MatrixExpressionNode Expression>
+Matrix<Element>& Matrix<Element>::operator+=(const Expression& expression)
 {
-	Matrix tmp(*this);
-
-	for (RowType& row_of_tmp : tmp.table)
-		for (Element& element_of_tmp : row_of_tmp)
-			element_of_tmp = -element_of_tmp;
-
-	return tmp;
+	return *this = *this + expression;
 }
 
 template <Elementable Element>
 template <typename OtherElement>
 Matrix<Element> Matrix<Element>::submission(const Matrix<OtherElement>& other) const
 {
-	return sum(-other);
+	return submission(other.view());
 }
 
 template <Elementable Element>
 template <typename OtherElement>
-Matrix<Element> Matrix<Element>::operator-(const Matrix<OtherElement>& other) const
+Matrix<Element> Matrix<Element>::submission(const MatrixView<OtherElement>& other) const
 {
-	return submission(other);
+	if (number_of_row != other.get_number_of_row() or number_of_col != other.get_number_of_col())
+		throw std::invalid_argument("Cannot submission spans of different sizes");
+
+	Matrix<Element> result(number_of_row, number_of_col);
+	const MutableRows result_rows = result.mutable_rows();
+	matrix_helper::parallel_for(number_of_row, number_of_col, [&](size_t row_begin, size_t row_end)
+	{
+		for (size_t row_index = row_begin; row_index < row_end; ++row_index)
+		{
+			const Element* row_of_table = row_data(row_index);
+			const RowView<OtherElement> row_of_other = other[row_index];
+			Element* row_of_result = result_rows.row_data(row_index);
+			if constexpr (std::is_same_v<Element, std::remove_const_t<OtherElement>>)
+			{
+				matrix_kernel::subtract(number_of_col, row_of_table, row_of_other.data(), row_of_result);
+			}
+			else
+			{
+				for (size_t col_index = 0; col_index < number_of_col; ++col_index)
+					row_of_result[col_index] = row_of_table[col_index] - row_of_other[col_index];
+			}
+		}
+	});
+
+	return result;
 }
 
 template <Elementable Element>
 template <typename OtherElement>
 Matrix<Element>& Matrix<Element>::operator-=(const Matrix<OtherElement>& other)
 {
-	*this = submission(other);
+	return *this -= other.view();
+}
+
+template <Elementable Element>
+template <typename OtherElement>
+Matrix<Element>& Matrix<Element>::operator-=(const MatrixView<OtherElement>& other)
+{
+	if (number_of_row != other.get_number_of_row() or number_of_col != other.get_number_of_col())
+		throw std::invalid_argument("Cannot submission spans of different sizes");
+
+	const MutableRows rows = mutable_rows();
+	matrix_helper::parallel_for(number_of_row, number_of_col, [&](size_t row_begin, size_t row_end)
+	{
+		for (size_t row_index = row_begin; row_index < row_end; ++row_index)
+		{
+			Element* row_of_table = rows.row_data(row_index);
+			const RowView<OtherElement> row_of_other = other[row_index];
+			if constexpr (std::is_same_v<Element, std::remove_const_t<OtherElement>>)
+			{
+				matrix_kernel::subtract(number_of_col, row_of_table, row_of_other.data(), row_of_table);
+			}
+			else
+			{
+				for (size_t col_index = 0; col_index < number_of_col; ++col_index)
+					row_of_table[col_index] = row_of_table[col_index] - row_of_other[col_index];
+			}
+		}
+	});
+
 	return *this;
 }
 
+template <Elementable Element>
+template <MatrixExpressionNode Expression>
+Matrix<Element>& Matrix<Element>::operator-=(const Expression& expression)
+{
+	return *this = *this - expression;
+}
+
 template <Elementable Element>
 template <typename OtherElement>
 	requires MultiplableDifferentTypeReturnFirstType<Element, OtherElement>
 Matrix<Element> Matrix<Element>::multiple(const Matrix<OtherElement>& other) const
+{
+	return multiple(other.view());
+}
+
+template <Elementable Element>
+template <typename OtherElement>
+	requires MultiplableDifferentTypeReturnFirstType<Element, std::remove_const_t<OtherElement>>
+Matrix<Element> Matrix<Element>::multiple(const MatrixView<OtherElement>& other) const
 {
 	if (number_of_col != other.get_number_of_row())
 		throw std::invalid_argument("the number of rows must match the number of columns.");
 
-	Matrix<Element> result(number_of_row, number_of_col);
-
-	for (size_t i = 0; i < number_of_row; ++i)
-		for (size_t k = 0; k < number_of_col; ++k)
-			for (size_t j = 0; j < other.get_number_of_col(); ++j)
-				result[i][j] += table[i][k] * other[k][j];
+	Matrix<Element> result(number_of_row, other.get_number_of_col());
+	matrix_kernel::gemm(number_of_row, other.get_number_of_col(), number_of_col, storage.data(), stride,
+			other.get_data(), other.get_stride(), result.storage.data(), result.stride);
 
 	return result;
 }
@@ -143,114 +347,526 @@ template <typename OtherElement>
 Matrix<Element> Matrix<Element>::multiple(const OtherElement& other) const
 {
 	Matrix<Element> result = *this;
-	for (RowType& row_of_table : result.table)
+	result *= other;
+	return result;
+}
+
+template <Elementable Element>
+template <typename OtherElement>
+Matrix<Element>& Matrix<Element>::operator*=(const OtherElement& other)
+{
+	if constexpr (MatrixOperand<OtherElement>)
 	{
-		for (Element& element : row_of_table)
+		// a product cannot overwrite its own operand
+		*this = *this * other;
+	}
+	else
+	{
+		invalidate_cache();
+		Element* data = storage.data();
+		matrix_helper::parallel_for(storage.size(), 1, [data, &other](size_t begin, size_t end)
 		{
-			if constexpr (MultipleAssignableDifferentType<Element, OtherElement>)
-				element *= other;
-			else if constexpr (MultiplableDifferentTypeReturnFirstType<Element, OtherElement>)
-				element = element * other;
-			else if constexpr (MultiplableDifferentTypeReturnSecondType<Element, OtherElement>)
-				element = other * element;
-		}
+			if constexpr (matrix_kernel::is_simd_element_v<Element> and std::is_same_v<Element, OtherElement>)
+			{
+				matrix_kernel::scale(end - begin, data + begin, other, data + begin);
+				return;
+			}
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				Element& element = data[i];
+				if constexpr (MultipleAssignableDifferentType<Element, OtherElement>)
+					element *= other;
+				else if constexpr (MultiplableDifferentTypeReturnFirstType<Element, OtherElement>)
+					element = element * other;
+				else if constexpr (MultiplableDifferentTypeReturnSecondType<Element, OtherElement>)
+					element = other * element;
+			}
+		});
 	}
-	return result;
+	return *this;
+}
+
+template <Elementable Element, typename Right>
+	requires MatrixOperand<Right> and SumableDifferentType<Element, matrix_expression::value_type_t<Right>>
+Matrix<Element> operator+(Matrix<Element>&& left, Right&& right)
+{
+	left += right;
+	return std::move(left);
+}
+
+template <Elementable Element, typename Right>
+	requires MatrixOperand<Right>
+Matrix<Element> operator-(Matrix<Element>&& left, Right&& right)
+{
+	left -= right;
+	return std::move(left);
 }
 
 template <Elementable Element>
-template <typename OtherElement>
-Matrix<Element> Matrix<Element>::operator*(const OtherElement& other) const
+Matrix<Element> operator-(Matrix<Element>&& operand)
+{
+	// element-wise, so the negation is written over the operand
+	operand = -operand;
+	return std::move(operand);
+}
+
+template <Elementable Element, typename Scalar>
+	requires(not MatrixOperand<Scalar>) and MultiplableDifferentType<Element, Scalar>
+Matrix<Element> operator*(Matrix<Element>&& matrix, const Scalar& scalar)
 {
-	return multiple(std::move(other));
+	matrix *= scalar;
+	return std::move(matrix);
+}
+
+template <typename Scalar, Elementable Element>
+	requires(not MatrixOperand<Scalar>) and MultiplableDifferentType<Element, Scalar>
+Matrix<Element> operator*(const Scalar& scalar, Matrix<Element>&& matrix)
+{
+	matrix *= scalar;
+	return std::move(matrix);
 }
 
 template <Elementable Element>
-template <typename OtherElement>
-Matrix<Element>& Matrix<Element>::operator*=(const OtherElement& other)
+RowView<const Element> Matrix<Element>::operator[](size_t idx) const
 {
-	*this = multiple(other);
-	return *this;
+	return RowView<const Element>(row_data(idx), number_of_col);
+}
+
+template <Elementable Element>
+Matrix<Element>::MutableRows::MutableRows(Matrix& matrix) noexcept
+: data(matrix.storage.data())
+, number_of_col(matrix.number_of_col)
+, stride(matrix.stride)
+{
+	matrix.invalidate_cache();
 }
 
-template <typename Element, typename OtherElement>
-	requires(not IsMatrixable<Element>) and
-		(not IsMatrixable<OtherElement>) and MultiplableDifferentType<Element, OtherElement>
-Matrix<Element> operator*(const OtherElement& number, const Matrix<Element>& matrix)
+template <Elementable Element>
+RowView<Element> Matrix<Element>::MutableRows::operator[](size_t idx) const noexcept
 {
-	return std::move(matrix * number);
+	return RowView<Element>(row_data(idx), number_of_col);
 }
 
 template <Elementable Element>
-Matrix<Element>::RowType Matrix<Element>::operator[](size_t idx) const
+Element* Matrix<Element>::MutableRows::row_data(size_t idx) const noexcept
 {
-	return table[idx];
+	return data + idx * stride;
 }
 
 template <Elementable Element>
-Matrix<Element>::RowType& Matrix<Element>::operator[](size_t idx)
+auto Matrix<Element>::mutable_rows() noexcept -> MutableRows
 {
-	return table[idx];
+	return MutableRows(*this);
+}
+
+template <Elementable Element>
+const Element* Matrix<Element>::row_data(size_t idx) const noexcept
+{
+	return storage.data() + idx * stride;
+}
+
+template <Elementable Element>
+void Matrix<Element>::swap_rows(size_t first_row_index, size_t second_row_index) noexcept
+{
+	if (first_row_index == second_row_index)
+		return;
+
+	const MutableRows rows = mutable_rows();
+	Element* first_row = rows.row_data(first_row_index);
+	std::swap_ranges(first_row, first_row + number_of_col, rows.row_data(second_row_index));
 }
 
 template <Elementable Element>
 Element Matrix<Element>::at(size_t row_index, size_t col_index)
 {
-	return table[row_index][col_index];
+	return std::as_const(*this).row_data(row_index)[col_index];
+}
+
+template <Elementable Element>
+void Matrix<Element>::set_cache_enabled(bool enabled)
+{
+	cache.set_enabled(enabled);
+}
+
+template <Elementable Element>
+bool Matrix<Element>::is_cache_enabled() const noexcept
+{
+	return cache.is_enabled();
 }
 
 template <Elementable Element>
 Element Matrix<Element>::determinant() const
+{
+	return cache.template get<CachedProperty::determinant>([this] { return compute_determinant(); });
+}
+
+template <Elementable Element>
+Element Matrix<Element>::compute_determinant() const
 {
 	if (number_of_col != number_of_row)
 		throw std::invalid_argument("Matrix<Element>::determinant: column and number_of_row must be equal");
 
-	TableType tmp_table = table;
-	size_t number_of_swap = 0;
-	for (size_t col_index = 0; col_index < number_of_col; col_index++)
+	const MatrixStructure shape = structure();
+	if (shape.lower_triangular or shape.upper_triangular)
+	{
+		Element det = 1;
+		bool overflow = false;
+		for (size_t i = 0; i < number_of_row and not overflow; ++i)
+		{
+			if constexpr (Integrable<Element>)
+				overflow = not matrix_helper::checked_multiply(det, row_data(i)[i], det);
+			else
+				det *= row_data(i)[i];
+		}
+		// Bareiss decides between the modular fallback and std::overflow_error
+		if (not overflow)
+			return det;
+	}
+	else if (shape.permutation)
 	{
-		size_t swap_row_index = col_index;
-		Element base_of_column = tmp_table[swap_row_index][col_index];
-		// TODO: create concept for check exit Element == 0
-		while (base_of_column == 0 and swap_row_index < number_of_row)
+		// (-1)^(size - number of cycles)
+		std::vector<size_t> columns = permutation_columns();
+		bool negative = false;
+		for (size_t i = 0; i < number_of_row; ++i)
 		{
-			base_of_column = tmp_table[swap_row_index][col_index];
-			++swap_row_index;
+			while (columns[i] != i)
+			{
+				std::swap(columns[i], columns[columns[i]]);
+				negative = not negative;
+			}
 		}
+		if (not negative or not std::is_unsigned_v<Element>)
+			return negative ? Element(-1) : Element(1);
+	}
 
-		if (base_of_column == 0)
+	// Cholesky needs square roots and an ordering
+	if constexpr (std::floating_point<Element>)
+	{
+		if (shape.may_be_positive_definite)
+		{
+			const CholeskyDecomposition<Element> cholesky(*this);
+			if (cholesky.is_positive_definite())
+				return cholesky.determinant();
+		}
+	}
+	if constexpr (Integrable<Element>)
+		return bareiss_determinant();
+	else
+		return lu_decomposition().determinant();
+}
+
+// Bareiss: after step k every trailing entry is a (k + 1) x (k + 1) minor of A, so dividing by the previous pivot
+// is always exact and nothing grows beyond the size of a minor
+template <Elementable Element>
+Element Matrix<Element>::bareiss_determinant() const
+	requires Integrable<Element>
+{
+	using Wide = matrix_helper::WideInteger;
+	const size_t size = number_of_row;
+	std::vector<Wide> table(size * size);
+	for (size_t row_index = 0; row_index < size; ++row_index)
+		std::copy_n(row_data(row_index), size, table.begin() + static_cast<std::ptrdiff_t>(row_index * size));
+
+	bool negative = false;
+	Wide previous_pivot = 1;
+	for (size_t col_index = 0; col_index < size; ++col_index)
+	{
+		size_t pivot_row_index = col_index;
+		while (pivot_row_index < size and table[pivot_row_index * size + col_index] == 0)
+			++pivot_row_index;
+		if (pivot_row_index == size)
 			return 0;
-		else if (swap_row_index != col_index)
+		if (pivot_row_index != col_index)
 		{
-			std::swap(tmp_table[swap_row_index - 1], tmp_table[col_index]);
-			++number_of_swap;
+			std::swap_ranges(table.begin() + static_cast<std::ptrdiff_t>(pivot_row_index * size),
+					table.begin() + static_cast<std::ptrdiff_t>((pivot_row_index + 1) * size),
+					table.begin() + static_cast<std::ptrdiff_t>(col_index * size));
+			negative = not negative;
 		}
 
-		for (size_t row_index = col_index + 1; row_index < number_of_row; row_index++)
+		const Wide* pivot_row = table.data() + col_index * size;
+		const Wide pivot = pivot_row[col_index];
+		const size_t first_row_index = col_index + 1;
+		std::atomic<bool> overflow = false;
+		matrix_helper::parallel_for(size - first_row_index, size - col_index, [&](size_t begin, size_t end)
 		{
-			if (tmp_table[row_index][col_index] == 0)
-				continue;
+			for (size_t row_index = first_row_index + begin; row_index < first_row_index + end; ++row_index)
+			{
+				Wide* row = table.data() + row_index * size;
+				for (size_t i = first_row_index; i < size; ++i)
+				{
+					Wide numerator;
+					if (not matrix_helper::checked_cross_difference(row[i], pivot, row[col_index], pivot_row[i],
+								numerator))
+					{
+						overflow = true;
+						return;
+					}
+					row[i] = numerator / previous_pivot;
+				}
+			}
+		});
+		// a minor outgrew the wide type, the determinant itself may still fit
+		if (overflow)
+			return modular_determinant();
+		previous_pivot = pivot;
+	}
+
+	const Wide det = negative ? -previous_pivot : previous_pivot;
+	if (det < static_cast<Wide>(std::numeric_limits<Element>::min()) or
+			det > static_cast<Wide>(std::numeric_limits<Element>::max()))
+		throw std::overflow_error("the determinant does not fit in the element type!");
+	return static_cast<Element>(det);
+}
 
-			Element ratio = tmp_table[row_index][col_index] / base_of_column;
-			for (size_t i = col_index; i < number_of_col; i++)
-				tmp_table[row_index][i] -= ratio * tmp_table[col_index][i];
+template <Elementable Element>
+Element Matrix<Element>::modular_determinant() const
+	requires Integrable<Element>
+{
+	return modular_arithmetic::determinant(*this);
+}
+
+template <Elementable Element>
+LUDecomposition<Element> Matrix<Element>::lu_decomposition() const
+{
+	return cache.template get<CachedProperty::lu_decomposition>([this] { return LUDecomposition<Element>(*this); });
+}
+
+template <Elementable Element>
+CholeskyDecomposition<Element> Matrix<Element>::cholesky_decomposition(bool check_symmetric) const
+{
+	return CholeskyDecomposition<Element>(*this, check_symmetric);
+}
+
+template <Elementable Element>
+LDLTDecomposition<Element> Matrix<Element>::ldlt_decomposition(bool check_symmetric) const
+{
+	return LDLTDecomposition<Element>(*this, check_symmetric);
+}
+
+template <Elementable Element>
+MatrixStructure Matrix<Element>::find_structure() const noexcept
+{
+	const auto is_non_zero = [](const Element& element) { return element != 0; };
+	const bool is_square = number_of_row == number_of_col;
+	MatrixStructure result;
+	result.lower_triangular = true;
+	result.upper_triangular = true;
+	result.symmetric = is_square;
+	result.permutation = is_square;
+	result.may_be_positive_definite = is_square and std::floating_point<Element>;
+
+	// every flag is dropped at its first counterexample, and the pass stops once nothing is left to find
+	for (size_t row_index = 0; row_index < number_of_row; ++row_index)
+	{
+		const Element* row = row_data(row_index);
+		const size_t diagonal_index = std::min(row_index, number_of_col);
+		if (result.lower_triangular)
+			result.lower_triangular = std::none_of(row + std::min(row_index + 1, number_of_col), row + number_of_col,
+					is_non_zero);
+		if (result.upper_triangular)
+			result.upper_triangular = std::none_of(row, row + diagonal_index, is_non_zero);
+		for (size_t col_index = 0; result.symmetric and col_index < row_index; ++col_index)
+			result.symmetric = row[col_index] == row_data(col_index)[row_index];
+		if (result.permutation)
+		{
+			const Element* one = std::find_if(row, row + number_of_col, is_non_zero);
+			result.permutation = one != row + number_of_col and *one == Element(1) and
+					std::none_of(one + 1, row + number_of_col, is_non_zero);
 		}
+		if constexpr (std::floating_point<Element>)
+			result.may_be_positive_definite = result.may_be_positive_definite and row[row_index] > 0;
+
+		if (not(result.lower_triangular or result.upper_triangular or result.symmetric or result.permutation))
+			break;
+	}
+	// one 1 in every row, they still have to fall in different columns
+	for (size_t col_index = 0; result.permutation and col_index < number_of_col; ++col_index)
+	{
+		bool found = false;
+		for (size_t row_index = 0; not found and row_index < number_of_row; ++row_index)
+			found = row_data(row_index)[col_index] != 0;
+		result.permutation = found;
 	}
+	result.diagonal = result.lower_triangular and result.upper_triangular;
+	result.may_be_positive_definite = result.may_be_positive_definite and result.symmetric;
+	return result;
+}
 
-	Element det = 1;
-	for (size_t i = 0; i < number_of_row; i++)
-		det *= tmp_table[i][i];
+template <Elementable Element>
+MatrixStructure Matrix<Element>::structure() const noexcept
+{
+	enum : uint8_t
+	{
+		KNOWN = 1 << 0,
+		LOWER_TRIANGULAR = 1 << 1,
+		UPPER_TRIANGULAR = 1 << 2,
+		SYMMETRIC = 1 << 3,
+		PERMUTATION = 1 << 4,
+		MAY_BE_POSITIVE_DEFINITE = 1 << 5,
+	};
+
+	uint8_t bits = structure_cache.load();
+	if (not(bits & KNOWN))
+	{
+		// racing readers find the same structure, so whichever store lands last is right
+		const MatrixStructure found = find_structure();
+		bits = KNOWN | (found.lower_triangular ? LOWER_TRIANGULAR : 0) |
+				(found.upper_triangular ? UPPER_TRIANGULAR : 0) | (found.symmetric ? SYMMETRIC : 0) |
+				(found.permutation ? PERMUTATION : 0) | (found.may_be_positive_definite ? MAY_BE_POSITIVE_DEFINITE : 0);
+		structure_cache.store(bits);
+		return found;
+	}
 
-	if (number_of_swap % 2 == 0)
-		return det;
-	else
-		return -det;
+	MatrixStructure result;
+	result.lower_triangular = bits & LOWER_TRIANGULAR;
+	result.upper_triangular = bits & UPPER_TRIANGULAR;
+	result.diagonal = result.lower_triangular and result.upper_triangular;
+	result.symmetric = bits & SYMMETRIC;
+	result.permutation = bits & PERMUTATION;
+	result.may_be_positive_definite = bits & MAY_BE_POSITIVE_DEFINITE;
+	return result;
+}
+
+template <Elementable Element>
+void Matrix<Element>::invalidate_cache() noexcept
+{
+	structure_cache.store(0);
+	cache.invalidate();
+}
+
+template <Elementable Element>
+std::vector<size_t> Matrix<Element>::permutation_columns() const
+{
+	std::vector<size_t> columns(number_of_row);
+	for (size_t row_index = 0; row_index < number_of_row; ++row_index)
+	{
+		const Element* row = row_data(row_index);
+		columns[row_index] = static_cast<size_t>(std::find(row, row + number_of_col, Element(1)) - row);
+	}
+	return columns;
+}
+
+template <Elementable Element>
+bool Matrix<Element>::is_lower_triangular() const noexcept
+{
+	return structure().lower_triangular;
+}
+
+template <Elementable Element>
+bool Matrix<Element>::is_upper_triangular() const noexcept
+{
+	return structure().upper_triangular;
+}
+
+template <Elementable Element>
+bool Matrix<Element>::is_diagonal() const noexcept
+{
+	return structure().diagonal;
+}
+
+template <Elementable Element>
+bool Matrix<Element>::is_symmetric() const noexcept
+{
+	return structure().symmetric;
+}
+
+template <Elementable Element>
+bool Matrix<Element>::is_permutation() const noexcept
+{
+	return structure().permutation;
+}
+
+template <Elementable Element>
+Matrix<Element> Matrix<Element>::solve(const Matrix& b) const
+{
+	if (number_of_row != number_of_col)
+		throw std::invalid_argument("the matrix should be square!");
+	if (b.number_of_row != number_of_row)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+
+	const MatrixStructure shape = structure();
+	if (shape.diagonal or shape.permutation)
+	{
+		// x[i] = b[i] / A[i][i], or x[j] = b[i] for the 1 of row i in column j
+		const std::vector<size_t> columns = shape.permutation ? permutation_columns() : std::vector<size_t>();
+		Matrix<Element> x(number_of_row, b.number_of_col);
+		const MutableRows x_rows = x.mutable_rows();
+		for (size_t i = 0; i < number_of_row; ++i)
+		{
+			if (shape.permutation)
+				std::copy_n(b.row_data(i), b.number_of_col, x_rows.row_data(columns[i]));
+			else if (row_data(i)[i] == 0)
+				throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+			else
+			{
+				const Element* b_row = b.row_data(i);
+				Element* x_row = x_rows.row_data(i);
+				for (size_t k = 0; k < b.number_of_col; ++k)
+					x_row[k] = b_row[k] / row_data(i)[i];
+			}
+		}
+		return x;
+	}
+
+	const bool is_lower = shape.lower_triangular;
+	if (is_lower or shape.upper_triangular)
+	{
+		for (size_t i = 0; i < number_of_row; ++i)
+		{
+			if (row_data(i)[i] == 0)
+				throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+		}
+
+		Matrix<Element> x = b;
+		const MutableRows x_rows = x.mutable_rows();
+		matrix_helper::parallel_for(x.number_of_col, number_of_row * number_of_row, [&](size_t begin, size_t end)
+		{
+			if (is_lower)
+				matrix_kernel::trsm_lower(number_of_row, end - begin, storage.data(), stride, false,
+						x_rows.row_data(0) + begin, x.stride);
+			else
+				matrix_kernel::trsm_upper(number_of_row, end - begin, storage.data(), stride, false,
+						x_rows.row_data(0) + begin, x.stride);
+		});
+		return x;
+	}
+
+	if constexpr (std::floating_point<Element>)
+	{
+		if (shape.may_be_positive_definite)
+		{
+			const CholeskyDecomposition<Element> cholesky(*this);
+			if (cholesky.is_positive_definite())
+				return cholesky.solve(b);
+		}
+	}
+
+	return lu_decomposition().solve(b);
+}
+
+template <Elementable Element>
+std::vector<Element> Matrix<Element>::solve(const std::vector<Element>& b) const
+{
+	Matrix<Element> column_of_b(b.size(), 1);
+	const MutableRows column_rows = column_of_b.mutable_rows();
+	for (size_t i = 0; i < b.size(); ++i)
+		column_rows.row_data(i)[0] = b[i];
+	return solve(column_of_b).column(0).to_vector();
 }
 
 template <Elementable Element>
 auto Matrix<Element>::get_table() const -> TableType
 {
-	return table;
+	TableType result;
+	result.reserve(number_of_row);
+	for (size_t row_index = 0; row_index < number_of_row; ++row_index)
+	{
+		const Element* row = row_data(row_index);
+		result.emplace_back(row, row + number_of_col);
+	}
+	return result;
 }
 
 template <Elementable Element>
@@ -265,23 +881,30 @@ size_t Matrix<Element>::get_number_of_col() const
 	return number_of_col;
 }
 
+template <Elementable Element>
+size_t Matrix<Element>::get_stride() const noexcept
+{
+	return stride;
+}
+
+template <Elementable Element>
+const Element* Matrix<Element>::get_data() const noexcept
+{
+	return storage.data();
+}
+
 template <Elementable Element>
 template <typename OtherElement>
 bool Matrix<Element>::operator==(const Matrix<OtherElement>& other) const
 {
-	if (this->number_of_col != other.number_of_col or this->number_of_row != other.number_of_row)
-		return false;
-
-	for (size_t i = 0; i < number_of_row; ++i)
-	{
-		for (int j = 0; j < number_of_col; ++j)
-		{
-			if (this->table[i][j] != other.table[i][j])
-				return false;
-		}
-	}
+	return view() == other.view();
+}
 
-	return true;
+template <Elementable Element>
+template <typename OtherElement>
+bool Matrix<Element>::operator==(const MatrixView<OtherElement>& other) const
+{
+	return view() == other;
 }
 
 template <Elementable Element>
@@ -301,12 +924,13 @@ std::string Matrix<Element>::to_string() const noexcept
 	const std::string END_OF_TABLE = NEW_LINE + CLOSE_ACCOLADE;
 
 	std::string result = START_OF_TABLE;
-	for (const auto& row_of_table : table)
+	for (size_t row_index = 0; row_index < number_of_row; ++row_index)
 	{
 		result += START_OF_ROW;
 
-		for (const auto& elem : row_of_table)
-			result += std::to_string(elem) + SEPARATE_COLUMN;
+		const Element* row_of_table = row_data(row_index);
+		for (size_t col_index = 0; col_index < number_of_col; ++col_index)
+			result += matrix_helper::element_to_string(row_of_table[col_index]) + SEPARATE_COLUMN;
 
 		result.erase(result.end() - 2);
 		result += END_OF_ROW;
@@ -332,23 +956,66 @@ std::ostream& operator<<(std::ostream& os, const Matrix<Element>& matrix)
 template <Elementable Element>
 Matrix<Element> Matrix<Element>::transpose() const noexcept
 {
-	TableType ans_table(number_of_col, RowType(number_of_row));
-	for (int i = 0; i < number_of_row; ++i)
-		for (int j = 0; j < number_of_col; ++j)
-			ans_table[j][i] = table[i][j];
-	return Matrix<Element>(ans_table);
+	constexpr size_t BLOCK_SIZE = 32;
+
+	Matrix<Element> result(number_of_col, number_of_row);
+	const MutableRows result_rows = result.mutable_rows();
+	const size_t number_of_row_block = (number_of_row + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	// blocks keep both the rows read and the rows written in cache
+	matrix_helper::parallel_for(number_of_row_block, BLOCK_SIZE * number_of_col, [&](size_t begin, size_t end)
+	{
+		for (size_t row_block = begin * BLOCK_SIZE; row_block < std::min(end * BLOCK_SIZE, number_of_row);
+				row_block += BLOCK_SIZE)
+		{
+			for (size_t col_block = 0; col_block < number_of_col; col_block += BLOCK_SIZE)
+			{
+				for (size_t i = row_block; i < std::min(row_block + BLOCK_SIZE, number_of_row); ++i)
+				{
+					const Element* row_of_table = row_data(i);
+					for (size_t j = col_block; j < std::min(col_block + BLOCK_SIZE, number_of_col); ++j)
+						result_rows.row_data(j)[i] = row_of_table[j];
+				}
+			}
+		}
+	});
+	return result;
 }
 
 template <Elementable Element>
 Matrix<Element> Matrix<Element>::inverse() const
+{
+	return cache.template get<CachedProperty::inverse>([this] { return compute_inverse(); });
+}
+
+template <Elementable Element>
+Matrix<Element> Matrix<Element>::compute_inverse() const
 {
 	if (number_of_row != number_of_col)
 		throw std::invalid_argument("the matrix should be square!");
 
-	TableType gauss_table = table;
-	TableType inverse_table(number_of_row, RowType(number_of_col, Element()));
-	for (size_t i : std::views::iota(0LLU, number_of_col))
-		inverse_table[i][i] = Element(1);
+	const MatrixStructure shape = structure();
+	if (shape.permutation)
+		return transpose();
+	// a triangular inverse is one substitution per column of I; integer elements keep the exact elimination below
+	if (shape.diagonal or (not Integrable<Element> and (shape.lower_triangular or shape.upper_triangular)))
+		return solve(create_i_matrix(number_of_row));
+
+	if constexpr (std::floating_point<Element>)
+	{
+		if (shape.may_be_positive_definite)
+		{
+			const CholeskyDecomposition<Element> cholesky(*this);
+			if (cholesky.is_positive_definite())
+				return cholesky.inverse();
+		}
+	}
+	if constexpr (not Integrable<Element>)
+		return lu_decomposition().inverse();
+
+	Matrix<Element> gauss_table = *this;
+	Matrix<Element> inverse_table = create_i_matrix(number_of_col);
+	const MutableRows gauss_rows = gauss_table.mutable_rows();
+	const MutableRows inverse_rows = inverse_table.mutable_rows();
 
 	for (size_t col_index : std::views::iota(0LLU, number_of_col))
 	{
@@ -368,34 +1035,37 @@ Matrix<Element> Matrix<Element>::inverse() const
 		{
 			throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
 		}
-		std::swap(gauss_table.at(col_index), gauss_table.at(non_zero_row_index));
-		std::swap(inverse_table.at(col_index), inverse_table.at(non_zero_row_index));
+		gauss_table.swap_rows(col_index, non_zero_row_index);
+		inverse_table.swap_rows(col_index, non_zero_row_index);
 
 		const size_t SELECTED_ROW_INDEX = col_index;
-		const RowType& SELECTED_GAUSS_ROW = gauss_table[SELECTED_ROW_INDEX];
-		const RowType& SELECTED_INVERSE_ROW = inverse_table[SELECTED_ROW_INDEX];
+		const Element* SELECTED_GAUSS_ROW = gauss_table.row_data(SELECTED_ROW_INDEX);
+		const Element* SELECTED_INVERSE_ROW = inverse_table.row_data(SELECTED_ROW_INDEX);
 
 		// update other row
-		for (size_t row_index : std::views::iota(0LLU, number_of_col) |
-						std::views::filter([col_index](size_t i) { return i != col_index; }))
+		matrix_helper::parallel_for(number_of_row, 2 * number_of_col, [&](size_t begin, size_t end)
 		{
-			RowType& current_gauss_row = gauss_table[row_index];
-			RowType& current_inverse_row = inverse_table[row_index];
-			Element coefficient = -current_gauss_row[col_index] / SELECTED_GAUSS_ROW[col_index];
-
-			if (coefficient == 0)
-				continue;
-
-			for (size_t i : std::views::iota(0LLU, number_of_col))
+			for (size_t row_index : std::views::iota(begin, end) |
+							std::views::filter([col_index](size_t i) { return i != col_index; }))
 			{
-				current_gauss_row[i] += coefficient * SELECTED_GAUSS_ROW[i];
-				current_inverse_row[i] += coefficient * SELECTED_INVERSE_ROW[i];
+				Element* current_gauss_row = gauss_rows.row_data(row_index);
+				Element* current_inverse_row = inverse_rows.row_data(row_index);
+				Element coefficient = -current_gauss_row[col_index] / SELECTED_GAUSS_ROW[col_index];
+
+				if (coefficient == 0)
+					continue;
+
+				for (size_t i : std::views::iota(0LLU, number_of_col))
+				{
+					current_gauss_row[i] += coefficient * SELECTED_GAUSS_ROW[i];
+					current_inverse_row[i] += coefficient * SELECTED_INVERSE_ROW[i];
+				}
 			}
-		}
+		});
 
 		// update selected row
-		RowType& selected_gauss_row = gauss_table[SELECTED_ROW_INDEX];
-		RowType& selected_inverse_row = inverse_table[SELECTED_ROW_INDEX];
+		Element* selected_gauss_row = gauss_rows.row_data(SELECTED_ROW_INDEX);
+		Element* selected_inverse_row = inverse_rows.row_data(SELECTED_ROW_INDEX);
 		Element coefficient = 1 / selected_gauss_row[col_index];
 		for (size_t i : std::views::iota(0LLU, number_of_col))
 		{
@@ -404,7 +1074,7 @@ Matrix<Element> Matrix<Element>::inverse() const
 		}
 	}
 
-	return Matrix<Element>(inverse_table);
+	return inverse_table;
 }
 
 template <Elementable Element>
@@ -413,46 +1083,374 @@ Element Matrix<Element>::tr() const
 	if (number_of_col != number_of_row)
 		throw std::invalid_argument("Matrix<Element>::tr: column and number_of_row must be equal");
 
-	Element result = Element(0);
-	for (size_t i : std::views::iota(0LLU, number_of_col))
-		result += table[i][i];
+	return cache.template get<CachedProperty::trace>([this]
+	{
+		return matrix_kernel::strided_sum(number_of_col, storage.data(), stride + 1);
+	});
+}
 
-	return result;
+template <Elementable Element>
+Matrix<Element> Matrix<Element>::power(uint64_t exponent, MatrixPowerMethod method) const
+{
+	if (number_of_row != number_of_col)
+		throw std::invalid_argument("the matrix should be square!");
+
+	const size_t size = number_of_row;
+	Matrix<Element> result(size, size);
+	Matrix<Element> scratch(size, size);
+	// scratch = left * right, then the two swap so no product allocates
+	const auto multiply_into_scratch = [&scratch, size](const Matrix<Element>& left, const Matrix<Element>& right)
+	{
+		scratch.invalidate_cache();
+		std::fill(scratch.storage.begin(), scratch.storage.end(), Element(0));
+		matrix_kernel::gemm(size, size, size, left.storage.data(), left.stride, right.storage.data(), right.stride,
+				scratch.storage.data(), scratch.stride);
+	};
+
+	if (method == MatrixPowerMethod::characteristic_polynomial and size > 0)
+	{
+		if constexpr (Polynomialable<Element>)
+		{
+			// A^n = r(A) with r = x^n mod p, since p(A) = 0
+			const Polynomial<Element> x(std::vector<Element>{Element(0), Element(1)});
+			const Polynomial<Element> remainder = x.power_modulo(exponent, characteristic_polynomial());
+
+			// Horner: r(A) = (...(r_(size-1) * A + r_(size-2) * I) * A + ...) + r_0 * I
+			for (size_t i = 0; i < size; ++i)
+				result.mutable_rows()[i][i] = remainder[size - 1];
+			for (size_t degree = size - 1; degree-- > 0;)
+			{
+				multiply_into_scratch(result, *this);
+				std::swap(result, scratch);
+				const MutableRows result_rows = result.mutable_rows();
+				for (size_t i = 0; i < size; ++i)
+					result_rows[i][i] += remainder[degree];
+			}
+			return result;
+		}
+		else
+			throw std::invalid_argument("the element type has no characteristic polynomial!");
+	}
+
+	const MutableRows result_rows = result.mutable_rows();
+	for (size_t i = 0; i < size; ++i)
+		result_rows[i][i] = 1;
+	if (exponent == 0)
+		return result;
+
+	// the lowest set bit starts the result as a copy of the current square instead of a product with I
+	Matrix<Element> square = *this;
+	bool result_is_identity = true;
+	while (true)
+	{
+		if (exponent & 1)
+		{
+			if (result_is_identity)
+				result = square;
+			else
+			{
+				multiply_into_scratch(result, square);
+				std::swap(result, scratch);
+			}
+			result_is_identity = false;
+		}
+
+		exponent >>= 1;
+		if (exponent == 0)
+			return result;
+
+		multiply_into_scratch(square, square);
+		std::swap(square, scratch);
+	}
 }
 
 template <Elementable Element>
-Polynomial<Element> Matrix<Element>::characteristic_polynomial() const
+Matrix<Element> Matrix<Element>::expm() const
+	requires std::floating_point<Element>
 {
 	if (number_of_row != number_of_col)
 		throw std::invalid_argument("the matrix should be square!");
 
-	Matrix<Element> I = Matrix<Element>::create_i_matrix(number_of_col);
+	// Higham 2005: the [m/m] Pade approximant p(A) / p(-A) is accurate to the unit roundoff of double while
+	// ||A||_1 <= THETA[m]; past THETA_13 the matrix is scaled by 2^-s and the result squared s times. For float the
+	// same paper stops at m = 7 with the larger single precision thresholds; long double keeps those of double, so it
+	// is only as accurate as double
+	static constexpr std::array<double, 4> THETA = {1.495585217958292e-2, 2.539398330063230e-1,
+			9.504178996162932e-1, 2.097847961257068e0};
+	static constexpr double THETA_13 = 5.371920351148152e0;
+	static constexpr std::array<double, 2> SINGLE_THETA = {4.258730016922831e-1, 1.880152677804762e0};
+	static constexpr double SINGLE_THETA_7 = 3.925724783138660e0;
+	constexpr bool IS_SINGLE = std::numeric_limits<Element>::digits <= std::numeric_limits<float>::digits;
+	static constexpr std::array<std::array<double, 10>, 4> LOW_DEGREE_COEFFICIENTS = {{
+			{120, 60, 12, 1},
+			{30240, 15120, 3360, 420, 30, 1},
+			{17297280, 8648640, 1995840, 277200, 25200, 1512, 56, 1},
+			{17643225600, 8821612800, 2075673600, 302702400, 30270240, 2162160, 110880, 3960, 90, 1},
+	}};
+
+	const size_t size = number_of_row;
+	const auto add_to_diagonal = [size](Matrix<Element>& matrix, Element value)
+	{
+		const MutableRows rows = matrix.mutable_rows();
+		for (size_t i = 0; i < size; ++i)
+			rows[i][i] += value;
+	};
+	// p(A) = V + U and p(-A) = V - U with U odd and V even in A
+	const auto pade = [](const Matrix<Element>& U, const Matrix<Element>& V)
+	{
+		return LUDecomposition<Element>(Matrix<Element>(V - U)).solve(Matrix<Element>(V + U));
+	};
+	// [m/m] with m = 2 * index + 3
+	const auto low_degree_pade = [&](const Matrix<Element>& A, size_t index)
+	{
+		const std::array<double, 10>& b = LOW_DEGREE_COEFFICIENTS[index];
+		const Matrix<Element> A2 = A * A;
+		Matrix<Element> even_power = A2;
+		Matrix<Element> odd(size, size);
+		Matrix<Element> V(size, size);
+		add_to_diagonal(odd, static_cast<Element>(b[1]));
+		add_to_diagonal(V, static_cast<Element>(b[0]));
+		for (size_t degree = 2; degree <= 2 * index + 3; degree += 2)
+		{
+			if (degree > 2)
+				even_power = even_power * A2;
+			odd += static_cast<Element>(b[degree + 1]) * even_power;
+			V += static_cast<Element>(b[degree]) * even_power;
+		}
+		return pade(Matrix<Element>(A * odd), V);
+	};
+
+	const Element norm = one_norm();
+	const std::span<const double> thresholds = IS_SINGLE ? std::span<const double>(SINGLE_THETA) : THETA;
+	for (size_t index = 0; index < thresholds.size(); ++index)
+	{
+		if (norm <= thresholds[index])
+			return low_degree_pade(*this, index);
+	}
 
-	const Matrix<Element> A = *this;
-	Matrix<Element> B = A;
-	Element a = B.tr();
+	int exponent = 0;
+	std::frexp(norm / static_cast<Element>(IS_SINGLE ? SINGLE_THETA_7 : THETA_13), &exponent);
+	size_t number_of_squaring = static_cast<size_t>(std::max(exponent, 0));
+	const Matrix<Element> A = *this * std::ldexp(Element(1), -static_cast<int>(number_of_squaring));
 
-	std::vector<Element> characteristic_polynomial(number_of_col + 1);
-	if (number_of_col % 2 == 0)
-		characteristic_polynomial[number_of_col] = -1;
+	Matrix<Element> result;
+	if constexpr (IS_SINGLE)
+		result = low_degree_pade(A, 2);
 	else
-		characteristic_polynomial[number_of_col] = 1;
+	{
+		static constexpr std::array<double, 14> COEFFICIENTS = {64764752532480000, 32382376266240000,
+				7771770303897600, 1187353796428800, 129060195264000, 10559470521600, 670442572800, 33522128640,
+				1323241920, 40840800, 960960, 16380, 182, 1};
+		const auto b = [](size_t index) { return static_cast<Element>(COEFFICIENTS[index]); };
+		const Matrix<Element> A2 = A * A;
+		const Matrix<Element> A4 = A2 * A2;
+		const Matrix<Element> A6 = A4 * A2;
+		Matrix<Element> high = b(13) * A6 + b(11) * A4 + b(9) * A2;
+		Matrix<Element> odd = A6 * high + b(7) * A6 + b(5) * A4 + b(3) * A2;
+		add_to_diagonal(odd, b(1));
+		high = b(12) * A6 + b(10) * A4 + b(8) * A2;
+		Matrix<Element> V = A6 * high + b(6) * A6 + b(4) * A4 + b(2) * A2;
+		add_to_diagonal(V, b(0));
+		result = pade(Matrix<Element>(A * odd), V);
+	}
+	// power squares in place, 63 times at most per call
+	while (number_of_squaring > 0)
+	{
+		const size_t step = std::min<size_t>(number_of_squaring, 63);
+		result = result.power(uint64_t(1) << step);
+		number_of_squaring -= step;
+	}
+	return result;
+}
 
-	characteristic_polynomial[number_of_col - 1] = a;
-	for (size_t i : std::views::iota(2LLU, number_of_col + 1))
+template <Elementable Element>
+std::vector<Element> Matrix<Element>::expm_multiply(const std::vector<Element>& v, Element t) const
+	requires std::floating_point<Element>
+{
+	if (number_of_row != number_of_col)
+		throw std::invalid_argument("the matrix should be square!");
+	if (v.size() != number_of_row)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+
+	// Al-Mohy and Higham 2011: e^(t * A) * v = e^(t * mu) * (T_m(t * B / s))^s * v with B = A - mu * I and T_m the
+	// Taylor polynomial of degree m, which is accurate to the unit roundoff while ||t * B / s||_1 <= THETA[m]; (m, s)
+	// minimize the m * s products. The paper gives the thresholds for double and for single precision, long double
+	// uses those of double and is only as accurate as double
+	static constexpr std::array<std::pair<size_t, double>, 35> THETA = {{
+			{1, 2.29e-16}, {2, 2.58e-8}, {3, 1.39e-5}, {4, 3.40e-4}, {5, 2.40e-3}, {6, 9.07e-3}, {7, 2.38e-2},
+			{8, 5.00e-2}, {9, 8.96e-2}, {10, 1.44e-1}, {11, 2.14e-1}, {12, 3.00e-1}, {13, 4.00e-1}, {14, 5.14e-1},
+			{15, 6.41e-1}, {16, 7.81e-1}, {17, 9.31e-1}, {18, 1.09}, {19, 1.26}, {20, 1.44}, {21, 1.62}, {22, 1.82},
+			{23, 2.01}, {24, 2.22}, {25, 2.43}, {26, 2.64}, {27, 2.86}, {28, 3.08}, {29, 3.31}, {30, 3.54},
+			{35, 4.7}, {40, 6.0}, {45, 7.2}, {50, 8.5}, {55, 9.9},
+	}};
+	static constexpr std::array<std::pair<size_t, double>, 35> SINGLE_THETA = {{
+			{1, 1.19e-7}, {2, 5.97e-4}, {3, 1.12e-2}, {4, 5.11e-2}, {5, 1.30e-1}, {6, 2.49e-1}, {7, 4.01e-1},
+			{8, 5.80e-1}, {9, 7.81e-1}, {10, 9.98e-1}, {11, 1.23}, {12, 1.47}, {13, 1.72}, {14, 1.97}, {15, 2.23},
+			{16, 2.48}, {17, 2.75}, {18, 3.01}, {19, 3.27}, {20, 3.53}, {21, 3.80}, {22, 4.06}, {23, 4.33},
+			{24, 4.60}, {25, 4.87}, {26, 5.14}, {27, 5.41}, {28, 5.68}, {29, 5.95}, {30, 6.22}, {35, 7.59},
+			{40, 8.99}, {45, 10.4}, {50, 11.8}, {55, 13.3},
+	}};
+	constexpr bool IS_SINGLE = std::numeric_limits<Element>::digits <= std::numeric_limits<float>::digits;
+
+	const size_t size = number_of_row;
+	if (size == 0)
+		return v;
+
+	const Element mu = tr() / static_cast<Element>(size);
+	const Element norm = std::abs(t) * one_norm(mu);
+	size_t degree = 0;
+	// a counter in Element would stop advancing past 2^24 steps for float
+	size_t number_of_step = 1;
+	if (norm > 0)
+	{
+		Element best_cost = std::numeric_limits<Element>::infinity();
+		for (const auto& [m, theta] : IS_SINGLE ? SINGLE_THETA : THETA)
+		{
+			const Element steps = std::max(Element(1), std::ceil(norm / static_cast<Element>(theta)));
+			if (steps * static_cast<Element>(m) < best_cost)
+			{
+				best_cost = steps * static_cast<Element>(m);
+				degree = m;
+				number_of_step = static_cast<size_t>(steps);
+			}
+		}
+	}
+
+	const auto infinity_norm = [](const std::vector<Element>& x)
+	{
+		Element result = 0;
+		for (const Element value : x)
+			result = std::max(result, std::abs(value));
+		return result;
+	};
+
+	const Element tolerance = std::numeric_limits<Element>::epsilon();
+	const Element step_size = t / static_cast<Element>(number_of_step);
+	const Element eta = std::exp(step_size * mu);
+	std::vector<Element> result = v;
+	std::vector<Element> term = v;
+	std::vector<Element> product(size);
+	for (size_t step = 0; step < number_of_step; ++step)
 	{
-		B = A * (B - a * I);
-		a = B.tr() / i;
-		characteristic_polynomial[number_of_col - i] = a;
+		// the series stops early once two consecutive terms are negligible
+		Element previous_term_norm = infinity_norm(term);
+		for (size_t j = 1; j <= degree; ++j)
+		{
+			multiply(term.data(), product.data());
+			matrix_kernel::axpy(size, -mu, term.data(), product.data());
+			matrix_kernel::scale(size, product.data(), step_size / static_cast<Element>(j), term.data());
+			matrix_kernel::axpy(size, Element(1), term.data(), result.data());
+
+			const Element term_norm = infinity_norm(term);
+			if (previous_term_norm + term_norm <= tolerance * infinity_norm(result))
+				break;
+			previous_term_norm = term_norm;
+		}
+		matrix_kernel::scale(size, result.data(), eta, result.data());
+		term = result;
 	}
+	return result;
+}
 
-	return Polynomial(characteristic_polynomial);
+template <Elementable Element>
+auto Matrix<Element>::characteristic_polynomial() const
+	requires Polynomialable<Element>
+{
+	return cache.template get<CachedProperty::characteristic_polynomial>(
+			[this] { return compute_characteristic_polynomial(); });
+}
+
+template <Elementable Element>
+auto Matrix<Element>::compute_characteristic_polynomial() const
+	requires Polynomialable<Element>
+{
+	if (number_of_row != number_of_col)
+		throw std::invalid_argument("the matrix should be square!");
+
+	// Householder needs square roots; other elements keep Faddeev-LeVerrier, whose divisions are exact for integers
+	if constexpr (std::floating_point<Element>)
+		return Polynomial<Element>(HessenbergDecomposition<Element>(*this).characteristic_coefficients());
+	else
+	{
+		Matrix<Element> I = Matrix<Element>::create_i_matrix(number_of_col);
+
+		const Matrix<Element> A = *this;
+		Matrix<Element> B = A;
+		Element a = B.tr();
+
+		// det(A - x * I) = (-1)^n * (x^n - a_1 * x^(n-1) - ... - a_n)
+		const Element sign = number_of_col % 2 == 0 ? 1 : -1;
+		std::vector<Element> characteristic_polynomial(number_of_col + 1);
+		characteristic_polynomial[number_of_col] = sign;
+		characteristic_polynomial[number_of_col - 1] = -sign * a;
+		for (size_t i : std::views::iota(2LLU, number_of_col + 1))
+		{
+			B = A * (B - a * I);
+			a = B.tr() / i;
+			characteristic_polynomial[number_of_col - i] = -sign * a;
+		}
+
+		return Polynomial<Element>(characteristic_polynomial);
+	}
 }
 
 template <Elementable Element>
 std::vector<Element> Matrix<Element>::eigenvalues() const
 {
-	Polynomial<Element> characteristic = this->characteristic_polynomial();
-	return characteristic.solve();
+	if constexpr (std::floating_point<Element>)
+	{
+		if (is_symmetric())
+			return symmetric_eigen(false).get_eigenvalues();
+		return eigen_decomposition().get_real_eigenvalues();
+	}
+	else
+	{
+		Polynomial<Element> characteristic = this->characteristic_polynomial();
+		return characteristic.solve();
+	}
+}
+
+template <Elementable Element>
+EigenDecomposition<Element> Matrix<Element>::eigen_decomposition(bool compute_eigenvectors) const
+{
+	return EigenDecomposition<Element>(*this, compute_eigenvectors);
+}
+
+template <Elementable Element>
+SymmetricEigenDecomposition<Element> Matrix<Element>::symmetric_eigen(bool compute_eigenvectors) const
+{
+	return SymmetricEigenDecomposition<Element>(*this, compute_eigenvectors);
+}
+
+template <Elementable Element>
+PartialEigenDecomposition<Element> Matrix<Element>::top_eigenpairs(size_t k, EigenSolverMethod method) const
+{
+	if (number_of_row != number_of_col)
+		throw std::invalid_argument("the matrix should be square!");
+
+	return PartialEigenDecomposition<Element>(*this, number_of_row, k, is_symmetric(), method);
+}
+
+template <Elementable Element>
+void Matrix<Element>::multiply(const Element* x, Element* y) const
+{
+	matrix_helper::parallel_for(number_of_row, number_of_col, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = begin; row_index < end; ++row_index)
+			y[row_index] = matrix_kernel::dot(number_of_col, row_data(row_index), x);
+	});
+}
+
+template <Elementable Element>
+Element Matrix<Element>::one_norm(Element shift) const
+{
+	std::vector<Element> col_sum(number_of_col, Element(0));
+	for (size_t row_index = 0; row_index < number_of_row; ++row_index)
+	{
+		const Element* row = row_data(row_index);
+		for (size_t col_index = 0; col_index < number_of_col; ++col_index)
+			col_sum[col_index] += std::abs(row_index == col_index ? row[col_index] - shift : row[col_index]);
+	}
+	return col_sum.empty() ? Element(0) : *std::max_element(col_sum.begin(), col_sum.end());
 }
 #endif
@@ -0,0 +1,277 @@
+#ifndef MATRIX_MATRIX_VIEW_TMP_H
+#define MATRIX_MATRIX_VIEW_TMP_H
+
+#include <stdexcept>
+
+#include "matrix-view.h"
+
+template <typename Element>
+ColumnView<Element>::Iterator::Iterator(Element* data, size_t index, size_t stride) noexcept
+: data(data)
+, index(static_cast<difference_type>(index))
+, stride(stride)
+{
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator*() const noexcept -> reference
+{
+	return data[static_cast<size_t>(index) * stride];
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator[](difference_type offset) const noexcept -> reference
+{
+	return *(*this + offset);
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator++() noexcept -> Iterator&
+{
+	++index;
+	return *this;
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator++(int) noexcept -> Iterator
+{
+	Iterator tmp = *this;
+	++*this;
+	return tmp;
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator--() noexcept -> Iterator&
+{
+	--index;
+	return *this;
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator--(int) noexcept -> Iterator
+{
+	Iterator tmp = *this;
+	--*this;
+	return tmp;
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator+=(difference_type offset) noexcept -> Iterator&
+{
+	index += offset;
+	return *this;
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator-=(difference_type offset) noexcept -> Iterator&
+{
+	index -= offset;
+	return *this;
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator+(difference_type offset) const noexcept -> Iterator
+{
+	Iterator tmp = *this;
+	tmp += offset;
+	return tmp;
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator-(difference_type offset) const noexcept -> Iterator
+{
+	Iterator tmp = *this;
+	tmp -= offset;
+	return tmp;
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator-(const Iterator& other) const noexcept -> difference_type
+{
+	return index - other.index;
+}
+
+template <typename Element>
+bool ColumnView<Element>::Iterator::operator==(const Iterator& other) const noexcept
+{
+	return data == other.data and index == other.index;
+}
+
+template <typename Element>
+auto ColumnView<Element>::Iterator::operator<=>(const Iterator& other) const noexcept
+{
+	return index <=> other.index;
+}
+
+template <typename Element>
+ColumnView<Element>::ColumnView(Element* data, size_t size, size_t stride) noexcept
+: data(data)
+, number_of_element(size)
+, stride(stride)
+{
+}
+
+template <typename Element>
+template <typename OtherElement>
+	requires std::is_convertible_v<OtherElement (*)[], Element (*)[]>
+ColumnView<Element>::ColumnView(const ColumnView<OtherElement>& other) noexcept
+: data(other.get_data())
+, number_of_element(other.size())
+, stride(other.get_stride())
+{
+}
+
+template <typename Element>
+size_t ColumnView<Element>::size() const noexcept
+{
+	return number_of_element;
+}
+
+template <typename Element>
+size_t ColumnView<Element>::get_stride() const noexcept
+{
+	return stride;
+}
+
+template <typename Element>
+Element* ColumnView<Element>::get_data() const noexcept
+{
+	return data;
+}
+
+template <typename Element>
+Element& ColumnView<Element>::operator[](size_t idx) const noexcept
+{
+	return data[idx * stride];
+}
+
+template <typename Element>
+auto ColumnView<Element>::begin() const noexcept -> Iterator
+{
+	return Iterator(data, 0, stride);
+}
+
+template <typename Element>
+auto ColumnView<Element>::end() const noexcept -> Iterator
+{
+	return Iterator(data, number_of_element, stride);
+}
+
+template <typename Element>
+std::vector<std::remove_const_t<Element>> ColumnView<Element>::to_vector() const
+{
+	return std::vector<std::remove_const_t<Element>>(begin(), end());
+}
+
+template <typename Element>
+MatrixView<Element>::MatrixView(Element* data, size_t row, size_t col, size_t stride) noexcept
+: data(data)
+, number_of_row(row)
+, number_of_col(col)
+, stride(stride)
+{
+}
+
+template <typename Element>
+template <typename OtherElement>
+	requires std::is_convertible_v<OtherElement (*)[], Element (*)[]>
+MatrixView<Element>::MatrixView(const MatrixView<OtherElement>& other) noexcept
+: data(other.get_data())
+, number_of_row(other.get_number_of_row())
+, number_of_col(other.get_number_of_col())
+, stride(other.get_stride())
+{
+}
+
+template <typename Element>
+auto MatrixView<Element>::get_table() const -> TableType
+{
+	TableType result;
+	result.reserve(number_of_row);
+	for (size_t row_index = 0; row_index < number_of_row; ++row_index)
+	{
+		const RowView<Element> current_row = (*this)[row_index];
+		result.emplace_back(current_row.begin(), current_row.end());
+	}
+	return result;
+}
+
+template <typename Element>
+size_t MatrixView<Element>::get_number_of_row() const
+{
+	return number_of_row;
+}
+
+template <typename Element>
+size_t MatrixView<Element>::get_number_of_col() const
+{
+	return number_of_col;
+}
+
+template <typename Element>
+size_t MatrixView<Element>::get_stride() const noexcept
+{
+	return stride;
+}
+
+template <typename Element>
+Element* MatrixView<Element>::get_data() const noexcept
+{
+	return data;
+}
+
+template <typename Element>
+RowView<Element> MatrixView<Element>::operator[](size_t idx) const noexcept
+{
+	return RowView<Element>(data + idx * stride, number_of_col);
+}
+
+template <typename Element>
+RowView<Element> MatrixView<Element>::row(size_t idx) const
+{
+	if (idx >= number_of_row)
+		throw std::out_of_range("MatrixView<Element>::row: index out of range");
+
+	return (*this)[idx];
+}
+
+template <typename Element>
+ColumnView<Element> MatrixView<Element>::column(size_t idx) const
+{
+	if (idx >= number_of_col)
+		throw std::out_of_range("MatrixView<Element>::column: index out of range");
+
+	return ColumnView<Element>(data + idx, number_of_row, stride);
+}
+
+template <typename Element>
+MatrixView<Element> MatrixView<Element>::sub_matrix(size_t first_row, size_t first_col, size_t row, size_t col) const
+{
+	if (first_row + row > number_of_row or first_col + col > number_of_col)
+		throw std::out_of_range("MatrixView<Element>::sub_matrix: sub matrix is out of range");
+
+	return MatrixView(data + first_row * stride + first_col, row, col, stride);
+}
+
+template <typename Element>
+template <typename OtherElement>
+bool MatrixView<Element>::operator==(const MatrixView<OtherElement>& other) const
+{
+	if (number_of_row != other.get_number_of_row() or number_of_col != other.get_number_of_col())
+		return false;
+
+	for (size_t i = 0; i < number_of_row; ++i)
+	{
+		const RowView<Element> row_of_view = (*this)[i];
+		const RowView<OtherElement> row_of_other = other[i];
+		for (size_t j = 0; j < number_of_col; ++j)
+		{
+			if (row_of_view[j] != row_of_other[j])
+				return false;
+		}
+	}
+
+	return true;
+}
+
+#endif
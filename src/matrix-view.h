@@ -0,0 +1,119 @@
+#ifndef MATRIX_MATRIX_VIEW_H
+#define MATRIX_MATRIX_VIEW_H
+
+#include <cstddef>
+
+#include <iterator>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+template <typename Element>
+using RowView = std::span<Element>;
+
+template <typename Element>
+class ColumnView
+{
+public:
+	class Iterator
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::remove_const_t<Element>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Element*;
+		using reference = Element&;
+
+		Iterator() = default;
+		Iterator(Element* data, size_t index, size_t stride) noexcept;
+
+		reference operator*() const noexcept;
+		reference operator[](difference_type offset) const noexcept;
+
+		Iterator& operator++() noexcept;
+		Iterator operator++(int) noexcept;
+		Iterator& operator--() noexcept;
+		Iterator operator--(int) noexcept;
+		Iterator& operator+=(difference_type offset) noexcept;
+		Iterator& operator-=(difference_type offset) noexcept;
+		Iterator operator+(difference_type offset) const noexcept;
+		Iterator operator-(difference_type offset) const noexcept;
+		difference_type operator-(const Iterator& other) const noexcept;
+
+		bool operator==(const Iterator& other) const noexcept;
+		auto operator<=>(const Iterator& other) const noexcept;
+
+		friend Iterator operator+(difference_type offset, const Iterator& iterator) noexcept
+		{
+			return iterator + offset;
+		}
+
+	private:
+		// the position is an index from the first element, so end() never forms a pointer past the column
+		Element* data = nullptr;
+		difference_type index = 0;
+		size_t stride = 1;
+	};
+
+	ColumnView(Element* data, size_t size, size_t stride) noexcept;
+
+	template <typename OtherElement>
+		requires std::is_convertible_v<OtherElement (*)[], Element (*)[]>
+	ColumnView(const ColumnView<OtherElement>& other) noexcept;
+
+	[[nodiscard]] size_t size() const noexcept;
+	[[nodiscard]] size_t get_stride() const noexcept;
+	[[nodiscard]] Element* get_data() const noexcept;
+
+	Element& operator[](size_t idx) const noexcept;
+
+	[[nodiscard]] Iterator begin() const noexcept;
+	[[nodiscard]] Iterator end() const noexcept;
+
+	[[nodiscard]] std::vector<std::remove_const_t<Element>> to_vector() const;
+
+private:
+	Element* data;
+	size_t number_of_element;
+	size_t stride;
+};
+
+template <typename Element>
+class MatrixView
+{
+private:
+	typedef std::vector<std::remove_const_t<Element>> RowType;
+	typedef std::vector<RowType> TableType;
+
+public:
+	MatrixView(Element* data, size_t row, size_t col, size_t stride) noexcept;
+
+	template <typename OtherElement>
+		requires std::is_convertible_v<OtherElement (*)[], Element (*)[]>
+	MatrixView(const MatrixView<OtherElement>& other) noexcept;
+
+	[[nodiscard]] TableType get_table() const;
+	[[nodiscard]] size_t get_number_of_row() const;
+	[[nodiscard]] size_t get_number_of_col() const;
+	[[nodiscard]] size_t get_stride() const noexcept;
+	[[nodiscard]] Element* get_data() const noexcept;
+
+	RowView<Element> operator[](size_t idx) const noexcept;
+	[[nodiscard]] RowView<Element> row(size_t idx) const;
+	[[nodiscard]] ColumnView<Element> column(size_t idx) const;
+	[[nodiscard]] MatrixView sub_matrix(size_t first_row, size_t first_col, size_t row, size_t col) const;
+
+	template <typename OtherElement>
+	bool operator==(const MatrixView<OtherElement>& other) const;
+
+private:
+	Element* data;
+	size_t number_of_row;
+	size_t number_of_col;
+	size_t stride;
+};
+
+#include "matrix-view-tmp.h"
+
+#endif
@@ -5,14 +5,84 @@
 #include <vector>
 
 #include "concept.h"
+#include "matrix-cache.h"
+#include "matrix-expression.h"
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+#include "matrix-view.h"
 #include "polynomial.h"
 
+template <Elementable Element>
+class LUDecomposition;
+
+template <Elementable Element>
+class CholeskyDecomposition;
+
+template <Elementable Element>
+class LDLTDecomposition;
+
+template <Elementable Element>
+class HessenbergDecomposition;
+
+template <Elementable Element>
+class EigenDecomposition;
+
+template <Elementable Element>
+class SymmetricEigenDecomposition;
+
+template <Elementable Element>
+class PartialEigenDecomposition;
+
+template <Elementable Element>
+class SparseMatrix;
+
+template <Elementable Element>
+class SparseDirectSolver;
+
+template <Elementable Element>
+class TriangularMatrix;
+
+template <Elementable Element>
+class SymmetricMatrix;
+
+template <Elementable Element>
+class BandedMatrix;
+
+// restarted Krylov iteration (Lanczos for symmetric operators, Arnoldi otherwise) or block power iteration
+enum class EigenSolverMethod
+{
+	krylov,
+	subspace_iteration,
+};
+
+// repeated squaring takes O(log n) products; reducing x^n modulo the characteristic polynomial first (Cayley-Hamilton)
+// takes O(size) products whatever n is, which pays off for small matrices raised to huge powers
+enum class MatrixPowerMethod
+{
+	repeated_squaring,
+	characteristic_polynomial,
+};
+
+// what one O(size^2) pass over a Matrix finds; determinant, inverse and solve pick their algorithm from it
+struct MatrixStructure
+{
+	bool lower_triangular = false;
+	bool upper_triangular = false;
+	bool diagonal = false;
+	bool symmetric = false;
+	// a single 1 in every row and every column, zero elsewhere
+	bool permutation = false;
+	// symmetric floating point matrix with a positive diagonal, worth trying Cholesky on
+	bool may_be_positive_definite = false;
+};
+
 template <Elementable Element>
 class Matrix
 {
 private:
 	typedef std::vector<Element> RowType;
 	typedef std::vector<RowType> TableType;
+	typedef std::vector<Element, matrix_helper::AlignedAllocator<Element>> StorageType;
 
 public:
 	Matrix() = default;
@@ -26,72 +96,224 @@ public:
 	template <template <Containerable> typename Container>
 	explicit Matrix(const Container<Container<Element>>& matrix);
 
+	template <typename ViewElement>
+		requires std::same_as<std::remove_const_t<ViewElement>, Element>
+	explicit Matrix(const MatrixView<ViewElement>& matrix);
+
+	template <MatrixExpressionNode Expression>
+		requires std::same_as<typename Expression::value_type, Element>
+	Matrix(const Expression& expression);
+
+	template <MatrixExpressionNode Expression>
+		requires std::same_as<typename Expression::value_type, Element>
+	Matrix& operator=(const Expression& expression);
+
 	[[nodiscard]] TableType get_table() const;
 	[[nodiscard]] size_t get_number_of_row() const;
 	[[nodiscard]] size_t get_number_of_col() const;
+	[[nodiscard]] size_t get_stride() const noexcept;
+	[[nodiscard]] const Element* get_data() const noexcept;
+
+	[[nodiscard]] MatrixView<const Element> view() const noexcept;
+	operator MatrixView<const Element>() const noexcept;
+	[[nodiscard]] MatrixView<const Element> sub_matrix(size_t first_row, size_t first_col, size_t row,
+			size_t col) const;
+	[[nodiscard]] RowView<const Element> row(size_t idx) const;
+	[[nodiscard]] ColumnView<const Element> column(size_t idx) const;
 
 	template <typename OtherElement>
 		requires SumableDifferentType<Element, OtherElement>
 	Matrix sum(const Matrix<OtherElement>& other) const;
 	template <typename OtherElement>
-	Matrix operator+(const Matrix<OtherElement>& other) const;
+		requires SumableDifferentType<Element, std::remove_const_t<OtherElement>>
+	Matrix sum(const MatrixView<OtherElement>& other) const;
 	template <typename OtherElement>
 	Matrix& operator+=(const Matrix<OtherElement>& other);
-
-	Matrix operator-() const;
+	template <typename OtherElement>
+		requires SumableDifferentType<Element, std::remove_const_t<OtherElement>>
+	Matrix& operator+=(const MatrixView<OtherElement>& other);
+	template <MatrixExpressionNode Expression>
+	Matrix& operator+=(const Expression& expression);
 
 	template <typename OtherElement>
 	Matrix submission(const Matrix<OtherElement>& other) const;
 	template <typename OtherElement>
-	Matrix operator-(const Matrix<OtherElement>& other) const;
+	Matrix submission(const MatrixView<OtherElement>& other) const;
 	template <typename OtherElement>
 	Matrix& operator-=(const Matrix<OtherElement>& other);
+	template <typename OtherElement>
+	Matrix& operator-=(const MatrixView<OtherElement>& other);
+	template <MatrixExpressionNode Expression>
+	Matrix& operator-=(const Expression& expression);
 
 	template <typename OtherElement>
 		requires MultiplableDifferentTypeReturnFirstType<Element, OtherElement>
 	Matrix multiple(const Matrix<OtherElement>& other) const;
+	template <typename OtherElement>
+		requires MultiplableDifferentTypeReturnFirstType<Element, std::remove_const_t<OtherElement>>
+	Matrix multiple(const MatrixView<OtherElement>& other) const;
 	template <typename OtherElement>
 		requires(not IsMatrixable<OtherElement>) and MultiplableDifferentType<Element, OtherElement>
 	Matrix multiple(const OtherElement& other) const;
 	template <typename OtherElement>
-	Matrix operator*(const OtherElement& other) const;
-	template <typename OtherElement>
 	Matrix& operator*=(const OtherElement& other);
 
 	template <typename OtherElement>
 	bool operator==(const Matrix<OtherElement>& other) const;
+	template <typename OtherElement>
+	bool operator==(const MatrixView<OtherElement>& other) const;
 
 	Element at(size_t row_index, size_t col_index);
 
-	RowType operator[](size_t idx) const;
+	RowView<const Element> operator[](size_t idx) const;
+
+	// remember determinant, tr, inverse, characteristic_polynomial and lu_decomposition until the matrix is next
+	// written; off by default, and copies of the matrix do not inherit it
+	void set_cache_enabled(bool enabled);
+	[[nodiscard]] bool is_cache_enabled() const noexcept;
 
 	Element determinant() const;
+	// exact determinant of an integer matrix by elimination modulo word-sized primes and Chinese remaindering, throws
+	// std::overflow_error when it does not fit in Element
+	[[nodiscard]] Element modular_determinant() const
+		requires Integrable<Element>;
+	[[nodiscard]] LUDecomposition<Element> lu_decomposition() const;
+	[[nodiscard]] CholeskyDecomposition<Element> cholesky_decomposition(bool check_symmetric = false) const;
+	[[nodiscard]] LDLTDecomposition<Element> ldlt_decomposition(bool check_symmetric = false) const;
+
+	// computed on the first call and kept until the matrix is written
+	[[nodiscard]] MatrixStructure structure() const noexcept;
+	[[nodiscard]] bool is_lower_triangular() const noexcept;
+	[[nodiscard]] bool is_upper_triangular() const noexcept;
+	[[nodiscard]] bool is_diagonal() const noexcept;
+	[[nodiscard]] bool is_symmetric() const noexcept;
+	[[nodiscard]] bool is_permutation() const noexcept;
+
+	// A * X = B without forming A^-1: diagonal and permutation matrices take O(size) per column, triangular ones are
+	// substituted directly, symmetric positive definite ones go through Cholesky and everything else through LU
+	[[nodiscard]] Matrix solve(const Matrix& b) const;
+	[[nodiscard]] std::vector<Element> solve(const std::vector<Element>& b) const;
 
 	Matrix transpose() const noexcept;
 	Matrix inverse() const;
 	Element tr() const;
+	// y = A * x for vectors of the matrix's size, split by rows over the thread pool; this makes a Matrix a
+	// LinearOperator
+	void multiply(const Element* x, Element* y) const;
+	[[nodiscard]] Matrix power(uint64_t exponent,
+			MatrixPowerMethod method = MatrixPowerMethod::repeated_squaring) const;
+	// e^A by scaling and squaring with a Pade approximant of degree at most 13
+	[[nodiscard]] Matrix expm() const
+		requires std::floating_point<Element>;
+	// e^(t * A) * v by a truncated Taylor series on matrix-vector products, e^(t * A) is never formed
+	[[nodiscard]] std::vector<Element> expm_multiply(const std::vector<Element>& v, Element t = 1) const
+		requires std::floating_point<Element>;
 
 	[[nodiscard]] std::string to_string() const noexcept;
 	[[nodiscard]] explicit operator std::string() const noexcept;
 
-	Polynomial<Element> characteristic_polynomial() const;
+	// det(A - x * I)
+	// Polynomial<Element>, deduced so that element types without polynomials (ModInt) still instantiate Matrix
+	auto characteristic_polynomial() const
+		requires Polynomialable<Element>;
+	// real eigenvalues only, see eigen_decomposition for complex ones and eigenvectors
 	std::vector<Element> eigenvalues() const;
+	[[nodiscard]] EigenDecomposition<Element> eigen_decomposition(bool compute_eigenvectors = false) const;
+	// reads the lower triangle only
+	[[nodiscard]] SymmetricEigenDecomposition<Element> symmetric_eigen(bool compute_eigenvectors = true) const;
+	// the k eigenpairs of largest magnitude through matrix-vector products only
+	[[nodiscard]] PartialEigenDecomposition<Element> top_eigenpairs(size_t k,
+			EigenSolverMethod method = EigenSolverMethod::krylov) const;
 
 private:
-	RowType& operator[](size_t idx);
+	template <Elementable OtherElement>
+	friend class Matrix;
+	friend class LUDecomposition<Element>;
+	friend class CholeskyDecomposition<Element>;
+	friend class LDLTDecomposition<Element>;
+	friend class HessenbergDecomposition<Element>;
+	friend class EigenDecomposition<Element>;
+	friend class SymmetricEigenDecomposition<Element>;
+	friend class PartialEigenDecomposition<Element>;
+	friend class SparseMatrix<Element>;
+	friend class SparseDirectSolver<Element>;
+	friend class TriangularMatrix<Element>;
+	friend class SymmetricMatrix<Element>;
+	friend class BandedMatrix<Element>;
+
+	// the write access for the friends: taking it drops the structure and the cached results once and hands out plain
+	// row pointers for the kernels, so take it after the last query and again after the matrix is reassigned
+	class MutableRows
+	{
+	public:
+		explicit MutableRows(Matrix& matrix) noexcept;
+
+		RowView<Element> operator[](size_t idx) const noexcept;
+		[[nodiscard]] Element* row_data(size_t idx) const noexcept;
+
+	private:
+		Element* data;
+		size_t number_of_col;
+		size_t stride;
+	};
+
+	[[nodiscard]] MutableRows mutable_rows() noexcept;
+	[[nodiscard]] const Element* row_data(size_t idx) const noexcept;
+
+	void swap_rows(size_t first_row_index, size_t second_row_index) noexcept;
+
+	// the uncached computations
+	[[nodiscard]] Element compute_determinant() const;
+	[[nodiscard]] Matrix compute_inverse() const;
+	[[nodiscard]] auto compute_characteristic_polynomial() const
+		requires Polynomialable<Element>;
 
-	size_t number_of_row;
-	size_t number_of_col;
-	TableType table;
+	// exact fraction-free elimination in matrix_helper::WideInteger, falls back to modular_determinant when a minor
+	// does not fit and throws std::overflow_error when the result does not
+	[[nodiscard]] Element bareiss_determinant() const
+		requires Integrable<Element>;
+
+	[[nodiscard]] MatrixStructure find_structure() const noexcept;
+	// drops the structure and the cached results
+	void invalidate_cache() noexcept;
+	// the column of the 1 in every row of a permutation matrix
+	[[nodiscard]] std::vector<size_t> permutation_columns() const;
+	// ||A - shift * I||_1
+	[[nodiscard]] Element one_norm(Element shift = 0) const;
+
+	size_t number_of_row = 0;
+	size_t number_of_col = 0;
+	// distance between the first elements of two consecutive rows
+	size_t stride = 0;
+	// row-major, one cache-line aligned allocation for the whole table
+	StorageType storage;
+	// MatrixStructure as bits, zero while unknown and in copies; written by const member functions, hence atomic
+	mutable matrix_helper::CopyableAtomic<uint8_t> structure_cache;
+	MatrixCache<Element> cache;
 };
 
 template <Elementable Element>
 std::ostream& operator<<(std::ostream& os, const Matrix<Element>& matrix);
 
-template <typename Element, typename OtherElement>
-	requires(not IsMatrixable<Element>) and
-		(not IsMatrixable<OtherElement>) and MultiplableDifferentType<Element, OtherElement>
-Matrix<Element> operator*(const OtherElement& number, const Matrix<Element>& matrix);
+// a temporary on the left is updated in place and returned instead of building a new matrix
+template <Elementable Element, typename Right>
+	requires MatrixOperand<Right> and SumableDifferentType<Element, matrix_expression::value_type_t<Right>>
+Matrix<Element> operator+(Matrix<Element>&& left, Right&& right);
+
+template <Elementable Element, typename Right>
+	requires MatrixOperand<Right>
+Matrix<Element> operator-(Matrix<Element>&& left, Right&& right);
+
+template <Elementable Element>
+Matrix<Element> operator-(Matrix<Element>&& operand);
+
+template <Elementable Element, typename Scalar>
+	requires(not MatrixOperand<Scalar>) and MultiplableDifferentType<Element, Scalar>
+Matrix<Element> operator*(Matrix<Element>&& matrix, const Scalar& scalar);
+
+template <typename Scalar, Elementable Element>
+	requires(not MatrixOperand<Scalar>) and MultiplableDifferentType<Element, Scalar>
+Matrix<Element> operator*(const Scalar& scalar, Matrix<Element>&& matrix);
 
 #include "matrix-tmp.h"
 
@@ -0,0 +1,248 @@
+#ifndef MATRIX_MOD_INT_TMP_H
+#define MATRIX_MOD_INT_TMP_H
+
+#include <stdexcept>
+
+#include "mod-int.h"
+
+template <typename Word>
+constexpr Montgomery<Word>::Montgomery(Word modulus) noexcept
+: modulus(modulus)
+, negative_inverse(0)
+, r(static_cast<Word>(Word(0) - modulus) % modulus)
+, r_square(static_cast<Word>(DoubleWord(r) * r % modulus))
+{
+	// Newton's iteration doubles the number of correct low bits, n is its own inverse modulo 8
+	Word inverse = modulus;
+	for (size_t i = 0; i < 5; ++i)
+		inverse *= static_cast<Word>(2 - modulus * inverse);
+	negative_inverse = static_cast<Word>(Word(0) - inverse);
+}
+
+template <typename Word>
+constexpr Word Montgomery<Word>::get_modulus() const noexcept
+{
+	return modulus;
+}
+
+template <typename Word>
+template <std::integral Integer>
+constexpr Word Montgomery<Word>::from_integer(Integer value) const noexcept
+{
+	bool negative = false;
+	uint64_t magnitude = static_cast<uint64_t>(value);
+	if constexpr (std::is_signed_v<Integer>)
+	{
+		negative = value < 0;
+		if (negative)
+			magnitude = uint64_t(0) - magnitude;
+	}
+
+	const Word result = multiply(static_cast<Word>(magnitude % modulus), r_square);
+	return negative ? negate(result) : result;
+}
+
+template <typename Word>
+constexpr Word Montgomery<Word>::to_integer(Word value) const noexcept
+{
+	return reduce(value);
+}
+
+template <typename Word>
+constexpr Word Montgomery<Word>::one() const noexcept
+{
+	return r;
+}
+
+template <typename Word>
+constexpr Word Montgomery<Word>::add(Word first, Word second) const noexcept
+{
+	const Word sum = first + second;
+	return sum >= modulus ? sum - modulus : sum;
+}
+
+template <typename Word>
+constexpr Word Montgomery<Word>::subtract(Word first, Word second) const noexcept
+{
+	return first >= second ? first - second : first + (modulus - second);
+}
+
+template <typename Word>
+constexpr Word Montgomery<Word>::negate(Word value) const noexcept
+{
+	return value == 0 ? 0 : modulus - value;
+}
+
+template <typename Word>
+constexpr Word Montgomery<Word>::multiply(Word first, Word second) const noexcept
+{
+	return reduce(DoubleWord(first) * second);
+}
+
+template <typename Word>
+constexpr Word Montgomery<Word>::power(Word base, uint64_t exponent) const noexcept
+{
+	Word result = r;
+	for (; exponent > 0; exponent >>= 1)
+	{
+		if (exponent & 1)
+			result = multiply(result, base);
+		base = multiply(base, base);
+	}
+	return result;
+}
+
+template <typename Word>
+constexpr Word Montgomery<Word>::inverse(Word value) const noexcept
+{
+	return power(value, modulus - 2);
+}
+
+// REDC: adding m * n clears the low word, and value < n * R with n < R / 2 keeps the sum below R^2
+template <typename Word>
+constexpr Word Montgomery<Word>::reduce(DoubleWord value) const noexcept
+{
+	constexpr size_t BITS = sizeof(Word) * 8;
+	const Word m = static_cast<Word>(static_cast<Word>(value) * negative_inverse);
+	const Word result = static_cast<Word>((value + DoubleWord(m) * modulus) >> BITS);
+	return result >= modulus ? result - modulus : result;
+}
+
+template <uint64_t P>
+template <std::integral Integer>
+constexpr ModInt<P>::ModInt(Integer value) noexcept
+: residue(MODULUS.from_integer(value))
+{
+}
+
+template <uint64_t P>
+constexpr uint64_t ModInt<P>::get_modulus() noexcept
+{
+	return P;
+}
+
+template <uint64_t P>
+constexpr uint64_t ModInt<P>::value() const noexcept
+{
+	return MODULUS.to_integer(residue);
+}
+
+template <uint64_t P>
+constexpr ModInt<P> ModInt<P>::operator+(const ModInt& other) const noexcept
+{
+	ModInt result;
+	result.residue = MODULUS.add(residue, other.residue);
+	return result;
+}
+
+template <uint64_t P>
+constexpr ModInt<P> ModInt<P>::operator-(const ModInt& other) const noexcept
+{
+	ModInt result;
+	result.residue = MODULUS.subtract(residue, other.residue);
+	return result;
+}
+
+template <uint64_t P>
+constexpr ModInt<P> ModInt<P>::operator*(const ModInt& other) const noexcept
+{
+	ModInt result;
+	result.residue = MODULUS.multiply(residue, other.residue);
+	return result;
+}
+
+template <uint64_t P>
+constexpr ModInt<P> ModInt<P>::operator/(const ModInt& other) const
+{
+	return *this * other.inverse();
+}
+
+template <uint64_t P>
+constexpr ModInt<P> ModInt<P>::operator-() const noexcept
+{
+	ModInt result;
+	result.residue = MODULUS.negate(residue);
+	return result;
+}
+
+template <uint64_t P>
+constexpr ModInt<P>& ModInt<P>::operator+=(const ModInt& other) noexcept
+{
+	residue = MODULUS.add(residue, other.residue);
+	return *this;
+}
+
+template <uint64_t P>
+constexpr ModInt<P>& ModInt<P>::operator-=(const ModInt& other) noexcept
+{
+	residue = MODULUS.subtract(residue, other.residue);
+	return *this;
+}
+
+template <uint64_t P>
+constexpr ModInt<P>& ModInt<P>::operator*=(const ModInt& other) noexcept
+{
+	residue = MODULUS.multiply(residue, other.residue);
+	return *this;
+}
+
+template <uint64_t P>
+constexpr ModInt<P>& ModInt<P>::operator/=(const ModInt& other)
+{
+	return *this = *this / other;
+}
+
+template <uint64_t P>
+constexpr ModInt<P> ModInt<P>::power(uint64_t exponent) const noexcept
+{
+	ModInt result;
+	result.residue = MODULUS.power(residue, exponent);
+	return result;
+}
+
+template <uint64_t P>
+constexpr ModInt<P> ModInt<P>::inverse() const
+{
+	if (residue == 0)
+		throw std::invalid_argument("zero has no inverse!");
+	return power(P - 2);
+}
+
+template <std::integral Integer, uint64_t P>
+constexpr ModInt<P> operator+(Integer first, const ModInt<P>& second) noexcept
+{
+	return ModInt<P>(first) + second;
+}
+
+template <std::integral Integer, uint64_t P>
+constexpr ModInt<P> operator-(Integer first, const ModInt<P>& second) noexcept
+{
+	return ModInt<P>(first) - second;
+}
+
+template <std::integral Integer, uint64_t P>
+constexpr ModInt<P> operator*(Integer first, const ModInt<P>& second) noexcept
+{
+	return ModInt<P>(first) * second;
+}
+
+template <std::integral Integer, uint64_t P>
+constexpr ModInt<P> operator/(Integer first, const ModInt<P>& second)
+{
+	return ModInt<P>(first) / second;
+}
+
+template <uint64_t P>
+std::string to_string(const ModInt<P>& value)
+{
+	return std::to_string(value.value());
+}
+
+template <uint64_t P>
+std::ostream& operator<<(std::ostream& os, const ModInt<P>& value)
+{
+	os << value.value();
+	return os;
+}
+
+#endif
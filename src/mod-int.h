@@ -0,0 +1,115 @@
+#ifndef MATRIX_MOD_INT_H
+#define MATRIX_MOD_INT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <concepts>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include "matrix-helper.h"
+
+// Arithmetic modulo an odd n < R / 2 with R = 2^(bits of Word), in Montgomery form: x is kept as x * R mod n so that
+// a product needs two multiplications and no division. 32-bit words multiply in 64 bits, 64-bit words need a 128-bit
+// integer.
+template <typename Word>
+class Montgomery
+{
+public:
+	using DoubleWord = std::conditional_t<sizeof(Word) == sizeof(uint32_t), uint64_t,
+			matrix_helper::WideUnsignedInteger>;
+	static_assert(std::is_same_v<Word, uint32_t> or std::is_same_v<Word, uint64_t>);
+	static_assert(sizeof(DoubleWord) == 2 * sizeof(Word), "64-bit Montgomery arithmetic needs a 128-bit integer");
+
+	constexpr explicit Montgomery(Word modulus) noexcept;
+
+	[[nodiscard]] constexpr Word get_modulus() const noexcept;
+
+	template <std::integral Integer>
+	[[nodiscard]] constexpr Word from_integer(Integer value) const noexcept;
+	// canonical residue in [0, n)
+	[[nodiscard]] constexpr Word to_integer(Word value) const noexcept;
+	[[nodiscard]] constexpr Word one() const noexcept;
+
+	[[nodiscard]] constexpr Word add(Word first, Word second) const noexcept;
+	[[nodiscard]] constexpr Word subtract(Word first, Word second) const noexcept;
+	[[nodiscard]] constexpr Word negate(Word value) const noexcept;
+	[[nodiscard]] constexpr Word multiply(Word first, Word second) const noexcept;
+	[[nodiscard]] constexpr Word power(Word base, uint64_t exponent) const noexcept;
+	// by Fermat, so only for a prime modulus; zero stays zero
+	[[nodiscard]] constexpr Word inverse(Word value) const noexcept;
+
+private:
+	// value * R^-1 mod n for value < n * R
+	[[nodiscard]] constexpr Word reduce(DoubleWord value) const noexcept;
+
+	Word modulus;
+	// -n^-1 mod R
+	Word negative_inverse;
+	// R mod n and R^2 mod n
+	Word r;
+	Word r_square;
+};
+
+// Element of Z / PZ for an odd prime P below 2^63. Primes below 2^31 use 32-bit words, so a row of them is as
+// vectorizable as a row of int.
+template <uint64_t P>
+class ModInt
+{
+private:
+	using Word = std::conditional_t<(P < (uint64_t(1) << 31)), uint32_t, uint64_t>;
+	static_assert(P % 2 == 1 and P < (uint64_t(1) << 63), "the modulus should be an odd prime below 2^63");
+
+	static constexpr Montgomery<Word> MODULUS{static_cast<Word>(P)};
+
+public:
+	constexpr ModInt() noexcept = default;
+	template <std::integral Integer>
+	constexpr ModInt(Integer value) noexcept;
+
+	[[nodiscard]] static constexpr uint64_t get_modulus() noexcept;
+	// canonical residue in [0, P)
+	[[nodiscard]] constexpr uint64_t value() const noexcept;
+
+	[[nodiscard]] constexpr ModInt operator+(const ModInt& other) const noexcept;
+	[[nodiscard]] constexpr ModInt operator-(const ModInt& other) const noexcept;
+	[[nodiscard]] constexpr ModInt operator*(const ModInt& other) const noexcept;
+	[[nodiscard]] constexpr ModInt operator/(const ModInt& other) const;
+	[[nodiscard]] constexpr ModInt operator-() const noexcept;
+	constexpr ModInt& operator+=(const ModInt& other) noexcept;
+	constexpr ModInt& operator-=(const ModInt& other) noexcept;
+	constexpr ModInt& operator*=(const ModInt& other) noexcept;
+	constexpr ModInt& operator/=(const ModInt& other);
+
+	constexpr bool operator==(const ModInt& other) const noexcept = default;
+
+	[[nodiscard]] constexpr ModInt power(uint64_t exponent) const noexcept;
+	// throws std::invalid_argument for zero
+	[[nodiscard]] constexpr ModInt inverse() const;
+
+private:
+	// Montgomery form, always reduced below P so that equality is a word comparison
+	Word residue = 0;
+};
+
+// integers on the left, e.g. 1 / x
+template <std::integral Integer, uint64_t P>
+[[nodiscard]] constexpr ModInt<P> operator+(Integer first, const ModInt<P>& second) noexcept;
+template <std::integral Integer, uint64_t P>
+[[nodiscard]] constexpr ModInt<P> operator-(Integer first, const ModInt<P>& second) noexcept;
+template <std::integral Integer, uint64_t P>
+[[nodiscard]] constexpr ModInt<P> operator*(Integer first, const ModInt<P>& second) noexcept;
+template <std::integral Integer, uint64_t P>
+[[nodiscard]] constexpr ModInt<P> operator/(Integer first, const ModInt<P>& second);
+
+template <uint64_t P>
+[[nodiscard]] std::string to_string(const ModInt<P>& value);
+
+template <uint64_t P>
+std::ostream& operator<<(std::ostream& os, const ModInt<P>& value);
+
+#include "mod-int-tmp.h"
+
+#endif
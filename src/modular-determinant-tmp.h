@@ -0,0 +1,171 @@
+#ifndef MATRIX_MODULAR_DETERMINANT_TMP_H
+#define MATRIX_MODULAR_DETERMINANT_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "matrix-helper.h"
+#include "modular-determinant.h"
+
+namespace modular_arithmetic
+{
+
+template <typename Word>
+constexpr bool is_prime(Word n) noexcept
+{
+	// these bases decide every n below 3.3 * 10^24
+	constexpr Word BASES[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+	if (n < 2)
+		return false;
+	for (const Word base : BASES)
+	{
+		if (n % base == 0)
+			return n == base;
+	}
+
+	Word odd_part = n - 1;
+	size_t number_of_halving = 0;
+	for (; odd_part % 2 == 0; odd_part /= 2)
+		++number_of_halving;
+
+	const Montgomery<Word> modulus(n);
+	const Word minus_one = modulus.negate(modulus.one());
+	for (const Word base : BASES)
+	{
+		Word x = modulus.power(modulus.from_integer(base), odd_part);
+		bool composite = x != modulus.one() and x != minus_one;
+		for (size_t i = 1; i < number_of_halving and composite; ++i)
+		{
+			x = modulus.multiply(x, x);
+			composite = x != minus_one;
+		}
+		if (composite)
+			return false;
+	}
+	return true;
+}
+
+template <typename Word>
+std::vector<Word> largest_primes(size_t count)
+{
+	std::vector<Word> primes;
+	for (Word candidate = (Word(1) << (sizeof(Word) * 8 - 1)) - 1; primes.size() < count; candidate -= 2)
+	{
+		if (is_prime(candidate))
+			primes.push_back(candidate);
+	}
+	return primes;
+}
+
+template <typename Word, Integrable Element>
+Word determinant_modulo(const Matrix<Element>& matrix, const Montgomery<Word>& modulus)
+{
+	const size_t size = matrix.get_number_of_row();
+	std::vector<Word> table(size * size);
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		const Element* row = matrix.get_data() + row_index * matrix.get_stride();
+		for (size_t col_index = 0; col_index < size; ++col_index)
+			table[row_index * size + col_index] = modulus.from_integer(row[col_index]);
+	}
+
+	Word det = modulus.one();
+	for (size_t col_index = 0; col_index < size; ++col_index)
+	{
+		size_t pivot_row_index = col_index;
+		while (pivot_row_index < size and table[pivot_row_index * size + col_index] == 0)
+			++pivot_row_index;
+		if (pivot_row_index == size)
+			return 0;
+
+		Word* pivot_row = table.data() + col_index * size;
+		if (pivot_row_index != col_index)
+		{
+			std::swap_ranges(pivot_row, pivot_row + size, table.data() + pivot_row_index * size);
+			det = modulus.negate(det);
+		}
+		det = modulus.multiply(det, pivot_row[col_index]);
+
+		const Word negative_inverse = modulus.negate(modulus.inverse(pivot_row[col_index]));
+		for (size_t row_index = col_index + 1; row_index < size; ++row_index)
+		{
+			Word* row = table.data() + row_index * size;
+			const Word factor = modulus.multiply(row[col_index], negative_inverse);
+			if (factor == 0)
+				continue;
+			for (size_t i = col_index + 1; i < size; ++i)
+				row[i] = modulus.add(row[i], modulus.multiply(factor, pivot_row[i]));
+		}
+	}
+	return modulus.to_integer(det);
+}
+
+template <Integrable Element>
+Element determinant(const Matrix<Element>& matrix)
+{
+	using Wide = matrix_helper::WideInteger;
+	const size_t size = matrix.get_number_of_row();
+	if (size != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	// Hadamard: |det(A)| <= prod ||row_i||, so a zero row settles it
+	long double bound_bits = 0;
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		const Element* row = matrix.get_data() + row_index * matrix.get_stride();
+		long double norm_square = 0;
+		for (size_t col_index = 0; col_index < size; ++col_index)
+			norm_square += static_cast<long double>(row[col_index]) * static_cast<long double>(row[col_index]);
+		if (norm_square == 0)
+			return 0;
+		bound_bits += std::log2(norm_square) / 2;
+	}
+
+	// every prime is above 2^(bits of PrimeWord - 2), the product has to exceed 2 * |det(A)|
+	constexpr size_t PRIME_BITS = sizeof(PrimeWord) * 8 - 2;
+	const size_t number_of_prime = static_cast<size_t>((bound_bits + 2) / PRIME_BITS) + 1;
+	const std::vector<PrimeWord> primes = largest_primes<PrimeWord>(number_of_prime);
+
+	std::vector<PrimeWord> residues(number_of_prime);
+	matrix_helper::parallel_for(number_of_prime, size * size * size, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			residues[i] = determinant_modulo(matrix, Montgomery<PrimeWord>(primes[i]));
+	});
+
+	// Garner: det = sum digit_i * p_0 * ... * p_(i - 1) with |digit_i| < p_i / 2, unique for |det| < prod p_i / 2
+	std::vector<long long> digits(number_of_prime);
+	for (size_t i = 0; i < number_of_prime; ++i)
+	{
+		const Montgomery<PrimeWord> modulus(primes[i]);
+		PrimeWord partial = 0;
+		PrimeWord radix = modulus.one();
+		for (size_t j = 0; j < i; ++j)
+		{
+			partial = modulus.add(partial, modulus.multiply(modulus.from_integer(digits[j]), radix));
+			radix = modulus.multiply(radix, modulus.from_integer(primes[j]));
+		}
+		const PrimeWord difference = modulus.subtract(modulus.from_integer(residues[i]), partial);
+		const PrimeWord digit = modulus.to_integer(modulus.multiply(difference, modulus.inverse(radix)));
+		digits[i] = digit > primes[i] / 2 ? static_cast<long long>(digit) - static_cast<long long>(primes[i])
+										  : static_cast<long long>(digit);
+	}
+
+	// Horner from the most significant digit: det = det * p_i - (-digit_i) * 1
+	Wide det = 0;
+	for (size_t i = number_of_prime; i-- > 0;)
+	{
+		if (not matrix_helper::checked_cross_difference(det, Wide(primes[i]), Wide(-digits[i]), Wide(1), det))
+			throw std::overflow_error("the determinant does not fit in the element type!");
+	}
+	if (det < static_cast<Wide>(std::numeric_limits<Element>::min()) or
+			det > static_cast<Wide>(std::numeric_limits<Element>::max()))
+		throw std::overflow_error("the determinant does not fit in the element type!");
+	return static_cast<Element>(det);
+}
+
+}		 // namespace modular_arithmetic
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef MATRIX_MODULAR_DETERMINANT_H
+#define MATRIX_MODULAR_DETERMINANT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+#include "mod-int.h"
+
+namespace modular_arithmetic
+{
+
+// 63-bit primes where 64-bit Montgomery arithmetic is available, 31-bit ones otherwise
+using PrimeWord =
+		std::conditional_t<sizeof(matrix_helper::WideUnsignedInteger) == 2 * sizeof(uint64_t), uint64_t, uint32_t>;
+
+// deterministic Miller-Rabin, exact for every n below R / 2
+template <typename Word>
+[[nodiscard]] constexpr bool is_prime(Word n) noexcept;
+
+// the count largest primes below 2^(bits of Word - 1), largest first
+template <typename Word>
+[[nodiscard]] std::vector<Word> largest_primes(size_t count);
+
+// det(A) mod p by Gaussian elimination in Montgomery form
+template <typename Word, Integrable Element>
+[[nodiscard]] Word determinant_modulo(const Matrix<Element>& matrix, const Montgomery<Word>& modulus);
+
+// Exact det(A): one elimination per prime, as many primes as Hadamard's bound asks for, the primes spread over the
+// thread pool, then Chinese remaindering into symmetric mixed-radix digits. Throws std::overflow_error when the
+// determinant does not fit in Element.
+template <Integrable Element>
+[[nodiscard]] Element determinant(const Matrix<Element>& matrix);
+
+}		 // namespace modular_arithmetic
+
+#include "modular-determinant-tmp.h"
+
+#endif
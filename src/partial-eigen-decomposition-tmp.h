@@ -0,0 +1,442 @@
+#ifndef MATRIX_PARTIAL_EIGEN_DECOMPOSITION_TMP_H
+#define MATRIX_PARTIAL_EIGEN_DECOMPOSITION_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "eigen-decomposition.h"
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+#include "partial-eigen-decomposition.h"
+#include "symmetric-eigen-decomposition.h"
+
+template <Elementable Element>
+template <typename Operator>
+	requires LinearOperator<Operator, Element>
+PartialEigenDecomposition<Element>::PartialEigenDecomposition(const Operator& apply, size_t size, size_t k,
+		bool symmetric, EigenSolverMethod method)
+: size(size)
+, symmetric(symmetric)
+{
+	if (k == 0 or k > size)
+		throw std::invalid_argument("the number of eigenpairs should be between 1 and the size of the matrix!");
+
+	if (method == EigenSolverMethod::krylov)
+		krylov_schur(apply, k);
+	else
+		subspace_iteration(apply, k);
+}
+
+// A * V = V * H + v * b^T with orthonormal rows in V: extend V one matrix-vector product at a time, then keep the
+// wanted Ritz vectors as the first rows of the next basis and the residual vector v right after them
+template <Elementable Element>
+template <typename Operator>
+void PartialEigenDecomposition<Element>::krylov_schur(const Operator& apply, size_t k)
+{
+	using std::abs;
+	using std::sqrt;
+	const size_t basis_size = std::min(size, std::max(2 * k + 1, k + MIN_EXTRA_BASIS_SIZE));
+	const Element negligible = 100 * std::numeric_limits<Element>::epsilon();
+
+	Matrix<Element> basis(basis_size + 1, size);
+	// rows [0, basis_size) hold H, row basis_size holds b
+	Matrix<Element> h(basis_size + 1, basis_size);
+	std::vector<Element> coefficients(basis_size);
+	std::vector<std::complex<Element>> ritz_values;
+	Matrix<Element> ritz_vectors;
+	random_direction(basis, 0);
+	const auto basis_rows = basis.mutable_rows();
+
+	size_t first = 0;
+	for (size_t restart = 0; restart < MAX_RESTART; ++restart)
+	{
+		const auto h_rows = h.mutable_rows();
+		for (size_t j = first; j < basis_size; ++j)
+		{
+			Element* w = basis_rows.row_data(j + 1);
+			matrix_helper::apply_operator(apply, basis.row_data(j), w);
+			++number_of_matvec;
+
+			const Element original_norm = sqrt(matrix_kernel::dot(size, w, w));
+			std::fill_n(coefficients.begin(), j + 1, Element(0));
+			const Element norm = orthogonalize(basis, j + 1, w, coefficients.data());
+			for (size_t i = 0; i <= j; ++i)
+				h_rows.row_data(i)[j] = coefficients[i];
+
+			if (j + 1 < size and norm > negligible * original_norm)
+			{
+				h_rows.row_data(j + 1)[j] = norm;
+				matrix_kernel::scale(size, w, 1 / norm, w);
+			}
+			else
+			{
+				// the basis spans an invariant subspace: carry on with any direction orthogonal to it
+				h_rows.row_data(j + 1)[j] = 0;
+				if (j + 1 < size)
+					random_direction(basis, j + 1);
+				else
+					std::fill_n(w, size, Element(0));
+			}
+		}
+
+		Matrix<Element> projected(basis_size, basis_size);
+		const auto projected_rows = projected.mutable_rows();
+		for (size_t i = 0; i < basis_size; ++i)
+			std::copy_n(h.row_data(i), basis_size, projected_rows.row_data(i));
+		rayleigh_ritz(projected, ritz_values, ritz_vectors);
+		const size_t wanted = wanted_count(ritz_values, k);
+
+		// the residual of Ritz pair (theta, y) is |b^T * y|
+		const Element* residual_row = h.row_data(basis_size);
+		const Element threshold = tolerance() * abs(ritz_values[0]);
+		bool converged = true;
+		for (size_t j = 0; j < wanted and converged; ++j)
+		{
+			Element residual = abs(matrix_kernel::dot(basis_size, residual_row, ritz_vectors.row_data(j)));
+			if (ritz_values[j].imag() > 0)
+			{
+				const Element imaginary_residual = matrix_kernel::dot(basis_size, residual_row,
+						ritz_vectors.row_data(j + 1));
+				residual = sqrt(residual * residual + imaginary_residual * imaginary_residual);
+				++j;
+			}
+			converged = residual <= threshold;
+		}
+		if (converged or basis_size == size)
+		{
+			store(ritz_values, ritz_vectors, basis, basis_size, wanted);
+			return;
+		}
+
+		// keep half of the unwanted Ritz vectors too, they speed up the next cycle
+		size_t kept = wanted + (basis_size - wanted) / 2;
+		if (ritz_values[kept - 1].imag() > 0)
+			kept = kept + 1 < basis_size ? kept + 1 : kept - 1;
+		for (size_t j = 0; j < kept; ++j)
+			orthonormalize(ritz_vectors, j);
+
+		// V = Q * V, H = Q * H * Q^T and b = Q * b for the orthonormal rows Q of the kept Ritz vectors
+		Matrix<Element> restarted(kept, size);
+		matrix_kernel::gemm(kept, size, basis_size, ritz_vectors.get_data(), ritz_vectors.get_stride(),
+				basis.get_data(), basis.get_stride(), restarted.mutable_rows().row_data(0), restarted.get_stride());
+		for (size_t j = 0; j < kept; ++j)
+			std::copy_n(restarted.row_data(j), size, basis_rows.row_data(j));
+		std::copy_n(basis.row_data(basis_size), size, basis_rows.row_data(kept));
+
+		Matrix<Element> h_q(basis_size, kept);
+		const auto h_q_rows = h_q.mutable_rows();
+		for (size_t i = 0; i < basis_size; ++i)
+		{
+			for (size_t j = 0; j < kept; ++j)
+				h_q_rows.row_data(i)[j] = matrix_kernel::dot(basis_size, h.row_data(i), ritz_vectors.row_data(j));
+		}
+		Matrix<Element> restarted_h(basis_size + 1, basis_size);
+		const auto restarted_h_rows = restarted_h.mutable_rows();
+		for (size_t j = 0; j < kept; ++j)
+		{
+			const Element* q = ritz_vectors.row_data(j);
+			for (size_t i = 0; i < basis_size; ++i)
+				matrix_kernel::axpy(kept, q[i], h_q.row_data(i), restarted_h_rows.row_data(j));
+			restarted_h_rows.row_data(kept)[j] = matrix_kernel::dot(basis_size, residual_row, q);
+		}
+		h = std::move(restarted_h);
+		first = kept;
+	}
+	throw std::runtime_error("the Krylov iteration did not converge!");
+}
+
+template <Elementable Element>
+template <typename Operator>
+void PartialEigenDecomposition<Element>::subspace_iteration(const Operator& apply, size_t k)
+{
+	using std::abs;
+	using std::sqrt;
+	const size_t block_size = std::min(size, 2 * k + 2);
+
+	Matrix<Element> x(block_size, size);
+	Matrix<Element> y(block_size, size);
+	Matrix<Element> projected(block_size, block_size);
+	std::vector<std::complex<Element>> ritz_values;
+	Matrix<Element> ritz_vectors;
+	std::vector<Element> residual(size);
+	for (size_t j = 0; j < block_size; ++j)
+		random_direction(x, j);
+
+	const auto y_rows = y.mutable_rows();
+	const auto projected_rows = projected.mutable_rows();
+	for (size_t iteration = 0; iteration < MAX_SUBSPACE_ITERATION; ++iteration)
+	{
+		for (size_t j = 0; j < block_size; ++j)
+			matrix_helper::apply_operator(apply, x.row_data(j), y_rows.row_data(j));
+		number_of_matvec += block_size;
+
+		// H = X * A * X^T, then X and A * X are rotated onto the Ritz vectors
+		for (size_t i = 0; i < block_size; ++i)
+		{
+			for (size_t j = 0; j < block_size; ++j)
+				projected_rows.row_data(i)[j] = matrix_kernel::dot(size, x.row_data(i), y.row_data(j));
+		}
+		rayleigh_ritz(projected, ritz_values, ritz_vectors);
+		const size_t wanted = wanted_count(ritz_values, k);
+
+		Matrix<Element> ritz_x(block_size, size);
+		Matrix<Element> ritz_y(block_size, size);
+		matrix_kernel::gemm(block_size, size, block_size, ritz_vectors.get_data(), ritz_vectors.get_stride(),
+				x.get_data(), x.get_stride(), ritz_x.mutable_rows().row_data(0), ritz_x.get_stride());
+		matrix_kernel::gemm(block_size, size, block_size, ritz_vectors.get_data(), ritz_vectors.get_stride(),
+				y.get_data(), y.get_stride(), ritz_y.mutable_rows().row_data(0), ritz_y.get_stride());
+
+		// ||A * z - theta * z|| with z = x_j + i * x_(j + 1) for a complex pair
+		const Element threshold = tolerance() * abs(ritz_values[0]);
+		bool converged = true;
+		for (size_t j = 0; j < wanted and converged; ++j)
+		{
+			const Element real = ritz_values[j].real();
+			const Element imaginary = ritz_values[j].imag();
+			std::copy_n(ritz_y.row_data(j), size, residual.data());
+			matrix_kernel::axpy(size, -real, ritz_x.row_data(j), residual.data());
+			Element residual_square = 0;
+			if (imaginary > 0)
+			{
+				matrix_kernel::axpy(size, imaginary, ritz_x.row_data(j + 1), residual.data());
+				residual_square = matrix_kernel::dot(size, residual.data(), residual.data());
+				std::copy_n(ritz_y.row_data(j + 1), size, residual.data());
+				matrix_kernel::axpy(size, -imaginary, ritz_x.row_data(j), residual.data());
+				matrix_kernel::axpy(size, -real, ritz_x.row_data(j + 1), residual.data());
+				++j;
+			}
+			residual_square += matrix_kernel::dot(size, residual.data(), residual.data());
+			converged = sqrt(residual_square) <= threshold;
+		}
+		if (converged)
+		{
+			eigenvalues.assign(ritz_values.begin(), ritz_values.begin() + static_cast<std::ptrdiff_t>(wanted));
+			vectors = Matrix<Element>(wanted, size);
+			const auto vectors_rows = vectors.mutable_rows();
+			for (size_t j = 0; j < wanted; ++j)
+				std::copy_n(ritz_x.row_data(j), size, vectors_rows.row_data(j));
+			return;
+		}
+
+		// one power step: X = orth(A * X)
+		x = std::move(ritz_y);
+		for (size_t j = 0; j < block_size; ++j)
+			orthonormalize(x, j);
+	}
+	throw std::runtime_error("the subspace iteration did not converge!");
+}
+
+template <Elementable Element>
+void PartialEigenDecomposition<Element>::rayleigh_ritz(const Matrix<Element>& projected,
+		std::vector<std::complex<Element>>& ritz_values, Matrix<Element>& ritz_vectors) const
+{
+	using std::abs;
+	const size_t count = projected.get_number_of_row();
+	ritz_values.resize(count);
+	ritz_vectors = Matrix<Element>(count, count);
+	const auto ritz_rows = ritz_vectors.mutable_rows();
+
+	// stable, so a conjugate pair stays adjacent with its positive imaginary part first
+	std::vector<size_t> order(count);
+	std::iota(order.begin(), order.end(), 0);
+	const auto by_magnitude = [&](const auto& values)
+	{
+		std::stable_sort(order.begin(), order.end(), [&](size_t first, size_t second)
+		{
+			return abs(values[first]) > abs(values[second]);
+		});
+	};
+
+	if (symmetric)
+	{
+		const SymmetricEigenDecomposition<Element> eigen(projected, true);
+		const std::vector<Element>& values = eigen.get_eigenvalues();
+		by_magnitude(values);
+		for (size_t j = 0; j < count; ++j)
+		{
+			ritz_values[j] = values[order[j]];
+			Element* row = ritz_rows.row_data(j);
+			for (size_t i = 0; i < count; ++i)
+				row[i] = eigen.get_eigenvectors()[i][order[j]];
+		}
+		return;
+	}
+
+	const EigenDecomposition<Element> eigen(projected, true);
+	const std::vector<std::complex<Element>>& values = eigen.get_eigenvalues();
+	const std::vector<std::vector<std::complex<Element>>> eigenvectors = eigen.get_eigenvectors();
+	by_magnitude(values);
+	for (size_t j = 0; j < count; ++j)
+	{
+		const std::complex<Element> value = values[order[j]];
+		ritz_values[j] = value;
+		Element* row = ritz_rows.row_data(j);
+		if (value.imag() == 0)
+		{
+			for (size_t i = 0; i < count; ++i)
+				row[i] = eigenvectors[order[j]][i].real();
+		}
+		else if (value.imag() > 0)
+		{
+			// the conjugate that follows shares the same two rows
+			Element* next_row = ritz_rows.row_data(j + 1);
+			for (size_t i = 0; i < count; ++i)
+			{
+				row[i] = eigenvectors[order[j]][i].real();
+				next_row[i] = eigenvectors[order[j]][i].imag();
+			}
+		}
+	}
+}
+
+template <Elementable Element>
+void PartialEigenDecomposition<Element>::store(const std::vector<std::complex<Element>>& ritz_values,
+		const Matrix<Element>& ritz_vectors, const Matrix<Element>& basis, size_t basis_size, size_t wanted)
+{
+	eigenvalues.assign(ritz_values.begin(), ritz_values.begin() + static_cast<std::ptrdiff_t>(wanted));
+	vectors = Matrix<Element>(wanted, size);
+	matrix_kernel::gemm(wanted, size, basis_size, ritz_vectors.get_data(), ritz_vectors.get_stride(),
+			basis.get_data(), basis.get_stride(), vectors.mutable_rows().row_data(0), vectors.get_stride());
+}
+
+template <Elementable Element>
+Element PartialEigenDecomposition<Element>::orthogonalize(const Matrix<Element>& basis, size_t count, Element* w,
+		Element* coefficients)
+{
+	using std::sqrt;
+	const size_t length = basis.get_number_of_col();
+	std::vector<Element> projection(count);
+	for (size_t pass = 0; pass < 2; ++pass)
+	{
+		matrix_helper::parallel_for(count, length, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+				projection[i] = matrix_kernel::dot(length, basis.row_data(i), w);
+		});
+		matrix_helper::parallel_for(length, count, [&](size_t begin, size_t end)
+		{
+			for (size_t i = 0; i < count; ++i)
+				matrix_kernel::axpy(end - begin, -projection[i], basis.row_data(i) + begin, w + begin);
+		});
+		for (size_t i = 0; i < count; ++i)
+			coefficients[i] += projection[i];
+	}
+	return sqrt(matrix_kernel::dot(length, w, w));
+}
+
+template <Elementable Element>
+void PartialEigenDecomposition<Element>::orthonormalize(Matrix<Element>& rows, size_t index)
+{
+	using std::sqrt;
+	const size_t length = rows.get_number_of_col();
+	Element* row = rows.mutable_rows().row_data(index);
+	const Element original_norm = sqrt(matrix_kernel::dot(length, row, row));
+	std::vector<Element> coefficients(index);
+	const Element norm = orthogonalize(rows, index, row, coefficients.data());
+	if (norm <= 100 * std::numeric_limits<Element>::epsilon() * original_norm)
+		random_direction(rows, index);
+	else
+		matrix_kernel::scale(length, row, 1 / norm, row);
+}
+
+template <Elementable Element>
+void PartialEigenDecomposition<Element>::random_direction(Matrix<Element>& rows, size_t index)
+{
+	const size_t length = rows.get_number_of_col();
+	Element* row = rows.mutable_rows().row_data(index);
+	std::uniform_real_distribution<Element> distribution(-1, 1);
+	std::vector<Element> coefficients(index);
+	Element norm = 0;
+	while (norm == 0)
+	{
+		for (size_t i = 0; i < length; ++i)
+			row[i] = distribution(generator);
+		norm = orthogonalize(rows, index, row, coefficients.data());
+	}
+	matrix_kernel::scale(length, row, 1 / norm, row);
+}
+
+template <Elementable Element>
+Element PartialEigenDecomposition<Element>::tolerance()
+{
+	return std::pow(std::numeric_limits<Element>::epsilon(), Element(2) / 3);
+}
+
+template <Elementable Element>
+size_t PartialEigenDecomposition<Element>::wanted_count(const std::vector<std::complex<Element>>& ritz_values,
+		size_t k) noexcept
+{
+	return k < ritz_values.size() and ritz_values[k - 1].imag() > 0 ? k + 1 : k;
+}
+
+template <Elementable Element>
+size_t PartialEigenDecomposition<Element>::get_size() const noexcept
+{
+	return size;
+}
+
+template <Elementable Element>
+auto PartialEigenDecomposition<Element>::get_eigenvalues() const noexcept
+		-> const std::vector<std::complex<Element>>&
+{
+	return eigenvalues;
+}
+
+template <Elementable Element>
+std::vector<Element> PartialEigenDecomposition<Element>::get_real_eigenvalues() const
+{
+	std::vector<Element> result;
+	for (const std::complex<Element>& eigenvalue : eigenvalues)
+	{
+		if (eigenvalue.imag() == 0)
+			result.push_back(eigenvalue.real());
+	}
+	return result;
+}
+
+template <Elementable Element>
+auto PartialEigenDecomposition<Element>::get_eigenvectors() const -> std::vector<std::vector<std::complex<Element>>>
+{
+	using std::sqrt;
+	const size_t count = eigenvalues.size();
+	std::vector<std::vector<std::complex<Element>>> result(count, std::vector<std::complex<Element>>(size));
+	for (size_t j = 0; j < count; ++j)
+	{
+		std::vector<std::complex<Element>>& eigenvector = result[j];
+		const Element imaginary = eigenvalues[j].imag();
+		if (imaginary == 0)
+		{
+			for (size_t i = 0; i < size; ++i)
+				eigenvector[i] = vectors[j][i];
+		}
+		else
+		{
+			const size_t real_row = imaginary > 0 ? j : j - 1;
+			const Element sign = imaginary > 0 ? 1 : -1;
+			for (size_t i = 0; i < size; ++i)
+				eigenvector[i] = std::complex<Element>(vectors[real_row][i], sign * vectors[real_row + 1][i]);
+		}
+
+		Element norm_square = 0;
+		for (const std::complex<Element>& element : eigenvector)
+			norm_square += std::norm(element);
+		if (norm_square > 0)
+		{
+			const Element inverse_norm = 1 / sqrt(norm_square);
+			for (std::complex<Element>& element : eigenvector)
+				element *= inverse_norm;
+		}
+	}
+	return result;
+}
+
+template <Elementable Element>
+size_t PartialEigenDecomposition<Element>::get_number_of_matvec() const noexcept
+{
+	return number_of_matvec;
+}
+
+#endif
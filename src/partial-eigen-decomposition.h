@@ -0,0 +1,77 @@
+#ifndef MATRIX_PARTIAL_EIGEN_DECOMPOSITION_H
+#define MATRIX_PARTIAL_EIGEN_DECOMPOSITION_H
+
+#include <complex>
+#include <cstddef>
+#include <random>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+
+// The k eigenvalues of largest magnitude of an n x n operator that is only ever applied to vectors, so it may be a
+// dense matrix, a sparse one or an implicit product. Krylov iteration keeps a basis of a few times k vectors and
+// restarts on the wanted Ritz vectors (thick-restart Lanczos for symmetric operators, Krylov-Schur Arnoldi
+// otherwise); subspace iteration is block power iteration with a Rayleigh-Ritz step. Complex eigenvalues come in
+// conjugate pairs, positive imaginary part first, and a pair is never split, so k + 1 eigenpairs may be returned.
+template <Elementable Element>
+class PartialEigenDecomposition
+{
+public:
+	template <typename Operator>
+		requires LinearOperator<Operator, Element>
+	PartialEigenDecomposition(const Operator& apply, size_t size, size_t k, bool symmetric,
+			EigenSolverMethod method = EigenSolverMethod::krylov);
+
+	[[nodiscard]] size_t get_size() const noexcept;
+	// largest magnitude first
+	[[nodiscard]] const std::vector<std::complex<Element>>& get_eigenvalues() const noexcept;
+	// eigenvalues whose imaginary part is zero, in the same order
+	[[nodiscard]] std::vector<Element> get_real_eigenvalues() const;
+	// eigenvectors[j] belongs to get_eigenvalues()[j], scaled to unit 2-norm
+	[[nodiscard]] std::vector<std::vector<std::complex<Element>>> get_eigenvectors() const;
+	[[nodiscard]] size_t get_number_of_matvec() const noexcept;
+
+private:
+	static constexpr size_t MIN_EXTRA_BASIS_SIZE = 20;
+	static constexpr size_t MAX_RESTART = 1000;
+	static constexpr size_t MAX_SUBSPACE_ITERATION = 5000;
+
+	template <typename Operator>
+	void krylov_schur(const Operator& apply, size_t k);
+	template <typename Operator>
+	void subspace_iteration(const Operator& apply, size_t k);
+
+	// Ritz pairs of the projected matrix, largest magnitude first: row j of ritz_vectors holds the coordinates of
+	// Ritz vector j, or rows (j, j + 1) the real and imaginary parts of a complex pair
+	void rayleigh_ritz(const Matrix<Element>& projected, std::vector<std::complex<Element>>& ritz_values,
+			Matrix<Element>& ritz_vectors) const;
+	// eigenpairs [0, wanted) of the Ritz vectors in the coordinates of basis
+	void store(const std::vector<std::complex<Element>>& ritz_values, const Matrix<Element>& ritz_vectors,
+			const Matrix<Element>& basis, size_t basis_size, size_t wanted);
+
+	// w -= B^T * B * w over the first count rows of basis, twice (classical Gram-Schmidt with one
+	// reorthogonalization); the projections are added to coefficients and the norm of w is returned
+	[[nodiscard]] static Element orthogonalize(const Matrix<Element>& basis, size_t count, Element* w,
+			Element* coefficients);
+	// row index of rows becomes a unit vector orthogonal to the rows before it, replaced by a random direction when
+	// it lies in their span
+	void orthonormalize(Matrix<Element>& rows, size_t index);
+	void random_direction(Matrix<Element>& rows, size_t index);
+
+	[[nodiscard]] static Element tolerance();
+	[[nodiscard]] static size_t wanted_count(const std::vector<std::complex<Element>>& ritz_values, size_t k) noexcept;
+
+	size_t size;
+	bool symmetric;
+	std::vector<std::complex<Element>> eigenvalues;
+	// row j is a real eigenvector, or rows (j, j + 1) are the real and imaginary parts of a complex pair
+	Matrix<Element> vectors;
+	size_t number_of_matvec = 0;
+	std::mt19937 generator;
+};
+
+#include "partial-eigen-decomposition-tmp.h"
+
+#endif
@@ -1,7 +1,9 @@
 #ifndef MATRIX_POLYNOMIAL_TEMP_H
 #define MATRIX_POLYNOMIAL_TEMP_H
 
+#include <algorithm>
 #include <random>
+#include <stdexcept>
 
 #include "polynomial-helper.h"
 #include "polynomial.h"
@@ -126,15 +128,9 @@ template <typename OtherElement>
 	requires SumableDifferentType<Element, OtherElement>
 Polynomial<Element> Polynomial<Element>::sum(const Polynomial<OtherElement> &other) const
 {
-	Coefficient coefficient_of_result = coefficients;
-	for (size_t i = 0; i < other.coefficients.size(); i++)
-	{
-		if (i < coefficient_of_result.size())
-			coefficient_of_result[i] += other.coefficients[i];
-		else
-			coefficient_of_result.emplace_back(Element() + other.coefficients[i]);
-	}
-	return Polynomial(coefficient_of_result);
+	Polynomial result(*this);
+	result += other;
+	return result;
 }
 
 template <Polynomialable Element>
@@ -158,7 +154,11 @@ template <Polynomialable Element>
 template <typename OtherElement>
 Polynomial<Element> &Polynomial<Element>::operator+=(const Polynomial<OtherElement> &other)
 {
-	*this = sum(other);
+	const size_t other_size = other.coefficients.size();
+	if (coefficients.size() < other_size)
+		coefficients.resize(other_size, Element());
+	for (size_t i = 0; i < other_size; i++)
+		coefficients[i] += other.coefficients[i];
 	return *this;
 }
 
@@ -182,7 +182,9 @@ template <Polynomialable Element>
 template <typename OtherElement>
 Polynomial<Element> Polynomial<Element>::submission(const Polynomial<OtherElement> &other) const
 {
-	return sum(-other);
+	Polynomial result(*this);
+	result -= other;
+	return result;
 }
 
 template <Polynomialable Element>
@@ -206,7 +208,11 @@ template <Polynomialable Element>
 template <typename OtherElement>
 Polynomial<Element> &Polynomial<Element>::operator-=(const Polynomial<OtherElement> &other)
 {
-	*this = submission(other);
+	const size_t other_size = other.coefficients.size();
+	if (coefficients.size() < other_size)
+		coefficients.resize(other_size, Element());
+	for (size_t i = 0; i < other_size; i++)
+		coefficients[i] -= other.coefficients[i];
 	return *this;
 }
 
@@ -229,8 +235,7 @@ template <typename OtherElement>
 Polynomial<Element> Polynomial<Element>::operator*(const OtherElement &other) const
 {
 	Polynomial new_polynomial(*this);
-	for (auto &coeff : new_polynomial.coefficients)
-		coeff *= other;
+	new_polynomial *= other;
 	return new_polynomial;
 }
 
@@ -245,7 +250,8 @@ template <Polynomialable Element>
 template <typename OtherElement>
 inline Polynomial<Element> &Polynomial<Element>::operator*=(const OtherElement &other)
 {
-	*this = *this * other;
+	for (auto &coeff : coefficients)
+		coeff *= other;
 	return *this;
 }
 
@@ -253,7 +259,26 @@ template <Polynomialable Element>
 template <typename OtherElement>
 Polynomial<Element> &Polynomial<Element>::operator*=(const Polynomial<OtherElement> &other)
 {
-	*this = multiple(other);
+	const size_t size = coefficients.size();
+	const size_t other_size = other.coefficients.size();
+	if (size == 0 or other_size == 0)
+	{
+		coefficients.clear();
+		return *this;
+	}
+
+	// from the highest degree down, so coefficient k is written only after every coefficient it reads;
+	// this also makes p *= p safe
+	coefficients.resize(size + other_size - 1, Element());
+	for (size_t k = size + other_size - 1; k-- > 0;)
+	{
+		const size_t first = k < other_size ? 0 : k - other_size + 1;
+		const size_t last = std::min(k, size - 1);
+		Element coefficient = coefficients[first] * other.coefficients[k - first];
+		for (size_t i = first + 1; i <= last; i++)
+			coefficient += coefficients[i] * other.coefficients[k - i];
+		coefficients[k] = coefficient;
+	}
 	return *this;
 }
 
@@ -324,6 +349,47 @@ Polynomial<Element> &Polynomial<Element>::power_equal(uint64_t number)
 	return *this;
 }
 
+template <Polynomialable Element>
+Polynomial<Element> Polynomial<Element>::remainder(const Polynomial<Element>& divisor) const
+{
+	size_t degree = divisor.coefficients.size();
+	while (degree > 0 and divisor.coefficients[degree - 1] == Element(0))
+		--degree;
+	if (degree == 0)
+		throw std::invalid_argument("the divisor should not be zero!");
+	--degree;
+
+	const Element leading = divisor.coefficients[degree];
+	Coefficient result = coefficients;
+	for (size_t index = result.size(); index-- > degree;)
+	{
+		const Element quotient = result[index] / leading;
+		for (size_t i = 0; i < degree; ++i)
+			result[index - degree + i] -= quotient * divisor.coefficients[i];
+	}
+	result.resize(degree, Element(0));
+	return Polynomial(result);
+}
+
+template <Polynomialable Element>
+Polynomial<Element> Polynomial<Element>::power_modulo(uint64_t number, const Polynomial<Element>& divisor) const
+{
+	Polynomial result = Polynomial(Coefficient{Element(1)}).remainder(divisor);
+	// a constant divisor leaves no remainder to multiply
+	if (result.coefficients.empty())
+		return result;
+
+	Polynomial base = remainder(divisor);
+	for (; number > 0; number >>= 1)
+	{
+		if (number & 1)
+			result = (result * base).remainder(divisor);
+		if (number > 1)
+			base = (base * base).remainder(divisor);
+	}
+	return result;
+}
+
 template <Polynomialable Element>
 Polynomial<Element> Polynomial<Element>::derivative() const
 {
@@ -380,4 +446,24 @@ constexpr Polynomial<OtherElement> operator*(const OtherElement &other, const Po
 	return other_polynomial * polynomial;
 }
 
+template <Polynomialable Element, typename OtherElement>
+Polynomial<Element> operator+(Polynomial<Element> &&polynomial, const Polynomial<OtherElement> &other)
+{
+	polynomial += other;
+	return std::move(polynomial);
+}
+
+template <Polynomialable Element, typename OtherElement>
+Polynomial<Element> operator-(Polynomial<Element> &&polynomial, const Polynomial<OtherElement> &other)
+{
+	polynomial -= other;
+	return std::move(polynomial);
+}
+
+template <Polynomialable Element, typename OtherElement>
+Polynomial<Element> operator*(Polynomial<Element> &&polynomial, const Polynomial<OtherElement> &other)
+{
+	polynomial *= other;
+	return std::move(polynomial);
+}
 #endif
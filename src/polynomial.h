@@ -75,6 +75,12 @@ public:
 	[[nodiscard]] Polynomial<Element> power(uint64_t number) const;
 	Polynomial<Element>& power_equal(uint64_t number);
 
+	// remainder of the long division by divisor, padded with zeros to exactly deg(divisor) coefficients; it is exact
+	// for integer coefficients when divisor is monic
+	[[nodiscard]] Polynomial<Element> remainder(const Polynomial<Element>& divisor) const;
+	// this^number mod divisor by repeated squaring, every intermediate product stays below 2 * deg(divisor)
+	[[nodiscard]] Polynomial<Element> power_modulo(uint64_t number, const Polynomial<Element>& divisor) const;
+
 	[[nodiscard]] Polynomial<Element> derivative() const;
 	Polynomial<Element>& derivative_equal();
 
@@ -111,6 +117,16 @@ template <typename Element, typename OtherElement>
 	requires MultiplableDifferentTypeReturnSecondType<Element, OtherElement> and Polynomialable<OtherElement>
 constexpr Polynomial<OtherElement> operator*(const OtherElement& other, const Polynomial<Element>& polynomial);
 
+// a temporary on the left is updated in place and returned instead of building a new polynomial
+template <Polynomialable Element, typename OtherElement>
+Polynomial<Element> operator+(Polynomial<Element>&& polynomial, const Polynomial<OtherElement>& other);
+
+template <Polynomialable Element, typename OtherElement>
+Polynomial<Element> operator-(Polynomial<Element>&& polynomial, const Polynomial<OtherElement>& other);
+
+template <Polynomialable Element, typename OtherElement>
+Polynomial<Element> operator*(Polynomial<Element>&& polynomial, const Polynomial<OtherElement>& other);
+
 #include "polynomial-tmp.h"
 
 #endif
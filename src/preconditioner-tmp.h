@@ -0,0 +1,201 @@
+#ifndef MATRIX_PRECONDITIONER_TMP_H
+#define MATRIX_PRECONDITIONER_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "preconditioner.h"
+
+template <Elementable Element>
+IdentityPreconditioner<Element>::IdentityPreconditioner(size_t size)
+: size(size)
+{
+}
+
+template <Elementable Element>
+void IdentityPreconditioner<Element>::operator()(const Element* r, Element* z) const
+{
+	std::copy_n(r, size, z);
+}
+
+template <Elementable Element>
+JacobiPreconditioner<Element>::JacobiPreconditioner(const SparseMatrix<Element>& matrix)
+: inverse_diagonal(matrix.get_number_of_row())
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	for (size_t i = 0; i < inverse_diagonal.size(); ++i)
+	{
+		const Element diagonal = matrix.at(i, i);
+		if (diagonal == Element(0))
+			throw std::invalid_argument("the diagonal should not contain zero!");
+		inverse_diagonal[i] = Element(1) / diagonal;
+	}
+}
+
+template <Elementable Element>
+JacobiPreconditioner<Element>::JacobiPreconditioner(const Matrix<Element>& matrix)
+: inverse_diagonal(matrix.get_number_of_row())
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	for (size_t i = 0; i < inverse_diagonal.size(); ++i)
+	{
+		const Element diagonal = matrix[i][i];
+		if (diagonal == Element(0))
+			throw std::invalid_argument("the diagonal should not contain zero!");
+		inverse_diagonal[i] = Element(1) / diagonal;
+	}
+}
+
+template <Elementable Element>
+void JacobiPreconditioner<Element>::operator()(const Element* r, Element* z) const
+{
+	for (size_t i = 0; i < inverse_diagonal.size(); ++i)
+		z[i] = r[i] * inverse_diagonal[i];
+}
+
+template <Elementable Element>
+IncompleteLUPreconditioner<Element>::IncompleteLUPreconditioner(const SparseMatrix<Element>& matrix)
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	const SparseMatrix<Element> csr = matrix.to_format(SparseFormat::csr);
+	const size_t size = csr.get_number_of_row();
+	offsets = csr.get_offsets();
+	indices = csr.get_indices();
+	values = csr.get_values();
+	diagonal.resize(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		const auto first = indices.begin() + static_cast<std::ptrdiff_t>(offsets[i]);
+		const auto last = indices.begin() + static_cast<std::ptrdiff_t>(offsets[i + 1]);
+		const auto position = std::lower_bound(first, last, i);
+		if (position == last or *position != i)
+			throw std::invalid_argument("the diagonal should not contain zero!");
+		diagonal[i] = static_cast<size_t>(position - indices.begin());
+	}
+
+	// IKJ Gaussian elimination that drops every update falling outside the pattern of row i
+	constexpr size_t NOT_IN_ROW = std::numeric_limits<size_t>::max();
+	std::vector<size_t> position_in_row(size, NOT_IN_ROW);
+	for (size_t i = 0; i < size; ++i)
+	{
+		for (size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+			position_in_row[indices[k]] = k;
+
+		for (size_t k = offsets[i]; k < diagonal[i]; ++k)
+		{
+			const size_t pivot_row = indices[k];
+			values[k] /= values[diagonal[pivot_row]];
+			for (size_t j = diagonal[pivot_row] + 1; j < offsets[pivot_row + 1]; ++j)
+			{
+				if (position_in_row[indices[j]] != NOT_IN_ROW)
+					values[position_in_row[indices[j]]] -= values[k] * values[j];
+			}
+		}
+		if (values[diagonal[i]] == Element(0))
+			throw std::invalid_argument("the matrix should have a non-zero pivot at every step!");
+
+		for (size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+			position_in_row[indices[k]] = NOT_IN_ROW;
+	}
+}
+
+template <Elementable Element>
+void IncompleteLUPreconditioner<Element>::operator()(const Element* r, Element* z) const
+{
+	const size_t size = diagonal.size();
+	for (size_t i = 0; i < size; ++i)
+	{
+		Element sum = r[i];
+		for (size_t k = offsets[i]; k < diagonal[i]; ++k)
+			sum -= values[k] * z[indices[k]];
+		z[i] = sum;
+	}
+	for (size_t i = size; i-- > 0;)
+	{
+		Element sum = z[i];
+		for (size_t k = diagonal[i] + 1; k < offsets[i + 1]; ++k)
+			sum -= values[k] * z[indices[k]];
+		z[i] = sum / values[diagonal[i]];
+	}
+}
+
+template <Elementable Element>
+IncompleteCholeskyPreconditioner<Element>::IncompleteCholeskyPreconditioner(const SparseMatrix<Element>& matrix)
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	// only the lower triangle of A is read
+	const SparseMatrix<Element> csr = matrix.to_format(SparseFormat::csr);
+	const size_t size = csr.get_number_of_row();
+	offsets.assign(1, 0);
+	for (size_t i = 0; i < size; ++i)
+	{
+		for (size_t k = csr.get_offsets()[i]; k < csr.get_offsets()[i + 1] and csr.get_indices()[k] <= i; ++k)
+		{
+			indices.push_back(csr.get_indices()[k]);
+			values.push_back(csr.get_values()[k]);
+		}
+		if (indices.size() == offsets.back() or indices.back() != i)
+			throw std::invalid_argument("the matrix should be positive definite!");
+		offsets.push_back(indices.size());
+	}
+
+	// L[i][j] = (A[i][j] - sum over c < j of L[i][c] * L[j][c]) / L[j][j], kept only where A[i][j] is stored
+	for (size_t i = 0; i < size; ++i)
+	{
+		for (size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+		{
+			const size_t j = indices[k];
+			Element sum = values[k];
+			size_t left = offsets[i];
+			size_t right = offsets[j];
+			while (left < k and right + 1 < offsets[j + 1])
+			{
+				if (indices[left] < indices[right])
+					++left;
+				else if (indices[right] < indices[left])
+					++right;
+				else
+					sum -= values[left++] * values[right++];
+			}
+
+			if (j < i)
+				values[k] = sum / values[offsets[j + 1] - 1];
+			else if (sum <= Element(0))
+				throw std::invalid_argument("the matrix should be positive definite!");
+			else
+				values[k] = std::sqrt(sum);
+		}
+	}
+}
+
+template <Elementable Element>
+void IncompleteCholeskyPreconditioner<Element>::operator()(const Element* r, Element* z) const
+{
+	const size_t size = offsets.size() - 1;
+	for (size_t i = 0; i < size; ++i)
+	{
+		Element sum = r[i];
+		for (size_t k = offsets[i]; k + 1 < offsets[i + 1]; ++k)
+			sum -= values[k] * z[indices[k]];
+		z[i] = sum / values[offsets[i + 1] - 1];
+	}
+	// L^T walks the rows of L as columns
+	for (size_t i = size; i-- > 0;)
+	{
+		z[i] /= values[offsets[i + 1] - 1];
+		for (size_t k = offsets[i]; k + 1 < offsets[i + 1]; ++k)
+			z[indices[k]] -= values[k] * z[i];
+	}
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef MATRIX_PRECONDITIONER_H
+#define MATRIX_PRECONDITIONER_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "sparse-matrix.h"
+
+// Every preconditioner is a LinearOperator computing z = M^-1 * r for some M close to A that is cheap to solve with.
+
+// M = I
+template <Elementable Element>
+class IdentityPreconditioner
+{
+public:
+	IdentityPreconditioner() = default;
+	explicit IdentityPreconditioner(size_t size);
+
+	void operator()(const Element* r, Element* z) const;
+
+private:
+	size_t size = 0;
+};
+
+// M = diag(A)
+template <Elementable Element>
+class JacobiPreconditioner
+{
+public:
+	explicit JacobiPreconditioner(const SparseMatrix<Element>& matrix);
+	explicit JacobiPreconditioner(const Matrix<Element>& matrix);
+
+	void operator()(const Element* r, Element* z) const;
+
+private:
+	std::vector<Element> inverse_diagonal;
+};
+
+// ILU(0): M = L * U with unit lower L and upper U restricted to the non-zero pattern of A
+template <Elementable Element>
+class IncompleteLUPreconditioner
+{
+public:
+	explicit IncompleteLUPreconditioner(const SparseMatrix<Element>& matrix);
+
+	void operator()(const Element* r, Element* z) const;
+
+private:
+	// L without its unit diagonal and U share the CSR pattern of A
+	std::vector<size_t> offsets;
+	std::vector<size_t> indices;
+	std::vector<Element> values;
+	// position of the diagonal entry of every row
+	std::vector<size_t> diagonal;
+};
+
+// IC(0): M = L * L^T with L restricted to the pattern of the lower triangle of a symmetric positive definite A
+template <Elementable Element>
+class IncompleteCholeskyPreconditioner
+{
+public:
+	explicit IncompleteCholeskyPreconditioner(const SparseMatrix<Element>& matrix);
+
+	void operator()(const Element* r, Element* z) const;
+
+private:
+	// CSR pattern of the lower triangle of A, the diagonal is the last entry of every row
+	std::vector<size_t> offsets;
+	std::vector<size_t> indices;
+	std::vector<Element> values;
+};
+
+#include "preconditioner-tmp.h"
+
+#endif
@@ -0,0 +1,392 @@
+#ifndef MATRIX_SPARSE_DIRECT_SOLVER_TMP_H
+#define MATRIX_SPARSE_DIRECT_SOLVER_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+#include "sparse-direct-solver.h"
+
+template <Elementable Element>
+SparseDirectSolver<Element>::SparseDirectSolver(const SparseMatrix<Element>& matrix,
+		SparseFactorization factorization, SparseOrdering ordering)
+: SparseDirectSolver(SparseSymbolicAnalysis(matrix, ordering), matrix, factorization)
+{
+}
+
+template <Elementable Element>
+SparseDirectSolver<Element>::SparseDirectSolver(SparseSymbolicAnalysis symbolic, const SparseMatrix<Element>& matrix,
+		SparseFactorization factorization)
+: symbolic(std::move(symbolic))
+, factorization(factorization)
+{
+	const size_t number_of_supernode = this->symbolic.get_number_of_supernode();
+	factor_offsets.assign(1, 0);
+	for (size_t s = 0; s < number_of_supernode; ++s)
+	{
+		const size_t number_of_col = this->symbolic.first_column[s + 1] - this->symbolic.first_column[s];
+		const size_t number_of_row = this->symbolic.row_offsets[s + 1] - this->symbolic.row_offsets[s];
+		// LU keeps the pivot rows whole as well as the pivot columns
+		const size_t number_of_entry = factorization == SparseFactorization::cholesky
+				? number_of_col * number_of_row
+				: number_of_col * number_of_row + (number_of_row - number_of_col) * number_of_col;
+		factor_offsets.push_back(factor_offsets.back() + number_of_entry);
+	}
+	factor.resize(factor_offsets.back());
+	if (factorization == SparseFactorization::lu)
+		row_swaps.resize(this->symbolic.get_size());
+	contributions.resize(number_of_supernode);
+
+	refactorize(matrix);
+}
+
+template <Elementable Element>
+void SparseDirectSolver<Element>::refactorize(const SparseMatrix<Element>& matrix)
+{
+	const size_t size = symbolic.get_size();
+	if (matrix.get_number_of_row() != size or matrix.get_number_of_col() != size)
+		throw std::invalid_argument("the matrix should have the size of the symbolic analysis!");
+
+	// Every entry belongs to the supernode of its first pivot, where both its row and its column are in the front.
+	// Counting sort by supernode, then the positions are found by binary search in the sorted rows of the front.
+	const size_t number_of_supernode = symbolic.get_number_of_supernode();
+	const std::vector<size_t>& offsets = matrix.get_offsets();
+	const std::vector<size_t>& indices = matrix.get_indices();
+	const std::vector<Element>& values = matrix.get_values();
+	const bool is_csr = matrix.get_format() == SparseFormat::csr;
+	const auto for_each_entry = [&](auto&& function)
+	{
+		for (size_t major = 0; major < size; ++major)
+		{
+			for (size_t k = offsets[major]; k < offsets[major + 1]; ++k)
+			{
+				const size_t row = is_csr ? major : indices[k];
+				const size_t col = is_csr ? indices[k] : major;
+				// Cholesky reads the lower triangle only
+				if (factorization == SparseFactorization::cholesky and row < col)
+					continue;
+				const size_t permuted_row = symbolic.inverse_permutation[row];
+				const size_t permuted_col = symbolic.inverse_permutation[col];
+				function(permuted_row, permuted_col, values[k]);
+			}
+		}
+	};
+
+	entry_offsets.assign(number_of_supernode + 1, 0);
+	for_each_entry([&](size_t row, size_t col, const Element&)
+	{
+		++entry_offsets[symbolic.column_to_supernode[std::min(row, col)] + 1];
+	});
+	for (size_t s = 0; s < number_of_supernode; ++s)
+		entry_offsets[s + 1] += entry_offsets[s];
+	entry_positions.resize(entry_offsets.back());
+	entry_values.resize(entry_offsets.back());
+	std::vector<size_t> next = entry_offsets;
+	for_each_entry([&](size_t row, size_t col, const Element& value)
+	{
+		// the lower triangle of P * A * P^T for Cholesky
+		if (factorization == SparseFactorization::cholesky and row < col)
+			std::swap(row, col);
+		const size_t s = symbolic.column_to_supernode[std::min(row, col)];
+		const auto first = symbolic.rows.begin() + static_cast<std::ptrdiff_t>(symbolic.row_offsets[s]);
+		const auto last = symbolic.rows.begin() + static_cast<std::ptrdiff_t>(symbolic.row_offsets[s + 1]);
+		const auto local_row = std::lower_bound(first, last, row);
+		const auto local_col = std::lower_bound(first, last, col);
+		if (local_row == last or *local_row != row or local_col == last or *local_col != col)
+			throw std::invalid_argument("the matrix should have the pattern of the symbolic analysis!");
+		const size_t number_of_row = symbolic.row_offsets[s + 1] - symbolic.row_offsets[s];
+		entry_positions[next[s]] = static_cast<size_t>(local_row - first) * number_of_row
+				+ static_cast<size_t>(local_col - first);
+		entry_values[next[s]++] = value;
+	});
+
+	// children come before their parent in the postorder, so their update blocks are ready when it is assembled
+	size_t max_number_of_row = 0;
+	for (size_t s = 0; s < number_of_supernode; ++s)
+		max_number_of_row = std::max(max_number_of_row, symbolic.row_offsets[s + 1] - symbolic.row_offsets[s]);
+	std::vector<Element> front(max_number_of_row * max_number_of_row);
+	for (size_t s = 0; s < number_of_supernode; ++s)
+	{
+		const size_t number_of_col = symbolic.first_column[s + 1] - symbolic.first_column[s];
+		const size_t number_of_row = symbolic.row_offsets[s + 1] - symbolic.row_offsets[s];
+		assemble(s, front.data());
+
+		Element* block = factor.data() + factor_offsets[s];
+		if (factorization == SparseFactorization::cholesky)
+		{
+			factorize_cholesky(number_of_col, number_of_row, front.data());
+			for (size_t i = 0; i < number_of_row; ++i)
+				std::copy_n(front.data() + i * number_of_row, number_of_col, block + i * number_of_col);
+		}
+		else
+		{
+			factorize_lu(s, number_of_col, number_of_row, front.data());
+			std::copy_n(front.data(), number_of_col * number_of_row, block);
+			block += number_of_col * number_of_row;
+			for (size_t i = number_of_col; i < number_of_row; ++i)
+			{
+				std::copy_n(front.data() + i * number_of_row, number_of_col,
+						block + (i - number_of_col) * number_of_col);
+			}
+		}
+
+		const size_t update_size = number_of_row - number_of_col;
+		std::vector<Element>& contribution = contributions[s];
+		contribution.resize(update_size * update_size);
+		for (size_t i = 0; i < update_size; ++i)
+		{
+			std::copy_n(front.data() + (number_of_col + i) * number_of_row + number_of_col, update_size,
+					contribution.data() + i * update_size);
+		}
+	}
+}
+
+template <Elementable Element>
+void SparseDirectSolver<Element>::assemble(size_t s, Element* front)
+{
+	const size_t first_row = symbolic.row_offsets[s];
+	const size_t number_of_row = symbolic.row_offsets[s + 1] - first_row;
+	std::fill_n(front, number_of_row * number_of_row, Element(0));
+	for (size_t k = entry_offsets[s]; k < entry_offsets[s + 1]; ++k)
+		front[entry_positions[k]] += entry_values[k];
+
+	// extend-add: the rows of a child's update block are a sorted subset of the rows of the front
+	std::vector<size_t> relative;
+	for (size_t c = symbolic.child_offsets[s]; c < symbolic.child_offsets[s + 1]; ++c)
+	{
+		const size_t child = symbolic.child_supernodes[c];
+		const size_t child_number_of_col = symbolic.first_column[child + 1] - symbolic.first_column[child];
+		const size_t update_begin = symbolic.row_offsets[child] + child_number_of_col;
+		const size_t update_size = symbolic.row_offsets[child + 1] - update_begin;
+		relative.resize(update_size);
+		size_t position = 0;
+		for (size_t i = 0; i < update_size; ++i)
+		{
+			while (symbolic.rows[first_row + position] != symbolic.rows[update_begin + i])
+				++position;
+			relative[i] = position;
+		}
+
+		const std::vector<Element>& contribution = contributions[child];
+		for (size_t i = 0; i < update_size; ++i)
+		{
+			Element* front_row = front + relative[i] * number_of_row;
+			const Element* update_row = contribution.data() + i * update_size;
+			const size_t number_of_update_col = factorization == SparseFactorization::cholesky ? i + 1 : update_size;
+			for (size_t j = 0; j < number_of_update_col; ++j)
+				front_row[relative[j]] += update_row[j];
+		}
+		std::vector<Element>().swap(contributions[child]);
+	}
+}
+
+template <Elementable Element>
+void SparseDirectSolver<Element>::factorize_cholesky(size_t number_of_col, size_t number_of_row, Element* front)
+{
+	using std::sqrt;
+
+	// L[i][j] = (F[i][j] - L[i][0:j] . L[j][0:j]) / L[j][j] over the pivot columns, as the dense Cholesky panel
+	const auto eliminate_row = [&](Element* row, size_t last_col)
+	{
+		for (size_t j = 0; j < last_col; ++j)
+		{
+			const Element* pivot_row = front + j * number_of_row;
+			row[j] = (row[j] - matrix_kernel::dot(j, row, pivot_row)) / pivot_row[j];
+		}
+	};
+	for (size_t i = 0; i < number_of_col; ++i)
+	{
+		Element* row = front + i * number_of_row;
+		eliminate_row(row, i);
+		const Element pivot = row[i] - matrix_kernel::dot(i, row, row);
+		if (not(pivot > 0))
+			throw std::invalid_argument("the matrix should be positive definite!");
+		row[i] = sqrt(pivot);
+	}
+	matrix_helper::parallel_for(number_of_row - number_of_col, number_of_col * number_of_col,
+			[&](size_t begin, size_t end)
+	{
+		for (size_t i = number_of_col + begin; i < number_of_col + end; ++i)
+			eliminate_row(front + i * number_of_row, number_of_col);
+	});
+
+	// update block -= L21 * L21^T
+	if (number_of_row > number_of_col)
+	{
+		const Element* lower_panel = front + number_of_col * number_of_row;
+		matrix_kernel::syrk_lower(number_of_row - number_of_col, number_of_col, lower_panel, number_of_row,
+				lower_panel, number_of_row, front + number_of_col * number_of_row + number_of_col, number_of_row);
+	}
+}
+
+template <Elementable Element>
+void SparseDirectSolver<Element>::factorize_lu(size_t s, size_t number_of_col, size_t number_of_row, Element* front)
+{
+	// right-looking elimination of the pivot columns over every row of the front, pivots taken from the fully
+	// assembled rows only since the others still wait for updates from outside this subtree
+	const size_t first = symbolic.first_column[s];
+	for (size_t j = 0; j < number_of_col; ++j)
+	{
+		size_t pivot_index = j;
+		for (size_t i = j + 1; i < number_of_col; ++i)
+		{
+			if (matrix_helper::is_better_pivot(front[i * number_of_row + j], front[pivot_index * number_of_row + j]))
+				pivot_index = i;
+		}
+		if (front[pivot_index * number_of_row + j] == Element(0))
+			throw std::invalid_argument("the matrix should have a non-zero pivot at every step!");
+		row_swaps[first + j] = pivot_index;
+		if (pivot_index != j)
+		{
+			std::swap_ranges(front + j * number_of_row, front + (j + 1) * number_of_row,
+					front + pivot_index * number_of_row);
+		}
+
+		const Element* pivot_row = front + j * number_of_row;
+		matrix_helper::parallel_for(number_of_row - j - 1, number_of_col - j, [&](size_t begin, size_t end)
+		{
+			for (size_t i = j + 1 + begin; i < j + 1 + end; ++i)
+			{
+				Element* row = front + i * number_of_row;
+				row[j] /= pivot_row[j];
+				matrix_kernel::axpy(number_of_col - j - 1, -row[j], pivot_row + j + 1, row + j + 1);
+			}
+		});
+	}
+
+	// U12 = L11^-1 * F12, then update block -= L21 * U12
+	if (number_of_row > number_of_col)
+	{
+		const size_t update_size = number_of_row - number_of_col;
+		matrix_kernel::trsm_lower(number_of_col, update_size, front, number_of_row, true, front + number_of_col,
+				number_of_row);
+		std::vector<Element> negative_lower(update_size * number_of_col);
+		for (size_t i = 0; i < update_size; ++i)
+		{
+			const Element* row = front + (number_of_col + i) * number_of_row;
+			for (size_t j = 0; j < number_of_col; ++j)
+				negative_lower[i * number_of_col + j] = -row[j];
+		}
+		matrix_kernel::gemm(update_size, update_size, number_of_col, negative_lower.data(), number_of_col,
+				front + number_of_col, number_of_row, front + number_of_col * number_of_row + number_of_col,
+				number_of_row);
+	}
+}
+
+template <Elementable Element>
+void SparseDirectSolver<Element>::substitute(Element* x) const
+{
+	const size_t number_of_supernode = symbolic.get_number_of_supernode();
+	const bool is_cholesky = factorization == SparseFactorization::cholesky;
+	std::vector<Element> below;
+
+	// L * y = x, supernode by supernode: the pivot block, then its rows below
+	for (size_t s = 0; s < number_of_supernode; ++s)
+	{
+		const size_t first = symbolic.first_column[s];
+		const size_t number_of_col = symbolic.first_column[s + 1] - first;
+		const size_t number_of_row = symbolic.row_offsets[s + 1] - symbolic.row_offsets[s];
+		const size_t* row_indices = symbolic.rows.data() + symbolic.row_offsets[s];
+		const Element* block = factor.data() + factor_offsets[s];
+		const Element* lower_below = block + number_of_col * (is_cholesky ? number_of_col : number_of_row);
+		if (is_cholesky)
+			matrix_kernel::trsm_lower(number_of_col, 1, block, number_of_col, false, x + first, 1);
+		else
+		{
+			for (size_t j = 0; j < number_of_col; ++j)
+				std::swap(x[first + j], x[first + row_swaps[first + j]]);
+			matrix_kernel::trsm_lower(number_of_col, 1, block, number_of_row, true, x + first, 1);
+		}
+		for (size_t i = number_of_col; i < number_of_row; ++i)
+		{
+			x[row_indices[i]] -= matrix_kernel::dot(number_of_col, lower_below + (i - number_of_col) * number_of_col,
+					x + first);
+		}
+	}
+
+	// L^T * x = y or U * x = y in reverse
+	for (size_t s = number_of_supernode; s-- > 0;)
+	{
+		const size_t first = symbolic.first_column[s];
+		const size_t number_of_col = symbolic.first_column[s + 1] - first;
+		const size_t number_of_row = symbolic.row_offsets[s + 1] - symbolic.row_offsets[s];
+		const size_t* row_indices = symbolic.rows.data() + symbolic.row_offsets[s];
+		const Element* block = factor.data() + factor_offsets[s];
+		if (is_cholesky)
+		{
+			for (size_t i = number_of_col; i < number_of_row; ++i)
+				matrix_kernel::axpy(number_of_col, -x[row_indices[i]], block + i * number_of_col, x + first);
+			matrix_kernel::trsm_lower_transpose(number_of_col, 1, block, number_of_col, false, x + first, 1);
+		}
+		else
+		{
+			const size_t update_size = number_of_row - number_of_col;
+			below.resize(update_size);
+			for (size_t i = 0; i < update_size; ++i)
+				below[i] = x[row_indices[number_of_col + i]];
+			for (size_t j = 0; j < number_of_col; ++j)
+				x[first + j] -=
+						matrix_kernel::dot(update_size, block + j * number_of_row + number_of_col, below.data());
+			matrix_kernel::trsm_upper(number_of_col, 1, block, number_of_row, false, x + first, 1);
+		}
+	}
+}
+
+template <Elementable Element>
+const SparseSymbolicAnalysis& SparseDirectSolver<Element>::get_symbolic() const noexcept
+{
+	return symbolic;
+}
+
+template <Elementable Element>
+SparseFactorization SparseDirectSolver<Element>::get_factorization() const noexcept
+{
+	return factorization;
+}
+
+template <Elementable Element>
+Matrix<Element> SparseDirectSolver<Element>::solve(const Matrix<Element>& b) const
+{
+	const size_t size = symbolic.get_size();
+	if (b.get_number_of_row() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+
+	Matrix<Element> x(size, b.get_number_of_col());
+	const auto x_rows = x.mutable_rows();
+	const size_t number_of_rhs = b.get_number_of_col();
+	matrix_helper::parallel_for(number_of_rhs, factor.size(), [&](size_t begin, size_t end)
+	{
+		std::vector<Element> permuted(size);
+		for (size_t j = begin; j < end; ++j)
+		{
+			for (size_t k = 0; k < size; ++k)
+				permuted[k] = b.row_data(symbolic.permutation[k])[j];
+			substitute(permuted.data());
+			for (size_t k = 0; k < size; ++k)
+				x_rows.row_data(symbolic.permutation[k])[j] = permuted[k];
+		}
+	});
+	return x;
+}
+
+template <Elementable Element>
+std::vector<Element> SparseDirectSolver<Element>::solve(const std::vector<Element>& b) const
+{
+	const size_t size = symbolic.get_size();
+	if (b.size() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+
+	std::vector<Element> permuted(size);
+	for (size_t k = 0; k < size; ++k)
+		permuted[k] = b[symbolic.permutation[k]];
+	substitute(permuted.data());
+	std::vector<Element> x(size);
+	for (size_t k = 0; k < size; ++k)
+		x[symbolic.permutation[k]] = permuted[k];
+	return x;
+}
+
+#endif
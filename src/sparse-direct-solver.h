@@ -0,0 +1,74 @@
+#ifndef MATRIX_SPARSE_DIRECT_SOLVER_H
+#define MATRIX_SPARSE_DIRECT_SOLVER_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+#include "sparse-matrix.h"
+#include "sparse-symbolic-analysis.h"
+
+enum class SparseFactorization
+{
+	// P * A * P^T = L * L^T for a symmetric positive definite A, only its lower triangle is read
+	cholesky,
+	// P * A * P^T = L * U, pivoting by rows inside every supernode
+	lu,
+};
+
+// Multifrontal factorization over the supernodes of a SparseSymbolicAnalysis: every supernode assembles the entries of
+// A it owns and the update blocks of its children into a dense front, factors its pivot columns and hands its own
+// update block to its parent, so the bulk of the work is dense GEMM on the fronts. A matrix with the same pattern, say
+// every step of a time loop, is refactorized without redoing the analysis or reallocating the factor. LU pivots are
+// searched among the fully assembled rows of a front only; a matrix that needs pivots from elsewhere is reported as
+// singular.
+template <Elementable Element>
+class SparseDirectSolver
+{
+public:
+	SparseDirectSolver(const SparseMatrix<Element>& matrix, SparseFactorization factorization,
+			SparseOrdering ordering = SparseOrdering::approximate_minimum_degree);
+	SparseDirectSolver(SparseSymbolicAnalysis symbolic, const SparseMatrix<Element>& matrix,
+			SparseFactorization factorization);
+
+	// new values on the analysed pattern
+	void refactorize(const SparseMatrix<Element>& matrix);
+
+	[[nodiscard]] const SparseSymbolicAnalysis& get_symbolic() const noexcept;
+	[[nodiscard]] SparseFactorization get_factorization() const noexcept;
+
+	// A * X = B for every column of B
+	[[nodiscard]] Matrix<Element> solve(const Matrix<Element>& b) const;
+	[[nodiscard]] std::vector<Element> solve(const std::vector<Element>& b) const;
+
+private:
+	// dense front of supernode s, row-major with its rows as leading dimension
+	void assemble(size_t s, Element* front);
+	void factorize_cholesky(size_t number_of_col, size_t number_of_row, Element* front);
+	void factorize_lu(size_t s, size_t number_of_col, size_t number_of_row, Element* front);
+
+	// x = (P * A * P^T)^-1 * x
+	void substitute(Element* x) const;
+
+	SparseSymbolicAnalysis symbolic;
+	SparseFactorization factorization;
+
+	// entries of P * A * P^T owned by every supernode, as positions in its front
+	std::vector<size_t> entry_offsets;
+	std::vector<size_t> entry_positions;
+	std::vector<Element> entry_values;
+
+	// Cholesky: L of supernode s, its rows x its columns. LU: its pivot rows of [L11 \ U11, U12], then the rows of L21.
+	std::vector<size_t> factor_offsets;
+	std::vector<Element> factor;
+	// LU: pivot k was swapped with row first_column + row_swaps[k] of its front
+	std::vector<size_t> row_swaps;
+	// update block of every supernode until its parent is assembled
+	std::vector<std::vector<Element>> contributions;
+};
+
+#include "sparse-direct-solver-tmp.h"
+
+#endif
@@ -0,0 +1,493 @@
+#ifndef MATRIX_SPARSE_MATRIX_TMP_H
+#define MATRIX_SPARSE_MATRIX_TMP_H
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+#include "sparse-matrix.h"
+#include "thread-pool.h"
+
+template <Elementable Element>
+SparseMatrix<Element>::SparseMatrix(size_t row, size_t col, SparseFormat format)
+: number_of_row(row)
+, number_of_col(col)
+, format(format)
+, offsets(get_major_size() + 1, 0)
+{
+}
+
+template <Elementable Element>
+SparseMatrix<Element>::SparseMatrix(const Matrix<Element>& matrix, SparseFormat format)
+: SparseMatrix(matrix.get_number_of_row(), matrix.get_number_of_col())
+{
+	// rows are counted, then copied, each in parallel
+	std::vector<size_t> counts(number_of_row);
+	matrix_helper::parallel_for(number_of_row, number_of_col, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = begin; row_index < end; ++row_index)
+		{
+			const Element* row = matrix.row_data(row_index);
+			counts[row_index] = static_cast<size_t>(
+					std::count_if(row, row + number_of_col, [](const Element& value) { return value != Element(0); }));
+		}
+	});
+	std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+
+	indices.resize(offsets.back());
+	values.resize(offsets.back());
+	matrix_helper::parallel_for(number_of_row, number_of_col, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = begin; row_index < end; ++row_index)
+		{
+			const Element* row = matrix.row_data(row_index);
+			size_t position = offsets[row_index];
+			for (size_t col_index = 0; col_index < number_of_col; ++col_index)
+			{
+				if (row[col_index] == Element(0))
+					continue;
+				indices[position] = col_index;
+				values[position] = row[col_index];
+				++position;
+			}
+		}
+	});
+
+	if (format != SparseFormat::csr)
+		*this = to_format(format);
+}
+
+template <Elementable Element>
+size_t SparseMatrix<Element>::get_number_of_row() const noexcept
+{
+	return number_of_row;
+}
+
+template <Elementable Element>
+size_t SparseMatrix<Element>::get_number_of_col() const noexcept
+{
+	return number_of_col;
+}
+
+template <Elementable Element>
+size_t SparseMatrix<Element>::get_number_of_nonzero() const noexcept
+{
+	return values.size();
+}
+
+template <Elementable Element>
+SparseFormat SparseMatrix<Element>::get_format() const noexcept
+{
+	return format;
+}
+
+template <Elementable Element>
+const std::vector<size_t>& SparseMatrix<Element>::get_offsets() const noexcept
+{
+	return offsets;
+}
+
+template <Elementable Element>
+const std::vector<size_t>& SparseMatrix<Element>::get_indices() const noexcept
+{
+	return indices;
+}
+
+template <Elementable Element>
+const std::vector<Element>& SparseMatrix<Element>::get_values() const noexcept
+{
+	return values;
+}
+
+template <Elementable Element>
+size_t SparseMatrix<Element>::get_major_size() const noexcept
+{
+	return format == SparseFormat::csr ? number_of_row : number_of_col;
+}
+
+template <Elementable Element>
+size_t SparseMatrix<Element>::get_minor_size() const noexcept
+{
+	return format == SparseFormat::csr ? number_of_col : number_of_row;
+}
+
+template <Elementable Element>
+Element SparseMatrix<Element>::at(size_t row_index, size_t col_index) const
+{
+	if (row_index >= number_of_row or col_index >= number_of_col)
+		throw std::out_of_range("the index is out of the matrix!");
+
+	const size_t major = format == SparseFormat::csr ? row_index : col_index;
+	const size_t minor = format == SparseFormat::csr ? col_index : row_index;
+	const auto first = indices.begin() + static_cast<std::ptrdiff_t>(offsets[major]);
+	const auto last = indices.begin() + static_cast<std::ptrdiff_t>(offsets[major + 1]);
+	const auto position = std::lower_bound(first, last, minor);
+	if (position == last or *position != minor)
+		return Element(0);
+	return values[static_cast<size_t>(position - indices.begin())];
+}
+
+template <Elementable Element>
+SparseMatrix<Element> SparseMatrix<Element>::to_format(SparseFormat new_format) const
+{
+	if (new_format == format)
+		return *this;
+
+	// counting sort by minor index; walking the majors in order leaves every new row or column sorted
+	SparseMatrix<Element> result(number_of_row, number_of_col, new_format);
+	for (const size_t minor : indices)
+		++result.offsets[minor + 1];
+	std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+
+	result.indices.resize(indices.size());
+	result.values.resize(values.size());
+	std::vector<size_t> next(result.offsets.begin(), result.offsets.end() - 1);
+	for (size_t major = 0; major < get_major_size(); ++major)
+	{
+		for (size_t k = offsets[major]; k < offsets[major + 1]; ++k)
+		{
+			const size_t position = next[indices[k]]++;
+			result.indices[position] = major;
+			result.values[position] = values[k];
+		}
+	}
+	return result;
+}
+
+template <Elementable Element>
+Matrix<Element> SparseMatrix<Element>::to_dense() const
+{
+	Matrix<Element> result(number_of_row, number_of_col);
+	const auto result_rows = result.mutable_rows();
+	const size_t work_per_major = get_number_of_nonzero() / std::max<size_t>(1, get_major_size()) + 1;
+	matrix_helper::parallel_for(get_major_size(), work_per_major, [&](size_t begin, size_t end)
+	{
+		for (size_t major = begin; major < end; ++major)
+		{
+			for (size_t k = offsets[major]; k < offsets[major + 1]; ++k)
+			{
+				if (format == SparseFormat::csr)
+					result_rows.row_data(major)[indices[k]] = values[k];
+				else
+					result_rows.row_data(indices[k])[major] = values[k];
+			}
+		}
+	});
+	return result;
+}
+
+template <Elementable Element>
+SparseMatrix<Element> SparseMatrix<Element>::transpose() const
+{
+	SparseMatrix<Element> result(*this);
+	std::swap(result.number_of_row, result.number_of_col);
+	result.format = format == SparseFormat::csr ? SparseFormat::csc : SparseFormat::csr;
+	return result;
+}
+
+template <Elementable Element>
+bool SparseMatrix<Element>::is_symmetric() const
+{
+	if (number_of_row != number_of_col)
+		return false;
+
+	// the other compression of A holds A^T in this one, entries are sorted in both
+	const SparseMatrix<Element> other =
+			to_format(format == SparseFormat::csr ? SparseFormat::csc : SparseFormat::csr);
+	return offsets == other.offsets and indices == other.indices and values == other.values;
+}
+
+template <Elementable Element>
+void SparseMatrix<Element>::gather(const Element* x, Element* y) const
+{
+	const size_t work_per_major = get_number_of_nonzero() / std::max<size_t>(1, get_major_size()) + 1;
+	matrix_helper::parallel_for(get_major_size(), work_per_major, [&](size_t begin, size_t end)
+	{
+		for (size_t major = begin; major < end; ++major)
+		{
+			Element sum = 0;
+			for (size_t k = offsets[major]; k < offsets[major + 1]; ++k)
+				sum += values[k] * x[indices[k]];
+			y[major] = sum;
+		}
+	});
+}
+
+template <Elementable Element>
+void SparseMatrix<Element>::scatter(const Element* x, Element* y) const
+{
+	const size_t major_size = get_major_size();
+	const size_t minor_size = get_minor_size();
+	const size_t number_of_block = std::min(ThreadPool::get_instance().get_number_of_thread(),
+			get_number_of_nonzero() / matrix_helper::PARALLEL_GRAIN + 1);
+	const auto accumulate = [&](size_t first_major, size_t last_major, Element* result)
+	{
+		std::fill(result, result + minor_size, Element(0));
+		for (size_t major = first_major; major < last_major; ++major)
+			for (size_t k = offsets[major]; k < offsets[major + 1]; ++k)
+				result[indices[k]] += values[k] * x[major];
+	};
+	if (number_of_block <= 1)
+	{
+		accumulate(0, major_size, y);
+		return;
+	}
+
+	// one private y per block of majors, summed afterwards
+	std::vector<std::vector<Element>> partial(number_of_block, std::vector<Element>(minor_size));
+	matrix_helper::parallel_for(number_of_block, matrix_helper::PARALLEL_GRAIN, [&](size_t begin, size_t end)
+	{
+		for (size_t block = begin; block < end; ++block)
+			accumulate(block * major_size / number_of_block, (block + 1) * major_size / number_of_block,
+					partial[block].data());
+	});
+	matrix_helper::parallel_for(minor_size, number_of_block, [&](size_t begin, size_t end)
+	{
+		for (size_t minor = begin; minor < end; ++minor)
+		{
+			Element sum = 0;
+			for (const std::vector<Element>& block : partial)
+				sum += block[minor];
+			y[minor] = sum;
+		}
+	});
+}
+
+template <Elementable Element>
+void SparseMatrix<Element>::multiply(const Element* x, Element* y) const
+{
+	if (format == SparseFormat::csr)
+		gather(x, y);
+	else
+		scatter(x, y);
+}
+
+template <Elementable Element>
+void SparseMatrix<Element>::multiply_transpose(const Element* x, Element* y) const
+{
+	if (format == SparseFormat::csr)
+		scatter(x, y);
+	else
+		gather(x, y);
+}
+
+template <Elementable Element>
+std::vector<Element> SparseMatrix<Element>::operator*(const std::vector<Element>& x) const
+{
+	if (x.size() != number_of_col)
+		throw std::invalid_argument("the number of rows must match the number of columns.");
+
+	std::vector<Element> y(number_of_row);
+	multiply(x.data(), y.data());
+	return y;
+}
+
+template <Elementable Element>
+Matrix<Element> SparseMatrix<Element>::operator*(const Matrix<Element>& other) const
+{
+	if (number_of_col != other.get_number_of_row())
+		throw std::invalid_argument("the number of rows must match the number of columns.");
+	if (format != SparseFormat::csr)
+		return to_format(SparseFormat::csr) * other;
+
+	// row i of the product is the sum of value * row j of other over the entries (i, j)
+	const size_t number_of_rhs = other.get_number_of_col();
+	Matrix<Element> result(number_of_row, number_of_rhs);
+	const auto result_rows = result.mutable_rows();
+	const size_t work_per_row = (get_number_of_nonzero() / std::max<size_t>(1, number_of_row) + 1) * number_of_rhs;
+	matrix_helper::parallel_for(number_of_row, work_per_row, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = begin; row_index < end; ++row_index)
+		{
+			Element* result_row = result_rows.row_data(row_index);
+			for (size_t k = offsets[row_index]; k < offsets[row_index + 1]; ++k)
+				matrix_kernel::axpy(number_of_rhs, values[k], other.row_data(indices[k]), result_row);
+		}
+	});
+	return result;
+}
+
+template <Elementable Element>
+template <typename Combine>
+SparseMatrix<Element> SparseMatrix<Element>::merge(const SparseMatrix<Element>& other, Combine combine) const
+{
+	if (number_of_row != other.number_of_row or number_of_col != other.number_of_col)
+		throw std::invalid_argument("the matrices should have the same size!");
+	if (other.format != format)
+		return merge(other.to_format(format), combine);
+
+	// two passes over the same merge of sorted entries: the first counts, the second writes
+	const auto walk = [&](size_t major, auto&& emit)
+	{
+		size_t left = offsets[major];
+		size_t right = other.offsets[major];
+		while (left < offsets[major + 1] or right < other.offsets[major + 1])
+		{
+			size_t minor;
+			Element value;
+			if (right == other.offsets[major + 1] or
+					(left < offsets[major + 1] and indices[left] < other.indices[right]))
+			{
+				minor = indices[left];
+				value = combine(values[left++], Element(0));
+			}
+			else if (left == offsets[major + 1] or other.indices[right] < indices[left])
+			{
+				minor = other.indices[right];
+				value = combine(Element(0), other.values[right++]);
+			}
+			else
+			{
+				minor = indices[left];
+				value = combine(values[left++], other.values[right++]);
+			}
+			if (value != Element(0))
+				emit(minor, value);
+		}
+	};
+
+	SparseMatrix<Element> result(number_of_row, number_of_col, format);
+	const size_t major_size = get_major_size();
+	const size_t work_per_major =
+			(get_number_of_nonzero() + other.get_number_of_nonzero()) / std::max<size_t>(1, major_size) + 1;
+	std::vector<size_t> counts(major_size);
+	matrix_helper::parallel_for(major_size, work_per_major, [&](size_t begin, size_t end)
+	{
+		for (size_t major = begin; major < end; ++major)
+			walk(major, [&](size_t, const Element&) { ++counts[major]; });
+	});
+	std::partial_sum(counts.begin(), counts.end(), result.offsets.begin() + 1);
+
+	result.indices.resize(result.offsets.back());
+	result.values.resize(result.offsets.back());
+	matrix_helper::parallel_for(major_size, work_per_major, [&](size_t begin, size_t end)
+	{
+		for (size_t major = begin; major < end; ++major)
+		{
+			size_t position = result.offsets[major];
+			walk(major, [&](size_t minor, const Element& value)
+			{
+				result.indices[position] = minor;
+				result.values[position] = value;
+				++position;
+			});
+		}
+	});
+	return result;
+}
+
+template <Elementable Element>
+SparseMatrix<Element> SparseMatrix<Element>::operator+(const SparseMatrix<Element>& other) const
+{
+	return merge(other, [](const Element& left, const Element& right) { return left + right; });
+}
+
+template <Elementable Element>
+SparseMatrix<Element> SparseMatrix<Element>::operator-(const SparseMatrix<Element>& other) const
+{
+	return merge(other, [](const Element& left, const Element& right) { return left - right; });
+}
+
+template <Elementable Element>
+PartialEigenDecomposition<Element> SparseMatrix<Element>::top_eigenpairs(size_t k, EigenSolverMethod method) const
+{
+	if (number_of_row != number_of_col)
+		throw std::invalid_argument("the matrix should be square!");
+
+	return PartialEigenDecomposition<Element>(*this, number_of_row, k, is_symmetric(), method);
+}
+
+template <Elementable Element>
+SparseMatrixBuilder<Element>::SparseMatrixBuilder(size_t row, size_t col)
+: number_of_row(row)
+, number_of_col(col)
+{
+}
+
+template <Elementable Element>
+void SparseMatrixBuilder<Element>::reserve(size_t number_of_entry)
+{
+	row_indices.reserve(number_of_entry);
+	col_indices.reserve(number_of_entry);
+	values.reserve(number_of_entry);
+}
+
+template <Elementable Element>
+void SparseMatrixBuilder<Element>::add(size_t row_index, size_t col_index, const Element& value)
+{
+	if (row_index >= number_of_row or col_index >= number_of_col)
+		throw std::out_of_range("the index is out of the matrix!");
+
+	row_indices.push_back(row_index);
+	col_indices.push_back(col_index);
+	values.push_back(value);
+}
+
+template <Elementable Element>
+SparseMatrix<Element> SparseMatrixBuilder<Element>::build(SparseFormat format) const
+{
+	SparseMatrix<Element> result(number_of_row, number_of_col, format);
+	const std::vector<size_t>& majors = format == SparseFormat::csr ? row_indices : col_indices;
+	const std::vector<size_t>& minors = format == SparseFormat::csr ? col_indices : row_indices;
+	const size_t major_size = result.get_major_size();
+	const size_t number_of_entry = values.size();
+
+	// bucket the entries by major index, keeping the order they were added in
+	std::vector<size_t> bucket_offsets(major_size + 1, 0);
+	for (const size_t major : majors)
+		++bucket_offsets[major + 1];
+	std::partial_sum(bucket_offsets.begin(), bucket_offsets.end(), bucket_offsets.begin());
+	std::vector<size_t> order(number_of_entry);
+	std::vector<size_t> next(bucket_offsets.begin(), bucket_offsets.end() - 1);
+	for (size_t entry = 0; entry < number_of_entry; ++entry)
+		order[next[majors[entry]]++] = entry;
+
+	// sort every bucket by minor index, sum duplicates and drop zeros in place
+	std::vector<size_t> merged_indices(number_of_entry);
+	std::vector<Element> merged_values(number_of_entry);
+	std::vector<size_t> counts(major_size);
+	const size_t work_per_major = number_of_entry / std::max<size_t>(1, major_size) + 1;
+	matrix_helper::parallel_for(major_size, work_per_major, [&](size_t begin, size_t end)
+	{
+		for (size_t major = begin; major < end; ++major)
+		{
+			const auto first = order.begin() + static_cast<std::ptrdiff_t>(bucket_offsets[major]);
+			const auto last = order.begin() + static_cast<std::ptrdiff_t>(bucket_offsets[major + 1]);
+			std::stable_sort(first, last, [&](size_t left, size_t right) { return minors[left] < minors[right]; });
+
+			size_t kept = 0;
+			for (auto entry = first; entry != last;)
+			{
+				const size_t minor = minors[*entry];
+				Element sum = 0;
+				for (; entry != last and minors[*entry] == minor; ++entry)
+					sum += values[*entry];
+				if (sum == Element(0))
+					continue;
+				merged_indices[bucket_offsets[major] + kept] = minor;
+				merged_values[bucket_offsets[major] + kept] = sum;
+				++kept;
+			}
+			counts[major] = kept;
+		}
+	});
+
+	std::partial_sum(counts.begin(), counts.end(), result.offsets.begin() + 1);
+	result.indices.resize(result.offsets.back());
+	result.values.resize(result.offsets.back());
+	matrix_helper::parallel_for(major_size, work_per_major, [&](size_t begin, size_t end)
+	{
+		for (size_t major = begin; major < end; ++major)
+		{
+			std::copy_n(merged_indices.begin() + static_cast<std::ptrdiff_t>(bucket_offsets[major]), counts[major],
+					result.indices.begin() + static_cast<std::ptrdiff_t>(result.offsets[major]));
+			std::copy_n(merged_values.begin() + static_cast<std::ptrdiff_t>(bucket_offsets[major]), counts[major],
+					result.values.begin() + static_cast<std::ptrdiff_t>(result.offsets[major]));
+		}
+	});
+	return result;
+}
+
+#endif
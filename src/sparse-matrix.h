@@ -0,0 +1,112 @@
+#ifndef MATRIX_SPARSE_MATRIX_H
+#define MATRIX_SPARSE_MATRIX_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+
+// which index the compressed offsets run over
+enum class SparseFormat
+{
+	// compressed sparse rows
+	csr,
+	// compressed sparse columns
+	csc,
+};
+
+// offsets[major] .. offsets[major + 1] index the entries of one row (CSR) or one column (CSC) in indices and values.
+// Entries of a row or column are sorted by their minor index and hold no explicit zero, so memory grows with the
+// number of non-zeros instead of row * col.
+template <Elementable Element>
+class SparseMatrix
+{
+public:
+	SparseMatrix() = default;
+	// row x col without any non-zero
+	SparseMatrix(size_t row, size_t col, SparseFormat format = SparseFormat::csr);
+	explicit SparseMatrix(const Matrix<Element>& matrix, SparseFormat format = SparseFormat::csr);
+
+	[[nodiscard]] size_t get_number_of_row() const noexcept;
+	[[nodiscard]] size_t get_number_of_col() const noexcept;
+	[[nodiscard]] size_t get_number_of_nonzero() const noexcept;
+	[[nodiscard]] SparseFormat get_format() const noexcept;
+	[[nodiscard]] const std::vector<size_t>& get_offsets() const noexcept;
+	[[nodiscard]] const std::vector<size_t>& get_indices() const noexcept;
+	[[nodiscard]] const std::vector<Element>& get_values() const noexcept;
+
+	// zero when the entry is not stored
+	[[nodiscard]] Element at(size_t row_index, size_t col_index) const;
+
+	// same matrix, other compression
+	[[nodiscard]] SparseMatrix to_format(SparseFormat new_format) const;
+	[[nodiscard]] Matrix<Element> to_dense() const;
+	// the CSR arrays of A are the CSC arrays of A^T, so this only flips the format
+	[[nodiscard]] SparseMatrix transpose() const;
+	[[nodiscard]] bool is_symmetric() const;
+
+	// y = A * x and y = A^T * x; the product along the compressed direction splits over rows of y, the other one
+	// accumulates a private y per thread
+	void multiply(const Element* x, Element* y) const;
+	void multiply_transpose(const Element* x, Element* y) const;
+	[[nodiscard]] std::vector<Element> operator*(const std::vector<Element>& x) const;
+	// a CSC matrix is converted to CSR first
+	[[nodiscard]] Matrix<Element> operator*(const Matrix<Element>& other) const;
+
+	// in the format of the left operand, zeros that cancel out are dropped
+	[[nodiscard]] SparseMatrix operator+(const SparseMatrix& other) const;
+	[[nodiscard]] SparseMatrix operator-(const SparseMatrix& other) const;
+
+	// the k eigenpairs of largest magnitude through sparse matrix-vector products only
+	[[nodiscard]] PartialEigenDecomposition<Element> top_eigenpairs(size_t k,
+			EigenSolverMethod method = EigenSolverMethod::krylov) const;
+
+private:
+	template <Elementable OtherElement>
+	friend class SparseMatrixBuilder;
+
+	[[nodiscard]] size_t get_major_size() const noexcept;
+	[[nodiscard]] size_t get_minor_size() const noexcept;
+
+	// y[major] = sum over the entries of major of value * x[minor]
+	void gather(const Element* x, Element* y) const;
+	// y[minor] = sum over every major of value * x[major]
+	void scatter(const Element* x, Element* y) const;
+
+	// merge of two matrices of the same format, entry by entry through combine(left, right)
+	template <typename Combine>
+	[[nodiscard]] SparseMatrix merge(const SparseMatrix& other, Combine combine) const;
+
+	size_t number_of_row = 0;
+	size_t number_of_col = 0;
+	SparseFormat format = SparseFormat::csr;
+	std::vector<size_t> offsets = std::vector<size_t>(1, 0);
+	std::vector<size_t> indices;
+	std::vector<Element> values;
+};
+
+// Coordinate list: entries come in any order and entries at the same position are summed by build.
+template <Elementable Element>
+class SparseMatrixBuilder
+{
+public:
+	SparseMatrixBuilder(size_t row, size_t col);
+
+	void reserve(size_t number_of_entry);
+	void add(size_t row_index, size_t col_index, const Element& value);
+
+	[[nodiscard]] SparseMatrix<Element> build(SparseFormat format = SparseFormat::csr) const;
+
+private:
+	size_t number_of_row;
+	size_t number_of_col;
+	std::vector<size_t> row_indices;
+	std::vector<size_t> col_indices;
+	std::vector<Element> values;
+};
+
+#include "sparse-matrix-tmp.h"
+
+#endif
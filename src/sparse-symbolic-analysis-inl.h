@@ -0,0 +1,450 @@
+#ifndef MATRIX_SPARSE_SYMBOLIC_ANALYSIS_INL_H
+#define MATRIX_SPARSE_SYMBOLIC_ANALYSIS_INL_H
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "sparse-symbolic-analysis.h"
+
+template <Elementable Element>
+SparseSymbolicAnalysis::SparseSymbolicAnalysis(const SparseMatrix<Element>& matrix, SparseOrdering ordering)
+: size(matrix.get_number_of_row())
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	// explicit zeros are dropped by SparseMatrix, so the pattern is that of the stored entries
+	Graph graph(size);
+	const std::vector<size_t>& offsets = matrix.get_offsets();
+	const std::vector<size_t>& indices = matrix.get_indices();
+	for (size_t major = 0; major < size; ++major)
+	{
+		for (size_t k = offsets[major]; k < offsets[major + 1]; ++k)
+		{
+			if (indices[k] != major)
+			{
+				graph[major].push_back(indices[k]);
+				graph[indices[k]].push_back(major);
+			}
+		}
+	}
+	for (std::vector<size_t>& neighbours : graph)
+	{
+		std::sort(neighbours.begin(), neighbours.end());
+		neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+	}
+
+	analyze(graph, ordering);
+}
+
+inline void SparseSymbolicAnalysis::analyze(const Graph& graph, SparseOrdering ordering)
+{
+	std::vector<size_t> order(size);
+	if (ordering == SparseOrdering::approximate_minimum_degree)
+		order = approximate_minimum_degree(graph);
+	else
+		std::iota(order.begin(), order.end(), 0);
+	std::vector<size_t> position(size);
+	for (size_t k = 0; k < size; ++k)
+		position[order[k]] = k;
+
+	// elimination tree by Liu's algorithm, with path compression on the ancestors
+	std::vector<size_t> parent(size, NONE);
+	std::vector<size_t> ancestor(size, NONE);
+	for (size_t k = 0; k < size; ++k)
+	{
+		for (const size_t neighbour : graph[order[k]])
+		{
+			for (size_t i = position[neighbour]; i < k;)
+			{
+				const size_t next = ancestor[i];
+				ancestor[i] = k;
+				if (next == NONE)
+				{
+					parent[i] = k;
+					break;
+				}
+				i = next;
+			}
+		}
+	}
+
+	// a postorder numbers every subtree consecutively, so supernodes become ranges of columns
+	std::vector<size_t> first_child(size, NONE);
+	std::vector<size_t> next_sibling(size, NONE);
+	for (size_t j = size; j-- > 0;)
+	{
+		if (parent[j] != NONE)
+		{
+			next_sibling[j] = first_child[parent[j]];
+			first_child[parent[j]] = j;
+		}
+	}
+	std::vector<size_t> postorder;
+	postorder.reserve(size);
+	std::vector<size_t> stack;
+	for (size_t root = 0; root < size; ++root)
+	{
+		if (parent[root] != NONE)
+			continue;
+		stack.push_back(root);
+		while (not stack.empty())
+		{
+			const size_t node = stack.back();
+			if (first_child[node] != NONE)
+			{
+				// descend, and unlink the child so the node is emitted once all its children are
+				stack.push_back(first_child[node]);
+				first_child[node] = next_sibling[first_child[node]];
+			}
+			else
+			{
+				postorder.push_back(node);
+				stack.pop_back();
+			}
+		}
+	}
+
+	permutation.resize(size);
+	inverse_permutation.resize(size);
+	std::vector<size_t> renumber(size);
+	for (size_t k = 0; k < size; ++k)
+	{
+		renumber[postorder[k]] = k;
+		permutation[k] = order[postorder[k]];
+		inverse_permutation[permutation[k]] = k;
+	}
+	std::vector<size_t> postordered_parent(size, NONE);
+	for (size_t k = 0; k < size; ++k)
+	{
+		if (parent[postorder[k]] != NONE)
+			postordered_parent[k] = renumber[parent[postorder[k]]];
+	}
+
+	// row i of L is the union of the etree paths from every k < i with A[i][k] != 0 up to i
+	std::vector<size_t> column_count(size, 1);
+	std::vector<size_t> visited(size, NONE);
+	for (size_t i = 0; i < size; ++i)
+	{
+		visited[i] = i;
+		for (const size_t neighbour : graph[permutation[i]])
+		{
+			for (size_t j = inverse_permutation[neighbour]; j < i and visited[j] != i; j = postordered_parent[j])
+			{
+				++column_count[j];
+				visited[j] = i;
+			}
+		}
+	}
+
+	find_supernodes(postordered_parent, column_count);
+	find_supernode_rows(graph, postordered_parent);
+}
+
+inline std::vector<size_t> SparseSymbolicAnalysis::approximate_minimum_degree(Graph graph)
+{
+	// Eliminated nodes become elements, the cliques they leave behind, so the graph never grows: a variable keeps the
+	// variables and the elements it touches and an element the variables it covers. A variable eliminated absorbs
+	// every element around it, which is why elements only ever hold live variables.
+	enum class Status : unsigned char
+	{
+		variable,
+		element,
+		absorbed,
+	};
+
+	const size_t size = graph.size();
+	Graph& adjacent_variables = graph;
+	Graph adjacent_elements(size);
+	Graph element_variables(size);
+	std::vector<Status> status(size, Status::variable);
+	std::vector<size_t> degree(size);
+
+	// doubly linked lists of the variables of every approximate degree
+	std::vector<size_t> head(size + 1, NONE);
+	std::vector<size_t> next(size, NONE);
+	std::vector<size_t> previous(size, NONE);
+	const auto insert = [&](size_t i)
+	{
+		next[i] = head[degree[i]];
+		previous[i] = NONE;
+		if (head[degree[i]] != NONE)
+			previous[head[degree[i]]] = i;
+		head[degree[i]] = i;
+	};
+	const auto remove = [&](size_t i)
+	{
+		if (previous[i] != NONE)
+			next[previous[i]] = next[i];
+		else
+			head[degree[i]] = next[i];
+		if (next[i] != NONE)
+			previous[next[i]] = previous[i];
+	};
+	for (size_t i = 0; i < size; ++i)
+	{
+		degree[i] = adjacent_variables[i].size();
+		insert(i);
+	}
+
+	std::vector<size_t> order;
+	order.reserve(size);
+	std::vector<size_t> mark(size, NONE);
+	// |L_e \ L_p| for the elements next to L_p, valid where outside_stamp matches the step
+	std::vector<size_t> outside(size);
+	std::vector<size_t> outside_stamp(size, NONE);
+	size_t min_degree = 0;
+	for (size_t step = 0; step < size; ++step)
+	{
+		while (head[min_degree] == NONE)
+			++min_degree;
+		const size_t pivot = head[min_degree];
+		remove(pivot);
+		order.push_back(pivot);
+
+		// L_p, the variables of the new element: neighbours of the pivot and of the elements it absorbs
+		std::vector<size_t> pivot_variables;
+		mark[pivot] = step;
+		for (const size_t v : adjacent_variables[pivot])
+		{
+			if (status[v] == Status::variable and mark[v] != step)
+			{
+				mark[v] = step;
+				pivot_variables.push_back(v);
+			}
+		}
+		for (const size_t e : adjacent_elements[pivot])
+		{
+			if (status[e] != Status::element)
+				continue;
+			for (const size_t v : element_variables[e])
+			{
+				if (mark[v] != step)
+				{
+					mark[v] = step;
+					pivot_variables.push_back(v);
+				}
+			}
+			status[e] = Status::absorbed;
+			Graph::value_type().swap(element_variables[e]);
+		}
+		status[pivot] = Status::element;
+		Graph::value_type().swap(adjacent_variables[pivot]);
+		Graph::value_type().swap(adjacent_elements[pivot]);
+
+		for (const size_t i : pivot_variables)
+		{
+			for (const size_t e : adjacent_elements[i])
+			{
+				if (status[e] != Status::element)
+					continue;
+				if (outside_stamp[e] != step)
+				{
+					outside_stamp[e] = step;
+					outside[e] = element_variables[e].size();
+				}
+				--outside[e];
+			}
+		}
+
+		const size_t remaining = size - step - 1;
+		for (const size_t i : pivot_variables)
+		{
+			remove(i);
+			// an element inside L_p is redundant with the new one and absorbed by it
+			size_t external_degree = 0;
+			std::erase_if(adjacent_elements[i], [&](size_t e)
+					{
+						if (status[e] != Status::element)
+							return true;
+						if (outside[e] == 0)
+						{
+							status[e] = Status::absorbed;
+							Graph::value_type().swap(element_variables[e]);
+							return true;
+						}
+						external_degree += outside[e];
+						return false;
+					});
+			adjacent_elements[i].push_back(pivot);
+			// the new element covers every edge to L_p
+			std::erase_if(adjacent_variables[i],
+					[&](size_t v) { return status[v] != Status::variable or mark[v] == step; });
+
+			const size_t new_neighbours = pivot_variables.size() - 1;
+			degree[i] = std::min({remaining - 1, degree[i] + new_neighbours,
+					adjacent_variables[i].size() + new_neighbours + external_degree});
+			insert(i);
+			min_degree = std::min(min_degree, degree[i]);
+		}
+		element_variables[pivot] = std::move(pivot_variables);
+	}
+	return order;
+}
+
+inline void SparseSymbolicAnalysis::find_supernodes(const std::vector<size_t>& parent,
+		const std::vector<size_t>& column_count)
+{
+	// a merge is accepted while the merged supernode is narrow or its share of explicit zeros small, the wider the
+	// smaller, in the spirit of CHOLMOD's relaxed amalgamation
+	constexpr size_t ALWAYS_MERGED = 4;
+	constexpr size_t NARROW = 16;
+	constexpr size_t WIDE = 48;
+	constexpr double NARROW_ZEROS = 0.5;
+	constexpr double WIDE_ZEROS = 0.2;
+	constexpr double ANY_ZEROS = 0.05;
+
+	std::vector<size_t> number_of_children(size, 0);
+	for (size_t j = 0; j < size; ++j)
+	{
+		if (parent[j] != NONE)
+			++number_of_children[parent[j]];
+	}
+
+	struct Supernode
+	{
+		size_t first;
+		size_t last;
+		// rows of its first column, which holds those of every other column
+		size_t number_of_row;
+		size_t zeros;
+	};
+	const auto entries = [](const Supernode& supernode)
+	{
+		const size_t columns = supernode.last - supernode.first;
+		return columns * supernode.number_of_row - columns * (columns - 1) / 2;
+	};
+
+	std::vector<Supernode> supernodes;
+	for (size_t j = 0; j < size; ++j)
+	{
+		// fundamental: j continues the supernode of j - 1 when it is the only child of j and L has the same rows below
+		if (j > 0 and parent[j - 1] == j and number_of_children[j] == 1 and column_count[j - 1] == column_count[j] + 1)
+		{
+			++supernodes.back().last;
+			continue;
+		}
+		Supernode current = {j, j + 1, column_count[j], 0};
+
+		// relaxed: swallow the previous supernode when it is a child of this one
+		while (not supernodes.empty())
+		{
+			const Supernode& child = supernodes.back();
+			if (parent[child.last - 1] != j)
+				break;
+			const size_t child_columns = child.last - child.first;
+			const size_t columns = child_columns + (current.last - current.first);
+			const Supernode merged = {child.first, current.last, child_columns + current.number_of_row,
+					child.zeros + current.zeros + child_columns * (child_columns + current.number_of_row)
+							- child_columns * child.number_of_row};
+			const double zero_share = static_cast<double>(merged.zeros) / static_cast<double>(entries(merged));
+			const bool accepted = columns <= ALWAYS_MERGED or (columns <= NARROW and zero_share <= NARROW_ZEROS)
+					or (columns <= WIDE and zero_share <= WIDE_ZEROS) or zero_share <= ANY_ZEROS;
+			if (not accepted)
+				break;
+			current = merged;
+			supernodes.pop_back();
+		}
+		supernodes.push_back(current);
+	}
+
+	first_column.assign(1, 0);
+	column_to_supernode.resize(size);
+	for (const Supernode& supernode : supernodes)
+	{
+		std::fill(column_to_supernode.begin() + static_cast<std::ptrdiff_t>(supernode.first),
+				column_to_supernode.begin() + static_cast<std::ptrdiff_t>(supernode.last), first_column.size() - 1);
+		first_column.push_back(supernode.last);
+	}
+}
+
+inline void SparseSymbolicAnalysis::find_supernode_rows(const Graph& graph, const std::vector<size_t>& parent)
+{
+	const size_t number_of_supernode = get_number_of_supernode();
+	parent_supernode.assign(number_of_supernode, NONE);
+	child_offsets.assign(number_of_supernode + 1, 0);
+	for (size_t s = 0; s < number_of_supernode; ++s)
+	{
+		const size_t parent_column = parent[first_column[s + 1] - 1];
+		if (parent_column != NONE)
+		{
+			parent_supernode[s] = column_to_supernode[parent_column];
+			++child_offsets[parent_supernode[s] + 1];
+		}
+	}
+	std::partial_sum(child_offsets.begin(), child_offsets.end(), child_offsets.begin());
+	child_supernodes.resize(child_offsets.back());
+	std::vector<size_t> fill = child_offsets;
+	for (size_t s = 0; s < number_of_supernode; ++s)
+	{
+		if (parent_supernode[s] != NONE)
+			child_supernodes[fill[parent_supernode[s]]++] = s;
+	}
+
+	// the rows of a supernode are its pivots, the rows of A below them and whatever its children pass up
+	row_offsets.assign(1, 0);
+	rows.clear();
+	std::vector<size_t> mark(size, NONE);
+	for (size_t s = 0; s < number_of_supernode; ++s)
+	{
+		const size_t first = first_column[s];
+		const size_t last = first_column[s + 1];
+		const size_t begin = rows.size();
+		for (size_t j = first; j < last; ++j)
+		{
+			rows.push_back(j);
+			mark[j] = s;
+		}
+		const auto add = [&](size_t i)
+		{
+			if (i >= last and mark[i] != s)
+			{
+				mark[i] = s;
+				rows.push_back(i);
+			}
+		};
+		for (size_t j = first; j < last; ++j)
+		{
+			for (const size_t neighbour : graph[permutation[j]])
+				add(inverse_permutation[neighbour]);
+		}
+		for (size_t c = child_offsets[s]; c < child_offsets[s + 1]; ++c)
+		{
+			const size_t child = child_supernodes[c];
+			for (size_t k = row_offsets[child]; k < row_offsets[child + 1]; ++k)
+				add(rows[k]);
+		}
+		std::sort(rows.begin() + static_cast<std::ptrdiff_t>(begin), rows.end());
+		row_offsets.push_back(rows.size());
+	}
+}
+
+inline size_t SparseSymbolicAnalysis::get_size() const noexcept
+{
+	return size;
+}
+
+inline const std::vector<size_t>& SparseSymbolicAnalysis::get_permutation() const noexcept
+{
+	return permutation;
+}
+
+inline size_t SparseSymbolicAnalysis::get_number_of_supernode() const noexcept
+{
+	return first_column.size() - 1;
+}
+
+inline size_t SparseSymbolicAnalysis::get_factor_nonzero() const noexcept
+{
+	size_t nonzero = 0;
+	for (size_t s = 0; s < get_number_of_supernode(); ++s)
+	{
+		const size_t columns = first_column[s + 1] - first_column[s];
+		const size_t number_of_row = row_offsets[s + 1] - row_offsets[s];
+		nonzero += columns * number_of_row - columns * (columns - 1) / 2;
+	}
+	return nonzero;
+}
+
+#endif
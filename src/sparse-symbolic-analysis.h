@@ -0,0 +1,74 @@
+#ifndef MATRIX_SPARSE_SYMBOLIC_ANALYSIS_H
+#define MATRIX_SPARSE_SYMBOLIC_ANALYSIS_H
+
+#include <cstddef>
+
+#include <limits>
+#include <vector>
+
+#include "concept.h"
+#include "sparse-matrix.h"
+
+enum class SparseOrdering
+{
+	// the matrix's own order
+	natural,
+	// approximate minimum degree on the quotient graph, with aggressive element absorption
+	approximate_minimum_degree,
+};
+
+template <Elementable Element>
+class SparseDirectSolver;
+
+// Everything a sparse factorization needs that depends on the non-zero pattern only, computed on the pattern of
+// A + A^T: a fill-reducing ordering, the postordered elimination tree and the supernodes, i.e. groups of consecutive
+// columns of L that share one row structure and are stored as one dense block. It can be reused for every matrix
+// whose pattern is contained in the analysed one.
+class SparseSymbolicAnalysis
+{
+public:
+	template <Elementable Element>
+	explicit SparseSymbolicAnalysis(const SparseMatrix<Element>& matrix,
+			SparseOrdering ordering = SparseOrdering::approximate_minimum_degree);
+
+	[[nodiscard]] size_t get_size() const noexcept;
+	// the k-th pivot is row and column permutation[k] of A
+	[[nodiscard]] const std::vector<size_t>& get_permutation() const noexcept;
+	[[nodiscard]] size_t get_number_of_supernode() const noexcept;
+	// entries of L, diagonal included, zeros kept by supernode amalgamation included
+	[[nodiscard]] size_t get_factor_nonzero() const noexcept;
+
+private:
+	template <Elementable Element>
+	friend class SparseDirectSolver;
+
+	static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+	// neighbours of every node in the graph of A + A^T, without the diagonal
+	using Graph = std::vector<std::vector<size_t>>;
+
+	void analyze(const Graph& graph, SparseOrdering ordering);
+	[[nodiscard]] static std::vector<size_t> approximate_minimum_degree(Graph graph);
+	// supernodes of whole columns of L whose number of rows matches their parent, merged further while the explicit
+	// zeros this adds stay small
+	void find_supernodes(const std::vector<size_t>& parent, const std::vector<size_t>& column_count);
+	void find_supernode_rows(const Graph& graph, const std::vector<size_t>& parent);
+
+	size_t size = 0;
+	std::vector<size_t> permutation;
+	std::vector<size_t> inverse_permutation;
+	// supernode s holds the pivots [first_column[s], first_column[s + 1])
+	std::vector<size_t> first_column;
+	std::vector<size_t> column_to_supernode;
+	// rows of L in supernode s, ascending: its own pivots first, then the rows below them
+	std::vector<size_t> row_offsets;
+	std::vector<size_t> rows;
+	std::vector<size_t> parent_supernode;
+	// children of s are child_supernodes[child_offsets[s] .. child_offsets[s + 1])
+	std::vector<size_t> child_offsets;
+	std::vector<size_t> child_supernodes;
+};
+
+#include "sparse-symbolic-analysis-inl.h"
+
+#endif
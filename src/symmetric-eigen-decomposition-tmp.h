@@ -0,0 +1,254 @@
+#ifndef MATRIX_SYMMETRIC_EIGEN_DECOMPOSITION_TMP_H
+#define MATRIX_SYMMETRIC_EIGEN_DECOMPOSITION_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+#include "symmetric-eigen-decomposition.h"
+
+template <Elementable Element>
+SymmetricEigenDecomposition<Element>::SymmetricEigenDecomposition(const Matrix<Element>& matrix,
+		bool compute_eigenvectors)
+: eigenvalues(matrix.get_number_of_row())
+, subdiagonal(matrix.get_number_of_row())
+, compute_eigenvectors(compute_eigenvectors)
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	Matrix<Element> q_transpose;
+	tridiagonalize(matrix, q_transpose);
+	tridiagonal_ql(q_transpose);
+
+	const size_t size = get_size();
+	std::vector<size_t> order(size);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [this](size_t first, size_t second)
+	{
+		return eigenvalues[first] < eigenvalues[second];
+	});
+
+	std::vector<Element> sorted_eigenvalues(size);
+	for (size_t j = 0; j < size; ++j)
+		sorted_eigenvalues[j] = eigenvalues[order[j]];
+	eigenvalues = std::move(sorted_eigenvalues);
+
+	if (compute_eigenvectors)
+	{
+		eigenvectors = Matrix<Element>(size, size);
+		const auto eigenvectors_rows = eigenvectors.mutable_rows();
+		for (size_t i = 0; i < size; ++i)
+		{
+			Element* row = eigenvectors_rows.row_data(i);
+			for (size_t j = 0; j < size; ++j)
+				row[j] = q_transpose.row_data(order[j])[i];
+		}
+	}
+}
+
+template <Elementable Element>
+void SymmetricEigenDecomposition<Element>::tridiagonalize(Matrix<Element> a, Matrix<Element>& q_transpose)
+{
+	using std::abs;
+	using std::sqrt;
+	const size_t size = get_size();
+	if (size == 0)
+		return;
+
+	// mirror the lower triangle so that every row below is a full row
+	const auto a_rows = a.mutable_rows();
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		for (size_t col_index = 0; col_index < row_index; ++col_index)
+			a_rows.row_data(col_index)[row_index] = a.row_data(row_index)[col_index];
+	}
+
+	// reflector k is kept in row k of a beyond the diagonal, with v[k + 1] = 1
+	std::vector<Element> betas(size, Element(0));
+	std::vector<Element> p(size);
+	for (size_t k = 0; k + 2 < size; ++k)
+	{
+		eigenvalues[k] = a.row_data(k)[k];
+		Element* v = a_rows.row_data(k);
+		const size_t first = k + 1;
+
+		Element tail_norm_square = 0;
+		for (size_t i = first + 1; i < size; ++i)
+			tail_norm_square += v[i] * v[i];
+		if (tail_norm_square == 0)
+		{
+			subdiagonal[k] = v[first];
+			continue;
+		}
+
+		const Element head = v[first];
+		const Element norm = sqrt(head * head + tail_norm_square);
+		const Element alpha = head > 0 ? -norm : norm;
+		const Element pivot = head - alpha;
+		v[first] = 1;
+		for (size_t i = first + 1; i < size; ++i)
+			v[i] = v[i] / pivot;
+		const Element beta = abs(pivot) / norm;
+		betas[k] = beta;
+		subdiagonal[k] = alpha;
+
+		// A22 = H * A22 * H = A22 - v * w^T - w * v^T with p = beta * A22 * v and w = p - beta / 2 * (p^T v) * v
+		const size_t length = size - first;
+		matrix_helper::parallel_for(length, length, [&](size_t begin, size_t end)
+		{
+			for (size_t i = first + begin; i < first + end; ++i)
+				p[i] = beta * matrix_kernel::dot(length, a.row_data(i) + first, v + first);
+		});
+		const Element correction = -beta / 2 * matrix_kernel::dot(length, p.data() + first, v + first);
+		matrix_kernel::axpy(length, correction, v + first, p.data() + first);
+		matrix_helper::parallel_for(length, 2 * length, [&](size_t begin, size_t end)
+		{
+			for (size_t i = first + begin; i < first + end; ++i)
+			{
+				Element* row = a_rows.row_data(i) + first;
+				matrix_kernel::axpy(length, -v[i], p.data() + first, row);
+				matrix_kernel::axpy(length, -p[i], v + first, row);
+			}
+		});
+	}
+	if (size >= 2)
+	{
+		eigenvalues[size - 2] = a.row_data(size - 2)[size - 2];
+		subdiagonal[size - 2] = a.row_data(size - 1)[size - 2];
+	}
+	eigenvalues[size - 1] = a.row_data(size - 1)[size - 1];
+	subdiagonal[size - 1] = 0;
+
+	if (not compute_eigenvectors)
+		return;
+
+	// Q = H_0 * H_1 * ... applied backwards, so H_k only ever meets the trailing block it acts on
+	Matrix<Element> q = Matrix<Element>::create_i_matrix(size);
+	const auto q_rows = q.mutable_rows();
+	std::vector<Element> w(size);
+	for (size_t k = size > 2 ? size - 2 : 0; k-- > 0;)
+	{
+		if (betas[k] == 0)
+			continue;
+		const size_t first = k + 1;
+		const size_t length = size - first;
+		const Element* v = a.row_data(k);
+
+		std::fill(w.begin() + first, w.end(), Element(0));
+		for (size_t i = first; i < size; ++i)
+			matrix_kernel::axpy(length, v[i], q.row_data(i) + first, w.data() + first);
+		matrix_helper::parallel_for(length, length, [&](size_t begin, size_t end)
+		{
+			for (size_t i = first + begin; i < first + end; ++i)
+				matrix_kernel::axpy(length, -betas[k] * v[i], w.data() + first, q_rows.row_data(i) + first);
+		});
+	}
+	q_transpose = q.transpose();
+}
+
+// EISPACK tql2: deflate the tridiagonal matrix from the top, one implicit QL sweep at a time
+template <Elementable Element>
+void SymmetricEigenDecomposition<Element>::tridiagonal_ql(Matrix<Element>& q_transpose)
+{
+	using std::abs;
+	using std::hypot;
+	const size_t size = get_size();
+	const Element eps = std::numeric_limits<Element>::epsilon();
+	std::vector<Element>& d = eigenvalues;
+	std::vector<Element>& e = subdiagonal;
+	const auto q_transpose_rows = q_transpose.mutable_rows();
+
+	Element shift_sum = 0;
+	Element largest = 0;
+	for (size_t l = 0; l < size; ++l)
+	{
+		largest = std::max(largest, abs(d[l]) + abs(e[l]));
+		size_t m = l;
+		while (m < size and abs(e[m]) > eps * largest)
+			++m;
+
+		size_t iteration = 0;
+		while (m > l)
+		{
+			if (++iteration > MAX_ITERATION_PER_EIGENVALUE)
+				throw std::runtime_error("the QL algorithm did not converge!");
+
+			// Wilkinson shift from the leading 2x2 block
+			Element g = d[l];
+			Element p = (d[l + 1] - g) / (2 * e[l]);
+			Element r = hypot(p, Element(1));
+			if (p < 0)
+				r = -r;
+			d[l] = e[l] / (p + r);
+			d[l + 1] = e[l] * (p + r);
+			const Element next_diagonal = d[l + 1];
+			Element h = g - d[l];
+			for (size_t i = l + 2; i < size; ++i)
+				d[i] -= h;
+			shift_sum += h;
+
+			p = d[m];
+			Element c = 1, c2 = 1, c3 = 1;
+			const Element next_subdiagonal = e[l + 1];
+			Element s = 0, s2 = 0;
+			for (size_t i = m; i-- > l;)
+			{
+				c3 = c2;
+				c2 = c;
+				s2 = s;
+				g = c * e[i];
+				h = c * p;
+				r = hypot(p, e[i]);
+				e[i + 1] = s * r;
+				s = e[i] / r;
+				c = p / r;
+				p = c * d[i] - s * g;
+				d[i + 1] = h + s * (c * g + s * d[i]);
+
+				if (compute_eigenvectors)
+					matrix_kernel::rotate(size, c, s, q_transpose_rows.row_data(i), q_transpose_rows.row_data(i + 1));
+			}
+			p = -s * s2 * c3 * next_subdiagonal * e[l] / next_diagonal;
+			e[l] = s * p;
+			d[l] = c * p;
+
+			if (abs(e[l]) <= eps * largest)
+				break;
+		}
+		d[l] += shift_sum;
+		e[l] = 0;
+	}
+}
+
+template <Elementable Element>
+size_t SymmetricEigenDecomposition<Element>::get_size() const noexcept
+{
+	return eigenvalues.size();
+}
+
+template <Elementable Element>
+const std::vector<Element>& SymmetricEigenDecomposition<Element>::get_eigenvalues() const noexcept
+{
+	return eigenvalues;
+}
+
+template <Elementable Element>
+bool SymmetricEigenDecomposition<Element>::has_eigenvectors() const noexcept
+{
+	return compute_eigenvectors;
+}
+
+template <Elementable Element>
+const Matrix<Element>& SymmetricEigenDecomposition<Element>::get_eigenvectors() const
+{
+	if (not compute_eigenvectors)
+		throw std::invalid_argument("the eigenvectors were not computed!");
+	return eigenvectors;
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef MATRIX_SYMMETRIC_EIGEN_DECOMPOSITION_H
+#define MATRIX_SYMMETRIC_EIGEN_DECOMPOSITION_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+
+// A = V * diag(lambda) * V^T for a symmetric A: Householder tridiagonalization, then implicit QL on the tridiagonal
+// matrix. Only the lower triangle of A is read. Eigenvalues are sorted ascending and column j of V is the unit
+// eigenvector of eigenvalue j.
+template <Elementable Element>
+class SymmetricEigenDecomposition
+{
+public:
+	explicit SymmetricEigenDecomposition(const Matrix<Element>& matrix, bool compute_eigenvectors = true);
+
+	[[nodiscard]] size_t get_size() const noexcept;
+	[[nodiscard]] const std::vector<Element>& get_eigenvalues() const noexcept;
+	[[nodiscard]] bool has_eigenvectors() const noexcept;
+	[[nodiscard]] const Matrix<Element>& get_eigenvectors() const;
+
+private:
+	static constexpr size_t MAX_ITERATION_PER_EIGENVALUE = 100;
+
+	// diagonal into eigenvalues, subdiagonal into subdiagonal; with eigenvectors, rows of q_transpose hold Q^T
+	void tridiagonalize(Matrix<Element> matrix, Matrix<Element>& q_transpose);
+	// QL with implicit Wilkinson shifts; every rotation mixes two rows of q_transpose
+	void tridiagonal_ql(Matrix<Element>& q_transpose);
+
+	std::vector<Element> eigenvalues;
+	std::vector<Element> subdiagonal;
+	bool compute_eigenvectors;
+	Matrix<Element> eigenvectors;
+};
+
+#include "symmetric-eigen-decomposition-tmp.h"
+
+#endif
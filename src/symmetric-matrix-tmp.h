@@ -0,0 +1,281 @@
+#ifndef MATRIX_SYMMETRIC_MATRIX_TMP_H
+#define MATRIX_SYMMETRIC_MATRIX_TMP_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+#include "symmetric-matrix.h"
+
+template <Elementable Element>
+SymmetricMatrix<Element>::SymmetricMatrix(size_t size)
+: size(size)
+, storage(size * (size + 1) / 2, Element(0))
+{
+}
+
+template <Elementable Element>
+SymmetricMatrix<Element>::SymmetricMatrix(const Matrix<Element>& matrix)
+: SymmetricMatrix(matrix.get_number_of_row())
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	for (size_t row_index = 0; row_index < size; ++row_index)
+		std::copy_n(matrix.row_data(row_index), row_index + 1, storage.begin() + index(row_index, 0));
+}
+
+template <Elementable Element>
+size_t SymmetricMatrix<Element>::index(size_t row_index, size_t col_index) noexcept
+{
+	return row_index * (row_index + 1) / 2 + col_index;
+}
+
+template <Elementable Element>
+size_t SymmetricMatrix<Element>::get_size() const noexcept
+{
+	return size;
+}
+
+template <Elementable Element>
+const std::vector<Element>& SymmetricMatrix<Element>::get_data() const noexcept
+{
+	return storage;
+}
+
+template <Elementable Element>
+Element SymmetricMatrix<Element>::at(size_t row_index, size_t col_index) const
+{
+	if (row_index >= size or col_index >= size)
+		throw std::out_of_range("the index is out of the matrix!");
+	return storage[index(std::max(row_index, col_index), std::min(row_index, col_index))];
+}
+
+template <Elementable Element>
+void SymmetricMatrix<Element>::set(size_t row_index, size_t col_index, const Element& value)
+{
+	if (row_index >= size or col_index >= size)
+		throw std::out_of_range("the index is out of the matrix!");
+	storage[index(std::max(row_index, col_index), std::min(row_index, col_index))] = value;
+}
+
+template <Elementable Element>
+Matrix<Element> SymmetricMatrix<Element>::to_dense() const
+{
+	Matrix<Element> result(size, size);
+	const auto result_rows = result.mutable_rows();
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		const Element* row = storage.data() + index(row_index, 0);
+		for (size_t col_index = 0; col_index <= row_index; ++col_index)
+		{
+			result_rows.row_data(row_index)[col_index] = row[col_index];
+			result_rows.row_data(col_index)[row_index] = row[col_index];
+		}
+	}
+	return result;
+}
+
+template <Elementable Element>
+SymmetricMatrix<Element>::operator Matrix<Element>() const
+{
+	return to_dense();
+}
+
+template <Elementable Element>
+void SymmetricMatrix<Element>::multiply(const Element* x, Element* y) const
+{
+	// the stored row up to the diagonal, then the column below it read from the rows further down
+	matrix_helper::parallel_for(size, size, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = begin; row_index < end; ++row_index)
+		{
+			Element sum = matrix_kernel::dot(row_index + 1, storage.data() + index(row_index, 0), x);
+			for (size_t k = row_index + 1; k < size; ++k)
+				sum += storage[index(k, row_index)] * x[k];
+			y[row_index] = sum;
+		}
+	});
+}
+
+template <Elementable Element>
+std::vector<Element> SymmetricMatrix<Element>::operator*(const std::vector<Element>& x) const
+{
+	if (x.size() != size)
+		throw std::invalid_argument("the number of rows must match the number of columns.");
+
+	std::vector<Element> y(size);
+	multiply(x.data(), y.data());
+	return y;
+}
+
+template <Elementable Element>
+Matrix<Element> SymmetricMatrix<Element>::operator*(const Matrix<Element>& other) const
+{
+	if (other.get_number_of_row() != size)
+		throw std::invalid_argument("the number of rows must match the number of columns.");
+
+	const size_t number_of_rhs = other.get_number_of_col();
+	Matrix<Element> result(size, number_of_rhs);
+	const auto result_rows = result.mutable_rows();
+	matrix_helper::parallel_for(size, size * number_of_rhs, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = begin; row_index < end; ++row_index)
+		{
+			Element* result_row = result_rows.row_data(row_index);
+			for (size_t k = 0; k < size; ++k)
+			{
+				const Element& value = storage[index(std::max(row_index, k), std::min(row_index, k))];
+				matrix_kernel::axpy(number_of_rhs, value, other.row_data(k), result_row);
+			}
+		}
+	});
+	return result;
+}
+
+template <Elementable Element>
+SymmetricMatrix<Element> SymmetricMatrix<Element>::operator*(const Element& scalar) const
+{
+	SymmetricMatrix result(size);
+	matrix_kernel::scale(storage.size(), storage.data(), scalar, result.storage.data());
+	return result;
+}
+
+template <Elementable Element>
+SymmetricMatrix<Element> SymmetricMatrix<Element>::operator+(const SymmetricMatrix& other) const
+{
+	check_same_size(other);
+
+	SymmetricMatrix result = *this;
+	matrix_kernel::axpy(storage.size(), Element(1), other.storage.data(), result.storage.data());
+	return result;
+}
+
+template <Elementable Element>
+SymmetricMatrix<Element> SymmetricMatrix<Element>::operator-(const SymmetricMatrix& other) const
+{
+	check_same_size(other);
+
+	SymmetricMatrix result = *this;
+	matrix_kernel::axpy(storage.size(), Element(-1), other.storage.data(), result.storage.data());
+	return result;
+}
+
+template <Elementable Element>
+bool SymmetricMatrix<Element>::try_cholesky(TriangularMatrix<Element>& lower) const
+{
+	using std::sqrt;
+
+	// the packed lower triangle is laid out exactly as a lower TriangularMatrix, and every operand of the row by row
+	// Cholesky L[i][j] = (A[i][j] - L[i][0:j] . L[j][0:j]) / L[j][j] is a contiguous prefix of a packed row
+	lower = TriangularMatrix<Element>(size, TriangularPart::lower);
+	lower.storage = storage;
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		Element* row = lower.row_data(row_index);
+		for (size_t col_index = 0; col_index < row_index; ++col_index)
+		{
+			const Element* pivot_row = lower.row_data(col_index);
+			row[col_index] = (row[col_index] - matrix_kernel::dot(col_index, row, pivot_row)) / pivot_row[col_index];
+		}
+		const Element pivot = row[row_index] - matrix_kernel::dot(row_index, row, row);
+		if (not(pivot > 0))
+			return false;
+		row[row_index] = sqrt(pivot);
+	}
+	return true;
+}
+
+template <Elementable Element>
+TriangularMatrix<Element> SymmetricMatrix<Element>::cholesky() const
+{
+	TriangularMatrix<Element> lower;
+	if (not try_cholesky(lower))
+		throw std::invalid_argument("the matrix should be positive definite!");
+	return lower;
+}
+
+template <Elementable Element>
+Element SymmetricMatrix<Element>::determinant() const
+{
+	if constexpr (std::floating_point<Element>)
+	{
+		TriangularMatrix<Element> lower;
+		if (try_cholesky(lower))
+		{
+			const Element det = lower.determinant();
+			return det * det;
+		}
+	}
+	return to_dense().determinant();
+}
+
+template <Elementable Element>
+std::vector<Element> SymmetricMatrix<Element>::solve(const std::vector<Element>& b) const
+{
+	if (b.size() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+
+	if constexpr (std::floating_point<Element>)
+	{
+		TriangularMatrix<Element> lower;
+		if (try_cholesky(lower))
+			return lower.transpose().solve(lower.solve(b));
+	}
+	return to_dense().solve(b);
+}
+
+template <Elementable Element>
+Matrix<Element> SymmetricMatrix<Element>::solve(const Matrix<Element>& b) const
+{
+	if (b.get_number_of_row() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+
+	if constexpr (std::floating_point<Element>)
+	{
+		TriangularMatrix<Element> lower;
+		if (try_cholesky(lower))
+			return lower.transpose().solve(lower.solve(b));
+	}
+	return to_dense().solve(b);
+}
+
+template <Elementable Element>
+SymmetricMatrix<Element> SymmetricMatrix<Element>::inverse() const
+{
+	if constexpr (std::floating_point<Element>)
+	{
+		TriangularMatrix<Element> lower;
+		if (try_cholesky(lower))
+		{
+			// A^-1 = L^-T * L^-1, whose row i up to the diagonal sums L^-1[k][i] * row k of L^-1 over k >= i
+			const TriangularMatrix<Element> inverse_lower = lower.inverse();
+			SymmetricMatrix result(size);
+			matrix_helper::parallel_for(size, size * size / 4 + 1, [&](size_t begin, size_t end)
+			{
+				for (size_t row_index = begin; row_index < end; ++row_index)
+				{
+					Element* result_row = result.storage.data() + index(row_index, 0);
+					for (size_t k = row_index; k < size; ++k)
+					{
+						const Element* inverse_row = inverse_lower.row_data(k);
+						matrix_kernel::axpy(row_index + 1, inverse_row[row_index], inverse_row, result_row);
+					}
+				}
+			});
+			return result;
+		}
+	}
+	return SymmetricMatrix(to_dense().inverse());
+}
+
+template <Elementable Element>
+void SymmetricMatrix<Element>::check_same_size(const SymmetricMatrix& other) const
+{
+	if (size != other.size)
+		throw std::invalid_argument("the matrices should have the same size!");
+}
+
+#endif
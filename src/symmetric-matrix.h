@@ -0,0 +1,65 @@
+#ifndef MATRIX_SYMMETRIC_MATRIX_H
+#define MATRIX_SYMMETRIC_MATRIX_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+#include "triangular-matrix.h"
+
+// Symmetric matrix keeping its lower triangle packed row by row, size * (size + 1) / 2 elements; setting A[i][j] sets
+// A[j][i] too. Determinant, solve and inverse go through a packed Cholesky factor when the matrix is positive definite
+// and through a dense LU otherwise.
+template <Elementable Element>
+class SymmetricMatrix
+{
+public:
+	SymmetricMatrix() = default;
+	// size x size without any non-zero
+	explicit SymmetricMatrix(size_t size);
+	// only the lower triangle of matrix is read
+	explicit SymmetricMatrix(const Matrix<Element>& matrix);
+
+	[[nodiscard]] size_t get_size() const noexcept;
+	// the packed rows of the lower triangle one after another
+	[[nodiscard]] const std::vector<Element>& get_data() const noexcept;
+
+	[[nodiscard]] Element at(size_t row_index, size_t col_index) const;
+	void set(size_t row_index, size_t col_index, const Element& value);
+
+	[[nodiscard]] Matrix<Element> to_dense() const;
+	[[nodiscard]] explicit operator Matrix<Element>() const;
+
+	// y = A * x, this makes a SymmetricMatrix a LinearOperator
+	void multiply(const Element* x, Element* y) const;
+	[[nodiscard]] std::vector<Element> operator*(const std::vector<Element>& x) const;
+	[[nodiscard]] Matrix<Element> operator*(const Matrix<Element>& other) const;
+	[[nodiscard]] SymmetricMatrix operator*(const Element& scalar) const;
+	[[nodiscard]] SymmetricMatrix operator+(const SymmetricMatrix& other) const;
+	[[nodiscard]] SymmetricMatrix operator-(const SymmetricMatrix& other) const;
+	bool operator==(const SymmetricMatrix& other) const = default;
+
+	// L with A = L * L^T, throws std::invalid_argument when A is not positive definite
+	[[nodiscard]] TriangularMatrix<Element> cholesky() const;
+	[[nodiscard]] Element determinant() const;
+	[[nodiscard]] std::vector<Element> solve(const std::vector<Element>& b) const;
+	[[nodiscard]] Matrix<Element> solve(const Matrix<Element>& b) const;
+	[[nodiscard]] SymmetricMatrix inverse() const;
+
+private:
+	// position of A[row_index][col_index] in storage for col_index <= row_index
+	[[nodiscard]] static size_t index(size_t row_index, size_t col_index) noexcept;
+
+	void check_same_size(const SymmetricMatrix& other) const;
+	// false at the first non-positive pivot
+	bool try_cholesky(TriangularMatrix<Element>& lower) const;
+
+	size_t size = 0;
+	std::vector<Element> storage;
+};
+
+#include "symmetric-matrix-tmp.h"
+
+#endif
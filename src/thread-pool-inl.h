@@ -0,0 +1,205 @@
+#ifndef MATRIX_THREAD_POOL_INL_H
+#define MATRIX_THREAD_POOL_INL_H
+
+#include <algorithm>
+#include <exception>
+
+#include "thread-pool.h"
+
+inline ThreadPool::ThreadPool(size_t number_of_thread)
+{
+	start(number_of_thread);
+}
+
+inline ThreadPool::~ThreadPool()
+{
+	stop();
+}
+
+inline ThreadPool& ThreadPool::get_instance()
+{
+	static ThreadPool instance;
+	return instance;
+}
+
+inline size_t ThreadPool::default_number_of_thread() noexcept
+{
+	return std::max(1U, std::thread::hardware_concurrency());
+}
+
+inline size_t ThreadPool::get_number_of_thread() const noexcept
+{
+	return number_of_thread;
+}
+
+inline void ThreadPool::set_number_of_thread(size_t new_number_of_thread)
+{
+	stop();
+	start(new_number_of_thread);
+}
+
+inline void ThreadPool::start(size_t new_number_of_thread)
+{
+	number_of_thread = std::max<size_t>(1, new_number_of_thread);
+	stopping = false;
+
+	const size_t number_of_worker = number_of_thread - 1;
+	for (size_t i = 0; i < number_of_worker; ++i)
+		queues.emplace_back(std::make_unique<TaskQueue>());
+	for (size_t i = 0; i < number_of_worker; ++i)
+		workers.emplace_back(&ThreadPool::worker_loop, this, i);
+}
+
+inline void ThreadPool::stop()
+{
+	{
+		std::lock_guard lock(sleep_mutex);
+		stopping = true;
+	}
+	sleep_condition.notify_all();
+
+	for (std::thread& worker : workers)
+		worker.join();
+
+	workers.clear();
+	queues.clear();
+	number_of_pending_task = 0;
+}
+
+inline void ThreadPool::submit(Task task)
+{
+	const size_t queue_index = current_worker_index != NOT_A_WORKER ? current_worker_index :
+			next_queue_index.fetch_add(1, std::memory_order_relaxed) % queues.size();
+	{
+		std::lock_guard lock(queues[queue_index]->mutex);
+		queues[queue_index]->tasks.emplace_back(std::move(task));
+	}
+	{
+		std::lock_guard lock(sleep_mutex);
+		++number_of_pending_task;
+	}
+	sleep_condition.notify_one();
+}
+
+inline bool ThreadPool::try_pop(Task& task)
+{
+	if (current_worker_index == NOT_A_WORKER)
+		return false;
+
+	TaskQueue& queue = *queues[current_worker_index];
+	std::lock_guard lock(queue.mutex);
+	if (queue.tasks.empty())
+		return false;
+
+	// own queue is used as a stack: the newest task is the one whose data is still in cache
+	task = std::move(queue.tasks.back());
+	queue.tasks.pop_back();
+	return true;
+}
+
+inline bool ThreadPool::try_steal(Task& task)
+{
+	const size_t first_victim = current_worker_index == NOT_A_WORKER ? 0 : current_worker_index + 1;
+	for (size_t i = 0; i < queues.size(); ++i)
+	{
+		TaskQueue& queue = *queues[(first_victim + i) % queues.size()];
+		std::unique_lock lock(queue.mutex, std::try_to_lock);
+		if (not lock.owns_lock() or queue.tasks.empty())
+			continue;
+
+		task = std::move(queue.tasks.front());
+		queue.tasks.pop_front();
+		return true;
+	}
+	return false;
+}
+
+inline bool ThreadPool::run_pending_task()
+{
+	Task task;
+	if (not try_pop(task) and not try_steal(task))
+		return false;
+
+	--number_of_pending_task;
+	task();
+	return true;
+}
+
+inline void ThreadPool::worker_loop(size_t worker_index)
+{
+	current_worker_index = worker_index;
+	while (true)
+	{
+		if (run_pending_task())
+			continue;
+
+		std::unique_lock lock(sleep_mutex);
+		sleep_condition.wait(lock, [this] { return stopping or number_of_pending_task > 0; });
+		if (stopping)
+			break;
+	}
+	current_worker_index = NOT_A_WORKER;
+}
+
+template <typename Function>
+void ThreadPool::parallel_for(size_t begin, size_t end, size_t grain_size, Function&& function)
+{
+	if (begin >= end)
+		return;
+
+	grain_size = std::max<size_t>(1, grain_size);
+	const size_t size = end - begin;
+	const size_t number_of_chunk = std::min((size + grain_size - 1) / grain_size, number_of_thread * 4);
+	if (number_of_chunk <= 1 or workers.empty())
+	{
+		function(begin, end);
+		return;
+	}
+
+	struct SharedState
+	{
+		std::atomic<size_t> next_chunk = 0;
+		std::atomic<size_t> finished_chunk = 0;
+		std::mutex exception_mutex;
+		std::exception_ptr exception;
+	};
+	const auto state = std::make_shared<SharedState>();
+	const size_t chunk_size = (size + number_of_chunk - 1) / number_of_chunk;
+
+	const auto run_chunks = [state, &function, begin, end, chunk_size, number_of_chunk]
+	{
+		for (size_t chunk = state->next_chunk++; chunk < number_of_chunk; chunk = state->next_chunk++)
+		{
+			const size_t chunk_begin = begin + chunk * chunk_size;
+			const size_t chunk_end = std::min(end, chunk_begin + chunk_size);
+			try
+			{
+				if (chunk_begin < chunk_end)
+					function(chunk_begin, chunk_end);
+			}
+			catch (...)
+			{
+				std::lock_guard lock(state->exception_mutex);
+				if (not state->exception)
+					state->exception = std::current_exception();
+			}
+			++state->finished_chunk;
+		}
+	};
+
+	const size_t number_of_helper = std::min(workers.size(), number_of_chunk - 1);
+	for (size_t i = 0; i < number_of_helper; ++i)
+		submit(run_chunks);
+
+	run_chunks();
+	while (state->finished_chunk < number_of_chunk)
+	{
+		if (not run_pending_task())
+			std::this_thread::yield();
+	}
+
+	if (state->exception)
+		std::rethrow_exception(state->exception);
+}
+
+#endif
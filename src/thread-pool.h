@@ -0,0 +1,71 @@
+#ifndef MATRIX_THREAD_POOL_H
+#define MATRIX_THREAD_POOL_H
+
+#include <cstddef>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool shared by every Matrix operation. The thread that calls parallel_for takes part in the work,
+// so a pool of n threads owns n - 1 workers.
+class ThreadPool
+{
+private:
+	using Task = std::function<void()>;
+
+	struct TaskQueue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+public:
+	explicit ThreadPool(size_t number_of_thread = default_number_of_thread());
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool& other) = delete;
+	ThreadPool& operator=(const ThreadPool& other) = delete;
+
+	[[nodiscard]] static ThreadPool& get_instance();
+	[[nodiscard]] static size_t default_number_of_thread() noexcept;
+
+	[[nodiscard]] size_t get_number_of_thread() const noexcept;
+	// must not be called while the pool is running a parallel_for
+	void set_number_of_thread(size_t number_of_thread);
+
+	// calls function(chunk_begin, chunk_end) on disjoint chunks of [begin, end) that hold at least grain_size indices
+	template <typename Function>
+	void parallel_for(size_t begin, size_t end, size_t grain_size, Function&& function);
+
+private:
+	void start(size_t number_of_thread);
+	void stop();
+
+	void submit(Task task);
+	bool try_pop(Task& task);
+	bool try_steal(Task& task);
+	bool run_pending_task();
+	void worker_loop(size_t worker_index);
+
+	static constexpr size_t NOT_A_WORKER = static_cast<size_t>(-1);
+	static inline thread_local size_t current_worker_index = NOT_A_WORKER;
+
+	size_t number_of_thread = 1;
+	std::vector<std::unique_ptr<TaskQueue>> queues;
+	std::vector<std::thread> workers;
+	std::atomic<size_t> next_queue_index = 0;
+	std::atomic<size_t> number_of_pending_task = 0;
+	std::mutex sleep_mutex;
+	std::condition_variable sleep_condition;
+	bool stopping = false;
+};
+
+#include "thread-pool-inl.h"
+
+#endif
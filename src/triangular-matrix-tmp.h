@@ -0,0 +1,364 @@
+#ifndef MATRIX_TRIANGULAR_MATRIX_TMP_H
+#define MATRIX_TRIANGULAR_MATRIX_TMP_H
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "matrix-helper.h"
+#include "matrix-kernel.h"
+#include "triangular-matrix.h"
+
+template <Elementable Element>
+TriangularMatrix<Element>::TriangularMatrix(size_t size, TriangularPart part)
+: size(size)
+, part(part)
+, storage(size * (size + 1) / 2, Element(0))
+{
+}
+
+template <Elementable Element>
+TriangularMatrix<Element>::TriangularMatrix(const Matrix<Element>& matrix, TriangularPart part)
+: TriangularMatrix(matrix.get_number_of_row(), part)
+{
+	if (matrix.get_number_of_row() != matrix.get_number_of_col())
+		throw std::invalid_argument("the matrix should be square!");
+
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		std::copy(matrix.row_data(row_index) + first_col(row_index), matrix.row_data(row_index) + last_col(row_index),
+				row_data(row_index));
+	}
+}
+
+template <Elementable Element>
+size_t TriangularMatrix<Element>::offset(size_t row_index) const noexcept
+{
+	if (part == TriangularPart::lower)
+		return row_index * (row_index + 1) / 2;
+	return row_index * size - row_index * (row_index - 1) / 2;
+}
+
+template <Elementable Element>
+size_t TriangularMatrix<Element>::first_col(size_t row_index) const noexcept
+{
+	return part == TriangularPart::lower ? 0 : row_index;
+}
+
+template <Elementable Element>
+size_t TriangularMatrix<Element>::last_col(size_t row_index) const noexcept
+{
+	return part == TriangularPart::lower ? row_index + 1 : size;
+}
+
+template <Elementable Element>
+const Element* TriangularMatrix<Element>::row_data(size_t row_index) const noexcept
+{
+	return storage.data() + offset(row_index);
+}
+
+template <Elementable Element>
+Element* TriangularMatrix<Element>::row_data(size_t row_index) noexcept
+{
+	return storage.data() + offset(row_index);
+}
+
+template <Elementable Element>
+size_t TriangularMatrix<Element>::get_size() const noexcept
+{
+	return size;
+}
+
+template <Elementable Element>
+TriangularPart TriangularMatrix<Element>::get_part() const noexcept
+{
+	return part;
+}
+
+template <Elementable Element>
+const std::vector<Element>& TriangularMatrix<Element>::get_data() const noexcept
+{
+	return storage;
+}
+
+template <Elementable Element>
+Element TriangularMatrix<Element>::at(size_t row_index, size_t col_index) const
+{
+	if (row_index >= size or col_index >= size)
+		throw std::out_of_range("the index is out of the matrix!");
+	if (col_index < first_col(row_index) or col_index >= last_col(row_index))
+		return Element(0);
+	return row_data(row_index)[col_index - first_col(row_index)];
+}
+
+template <Elementable Element>
+void TriangularMatrix<Element>::set(size_t row_index, size_t col_index, const Element& value)
+{
+	if (row_index >= size or col_index >= size or col_index < first_col(row_index) or
+			col_index >= last_col(row_index))
+		throw std::out_of_range("the index is out of the stored triangle!");
+	row_data(row_index)[col_index - first_col(row_index)] = value;
+}
+
+template <Elementable Element>
+Matrix<Element> TriangularMatrix<Element>::to_dense() const
+{
+	Matrix<Element> result(size, size);
+	const auto result_rows = result.mutable_rows();
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		std::copy(row_data(row_index), row_data(row_index) + (last_col(row_index) - first_col(row_index)),
+				result_rows.row_data(row_index) + first_col(row_index));
+	}
+	return result;
+}
+
+template <Elementable Element>
+TriangularMatrix<Element>::operator Matrix<Element>() const
+{
+	return to_dense();
+}
+
+template <Elementable Element>
+TriangularMatrix<Element> TriangularMatrix<Element>::transpose() const
+{
+	TriangularMatrix result(size, part == TriangularPart::lower ? TriangularPart::upper : TriangularPart::lower);
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		for (size_t col_index = first_col(row_index); col_index < last_col(row_index); ++col_index)
+			result.row_data(col_index)[row_index - result.first_col(col_index)] =
+					row_data(row_index)[col_index - first_col(row_index)];
+	}
+	return result;
+}
+
+template <Elementable Element>
+void TriangularMatrix<Element>::multiply(const Element* x, Element* y) const
+{
+	matrix_helper::parallel_for(size, size / 2 + 1, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = begin; row_index < end; ++row_index)
+		{
+			const size_t first = first_col(row_index);
+			y[row_index] = matrix_kernel::dot(last_col(row_index) - first, row_data(row_index), x + first);
+		}
+	});
+}
+
+template <Elementable Element>
+std::vector<Element> TriangularMatrix<Element>::operator*(const std::vector<Element>& x) const
+{
+	if (x.size() != size)
+		throw std::invalid_argument("the number of rows must match the number of columns.");
+
+	std::vector<Element> y(size);
+	multiply(x.data(), y.data());
+	return y;
+}
+
+template <Elementable Element>
+Matrix<Element> TriangularMatrix<Element>::operator*(const Matrix<Element>& other) const
+{
+	if (other.get_number_of_row() != size)
+		throw std::invalid_argument("the number of rows must match the number of columns.");
+
+	// row i of the product is the sum of A[i][k] * row k of other over the stored part of row i
+	const size_t number_of_rhs = other.get_number_of_col();
+	Matrix<Element> result(size, number_of_rhs);
+	const auto result_rows = result.mutable_rows();
+	matrix_helper::parallel_for(size, (size / 2 + 1) * number_of_rhs, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = begin; row_index < end; ++row_index)
+		{
+			const Element* row = row_data(row_index);
+			for (size_t k = first_col(row_index); k < last_col(row_index); ++k)
+				matrix_kernel::axpy(number_of_rhs, row[k - first_col(row_index)], other.row_data(k),
+						result_rows.row_data(row_index));
+		}
+	});
+	return result;
+}
+
+template <Elementable Element>
+TriangularMatrix<Element> TriangularMatrix<Element>::operator*(const TriangularMatrix& other) const
+{
+	check_same_shape(other);
+
+	// row k of other only reaches the columns stored in row i of the product
+	TriangularMatrix result(size, part);
+	matrix_helper::parallel_for(size, size, [&](size_t begin, size_t end)
+	{
+		for (size_t row_index = begin; row_index < end; ++row_index)
+		{
+			const Element* row = row_data(row_index);
+			Element* result_row = result.row_data(row_index);
+			for (size_t k = first_col(row_index); k < last_col(row_index); ++k)
+			{
+				const size_t first = other.first_col(k);
+				matrix_kernel::axpy(other.last_col(k) - first, row[k - first_col(row_index)], other.row_data(k),
+						result_row + (first - first_col(row_index)));
+			}
+		}
+	});
+	return result;
+}
+
+template <Elementable Element>
+TriangularMatrix<Element> TriangularMatrix<Element>::operator*(const Element& scalar) const
+{
+	TriangularMatrix result(size, part);
+	matrix_kernel::scale(storage.size(), storage.data(), scalar, result.storage.data());
+	return result;
+}
+
+template <Elementable Element>
+TriangularMatrix<Element> TriangularMatrix<Element>::operator+(const TriangularMatrix& other) const
+{
+	check_same_shape(other);
+
+	TriangularMatrix result = *this;
+	matrix_kernel::axpy(storage.size(), Element(1), other.storage.data(), result.storage.data());
+	return result;
+}
+
+template <Elementable Element>
+TriangularMatrix<Element> TriangularMatrix<Element>::operator-(const TriangularMatrix& other) const
+{
+	check_same_shape(other);
+
+	TriangularMatrix result = *this;
+	matrix_kernel::axpy(storage.size(), Element(-1), other.storage.data(), result.storage.data());
+	return result;
+}
+
+template <Elementable Element>
+Element TriangularMatrix<Element>::determinant() const
+{
+	if constexpr (Integrable<Element>)
+	{
+		// a zero further down the diagonal still makes a product that overflowed zero
+		for (size_t i = 0; i < size; ++i)
+		{
+			if (at(i, i) == 0)
+				return 0;
+		}
+	}
+
+	Element det = 1;
+	for (size_t i = 0; i < size; ++i)
+	{
+		if constexpr (Integrable<Element>)
+		{
+			if (not matrix_helper::checked_multiply(det, at(i, i), det))
+				throw std::overflow_error("the determinant does not fit in the element type!");
+		}
+		else
+			det *= at(i, i);
+	}
+	return det;
+}
+
+template <Elementable Element>
+std::vector<Element> TriangularMatrix<Element>::solve(const std::vector<Element>& b) const
+{
+	if (b.size() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+	check_non_singular();
+
+	std::vector<Element> x = b;
+	substitute(x.data(), 1, 1);
+	return x;
+}
+
+template <Elementable Element>
+Matrix<Element> TriangularMatrix<Element>::solve(const Matrix<Element>& b) const
+{
+	if (b.get_number_of_row() != size)
+		throw std::invalid_argument("the number of rows of the right-hand side must match the matrix.");
+	check_non_singular();
+
+	Matrix<Element> x = b;
+	Element* const x_data = x.mutable_rows().row_data(0);
+	matrix_helper::parallel_for(x.get_number_of_col(), size * size / 2 + 1, [&](size_t begin, size_t end)
+	{
+		substitute(x_data + begin, end - begin, x.get_stride());
+	});
+	return x;
+}
+
+template <Elementable Element>
+TriangularMatrix<Element> TriangularMatrix<Element>::inverse() const
+{
+	check_non_singular();
+	if (part == TriangularPart::upper)
+		return transpose().inverse().transpose();
+
+	// row i of L^-1 is -(sum over k < i of L[i][k] * row k of L^-1) / L[i][i], and row k stops at column k
+	TriangularMatrix result(size, part);
+	for (size_t row_index = 0; row_index < size; ++row_index)
+	{
+		const Element* row = row_data(row_index);
+		Element* result_row = result.row_data(row_index);
+		for (size_t k = 0; k < row_index; ++k)
+			matrix_kernel::axpy(k + 1, row[k], result.row_data(k), result_row);
+		const Element inverse_diagonal = Element(1) / row[row_index];
+		matrix_kernel::scale(row_index, result_row, -inverse_diagonal, result_row);
+		result_row[row_index] = inverse_diagonal;
+	}
+	return result;
+}
+
+template <Elementable Element>
+void TriangularMatrix<Element>::check_same_shape(const TriangularMatrix& other) const
+{
+	if (size != other.size or part != other.part)
+		throw std::invalid_argument("the matrices should have the same size!");
+}
+
+template <Elementable Element>
+void TriangularMatrix<Element>::check_non_singular() const
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		if (at(i, i) == Element(0))
+			throw std::invalid_argument("the matrix should not be the determinant equal to zero!");
+	}
+}
+
+template <Elementable Element>
+void TriangularMatrix<Element>::substitute(Element* x, size_t number_of_rhs, size_t x_stride) const
+{
+	// forward for lower, backward for upper, subtracting the solved rows of X one stored entry at a time
+	const auto solve_row = [&](size_t row_index)
+	{
+		const Element* row = row_data(row_index);
+		const size_t first = first_col(row_index);
+		Element* x_row = x + row_index * x_stride;
+		// a single contiguous right-hand side is one dot product with the solved part
+		if (number_of_rhs == 1 and x_stride == 1)
+		{
+			if (part == TriangularPart::lower)
+				*x_row = (*x_row - matrix_kernel::dot(row_index, row, x)) / row[row_index];
+			else
+				*x_row = (*x_row - matrix_kernel::dot(size - row_index - 1, row + 1, x_row + 1)) / row[0];
+			return;
+		}
+		for (size_t k = first; k < last_col(row_index); ++k)
+		{
+			if (k != row_index)
+				matrix_kernel::axpy(number_of_rhs, -row[k - first], x + k * x_stride, x_row);
+		}
+		matrix_kernel::scale(number_of_rhs, x_row, Element(1) / row[row_index - first], x_row);
+	};
+	if (part == TriangularPart::lower)
+	{
+		for (size_t row_index = 0; row_index < size; ++row_index)
+			solve_row(row_index);
+	}
+	else
+	{
+		for (size_t row_index = size; row_index-- > 0;)
+			solve_row(row_index);
+	}
+}
+
+#endif
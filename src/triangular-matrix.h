@@ -0,0 +1,84 @@
+#ifndef MATRIX_TRIANGULAR_MATRIX_H
+#define MATRIX_TRIANGULAR_MATRIX_H
+
+#include <cstddef>
+
+#include <vector>
+
+#include "concept.h"
+#include "matrix.h"
+
+enum class TriangularPart
+{
+	lower,
+	upper,
+};
+
+// Lower or upper triangular matrix packed row by row, size * (size + 1) / 2 elements instead of size * size: row i
+// holds columns 0 .. i when lower and i .. size - 1 when upper, so every row is contiguous. The determinant is the
+// product of the diagonal, solves are one substitution and the inverse stays in the same triangle.
+template <Elementable Element>
+class TriangularMatrix
+{
+public:
+	TriangularMatrix() = default;
+	// size x size without any non-zero
+	explicit TriangularMatrix(size_t size, TriangularPart part = TriangularPart::lower);
+	// the other triangle of matrix is ignored
+	explicit TriangularMatrix(const Matrix<Element>& matrix, TriangularPart part = TriangularPart::lower);
+
+	[[nodiscard]] size_t get_size() const noexcept;
+	[[nodiscard]] TriangularPart get_part() const noexcept;
+	// the packed rows one after another
+	[[nodiscard]] const std::vector<Element>& get_data() const noexcept;
+
+	// zero outside the triangle
+	[[nodiscard]] Element at(size_t row_index, size_t col_index) const;
+	// throws std::out_of_range outside the triangle
+	void set(size_t row_index, size_t col_index, const Element& value);
+
+	[[nodiscard]] Matrix<Element> to_dense() const;
+	[[nodiscard]] explicit operator Matrix<Element>() const;
+	[[nodiscard]] TriangularMatrix transpose() const;
+
+	// y = A * x, this makes a TriangularMatrix a LinearOperator
+	void multiply(const Element* x, Element* y) const;
+	[[nodiscard]] std::vector<Element> operator*(const std::vector<Element>& x) const;
+	[[nodiscard]] Matrix<Element> operator*(const Matrix<Element>& other) const;
+	// both in the same triangle, and so is the product
+	[[nodiscard]] TriangularMatrix operator*(const TriangularMatrix& other) const;
+	[[nodiscard]] TriangularMatrix operator*(const Element& scalar) const;
+	[[nodiscard]] TriangularMatrix operator+(const TriangularMatrix& other) const;
+	[[nodiscard]] TriangularMatrix operator-(const TriangularMatrix& other) const;
+	bool operator==(const TriangularMatrix& other) const = default;
+
+	// integer elements throw std::overflow_error when the product does not fit, like Matrix::determinant
+	[[nodiscard]] Element determinant() const;
+	[[nodiscard]] std::vector<Element> solve(const std::vector<Element>& b) const;
+	[[nodiscard]] Matrix<Element> solve(const Matrix<Element>& b) const;
+	[[nodiscard]] TriangularMatrix inverse() const;
+
+private:
+	template <Elementable OtherElement>
+	friend class SymmetricMatrix;
+
+	// position of the first stored element of a row in storage
+	[[nodiscard]] size_t offset(size_t row_index) const noexcept;
+	[[nodiscard]] size_t first_col(size_t row_index) const noexcept;
+	[[nodiscard]] size_t last_col(size_t row_index) const noexcept;
+	[[nodiscard]] const Element* row_data(size_t row_index) const noexcept;
+	[[nodiscard]] Element* row_data(size_t row_index) noexcept;
+
+	void check_same_shape(const TriangularMatrix& other) const;
+	void check_non_singular() const;
+	// X = A^-1 * X for the size x number_of_rhs row-major block X
+	void substitute(Element* x, size_t number_of_rhs, size_t x_stride) const;
+
+	size_t size = 0;
+	TriangularPart part = TriangularPart::lower;
+	std::vector<Element> storage;
+};
+
+#include "triangular-matrix-tmp.h"
+
+#endif
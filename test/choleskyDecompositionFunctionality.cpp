@@ -0,0 +1,121 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "cholesky-decomposition.h"
+#include "ldlt-decomposition.h"
+
+using namespace ::testing;
+
+class CholeskyDecompositionFunctionality : public Test
+{
+protected:
+	// M * M^T + shift * I, symmetric positive definite for a positive shift
+	static Matrix<double> create_gram_matrix(size_t size, double shift)
+	{
+		std::vector<std::vector<double>> table(size, std::vector<double>(size));
+		for (size_t i = 0; i < size; ++i)
+			for (size_t j = 0; j < size; ++j)
+				table[i][j] = static_cast<double>((i * 13 + j * 7) % 19) / 19 - 0.5;
+		const Matrix<double> factor(table);
+		return factor * factor.transpose() + shift * Matrix<double>::create_i_matrix(size);
+	}
+};
+
+TEST_F(CholeskyDecompositionFunctionality, LowerTimesItsTransposeShouldEqualTheMatrix)
+{
+	constexpr size_t SIZE = 150;
+	const Matrix<double> matrix = create_gram_matrix(SIZE, 1);
+	const CholeskyDecomposition<double> cholesky(matrix, true);
+	ASSERT_TRUE(cholesky.is_positive_definite());
+
+	const Matrix<double>& lower = cholesky.get_lower();
+	EXPECT_TRUE(lower.is_lower_triangular());
+	const Matrix<double> product = lower * lower.transpose();
+	for (size_t i = 0; i < SIZE; ++i)
+		for (size_t j = 0; j < SIZE; ++j)
+			EXPECT_NEAR(product[i][j], matrix[i][j], 1e-10);
+
+	const LUDecomposition<double> lu(matrix);
+	EXPECT_NEAR(cholesky.log_determinant(), std::log(std::abs(lu.determinant())), 1e-8);
+}
+
+TEST_F(CholeskyDecompositionFunctionality, SolveAndInverseShouldMatchLU)
+{
+	constexpr size_t SIZE = 100;
+	const Matrix<double> matrix = create_gram_matrix(SIZE, 2);
+	const CholeskyDecomposition<double> cholesky = matrix.cholesky_decomposition();
+	const LUDecomposition<double> lu = matrix.lu_decomposition();
+
+	const Matrix<double> cholesky_inverse = cholesky.inverse();
+	const Matrix<double> lu_inverse = lu.inverse();
+	for (size_t i = 0; i < SIZE; ++i)
+		for (size_t j = 0; j < SIZE; ++j)
+			EXPECT_NEAR(cholesky_inverse[i][j], lu_inverse[i][j], 1e-10);
+
+	std::vector<double> b(SIZE);
+	for (size_t i = 0; i < SIZE; ++i)
+		b[i] = static_cast<double>(i % 7);
+	const std::vector<double> x = cholesky.solve(b);
+	const std::vector<double> expected = lu.solve(b);
+	for (size_t i = 0; i < SIZE; ++i)
+		EXPECT_NEAR(x[i], expected[i], 1e-10);
+	EXPECT_NEAR(matrix.determinant(), lu.determinant(), std::abs(lu.determinant()) * 1e-10);
+}
+
+TEST_F(CholeskyDecompositionFunctionality, IndefiniteOrAsymmetricMatrixShouldBeReported)
+{
+	const Matrix<double> indefinite({{1, 2, 0}, {2, 1, 3}, {0, 3, 1}});
+	const CholeskyDecomposition<double> cholesky(indefinite);
+	EXPECT_FALSE(cholesky.is_positive_definite());
+	EXPECT_THROW(std::ignore = cholesky.solve(std::vector<double>(3)), std::invalid_argument);
+	EXPECT_THROW(std::ignore = cholesky.log_determinant(), std::invalid_argument);
+
+	const Matrix<double> asymmetric({{4, 1}, {2, 3}});
+	EXPECT_NO_THROW(CholeskyDecomposition<double>{asymmetric});
+	EXPECT_THROW(CholeskyDecomposition<double>(asymmetric, true), std::invalid_argument);
+	EXPECT_THROW(LDLTDecomposition<double>(asymmetric, true), std::invalid_argument);
+}
+
+TEST_F(CholeskyDecompositionFunctionality, LDLTShouldFactorizeSymmetricIndefiniteMatrices)
+{
+	constexpr size_t SIZE = 130;
+	// the negative shift leaves the matrix symmetric but indefinite
+	const Matrix<double> matrix = create_gram_matrix(SIZE, -0.3);
+	const LDLTDecomposition<double> ldlt = matrix.ldlt_decomposition(true);
+	ASSERT_FALSE(ldlt.is_singular());
+	EXPECT_FALSE(matrix.cholesky_decomposition().is_positive_definite());
+
+	const std::vector<double> diagonal = ldlt.get_diagonal();
+	const Matrix<double> lower = ldlt.get_lower();
+	std::vector<std::vector<double>> diagonal_table(SIZE, std::vector<double>(SIZE));
+	for (size_t i = 0; i < SIZE; ++i)
+		diagonal_table[i][i] = diagonal[i];
+	const Matrix<double> product = lower * Matrix<double>(diagonal_table) * lower.transpose();
+	for (size_t i = 0; i < SIZE; ++i)
+		for (size_t j = 0; j < SIZE; ++j)
+			EXPECT_NEAR(product[i][j], matrix[i][j], 1e-9);
+
+	const LUDecomposition<double> lu(matrix);
+	EXPECT_NEAR(ldlt.determinant() / lu.determinant(), 1, 1e-8);
+	const Matrix<double> identity = matrix * ldlt.inverse();
+	for (size_t i = 0; i < SIZE; ++i)
+		for (size_t j = 0; j < SIZE; ++j)
+			EXPECT_NEAR(identity[i][j], i == j ? 1 : 0, 1e-8);
+
+	// without pivoting a zero leading minor stops the factorization, which does not make the matrix singular
+	const LDLTDecomposition<double> exchange(Matrix<double>({{0, 1}, {1, 0}}));
+	EXPECT_TRUE(exchange.has_broken_down());
+	EXPECT_FALSE(exchange.is_singular());
+	EXPECT_THROW(std::ignore = exchange.determinant(), std::invalid_argument);
+	EXPECT_THROW(std::ignore = exchange.solve(std::vector<double>{1, 2}), std::invalid_argument);
+	const LDLTDecomposition<double> rank_one(Matrix<double>({{1, 2}, {2, 4}}));
+	EXPECT_FALSE(rank_one.has_broken_down());
+	EXPECT_TRUE(rank_one.is_singular());
+	EXPECT_EQ(rank_one.determinant(), 0);
+	const LDLTDecomposition<double> zero(Matrix<double>(3, 3));
+	EXPECT_TRUE(zero.has_broken_down());
+	EXPECT_TRUE(zero.is_singular());
+	EXPECT_EQ(zero.determinant(), 0);
+}
@@ -0,0 +1,197 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <complex>
+
+#include "eigen-decomposition.h"
+#include "partial-eigen-decomposition.h"
+#include "symmetric-eigen-decomposition.h"
+#include "test-helper.h"
+
+using namespace ::testing;
+
+class EigenDecompositionFunctionality : public Test
+{
+protected:
+	// max_i |(A * v - lambda * v)_i| for every eigenpair
+	static void expect_eigenpairs(const Matrix<double>& matrix, const EigenDecomposition<double>& eigen,
+			double tolerance)
+	{
+		const size_t size = matrix.get_number_of_row();
+		const std::vector<std::vector<std::complex<double>>> eigenvectors = eigen.get_eigenvectors();
+		for (size_t k = 0; k < size; ++k)
+		{
+			const std::complex<double> eigenvalue = eigen.get_eigenvalues()[k];
+			for (size_t i = 0; i < size; ++i)
+			{
+				std::complex<double> product = 0;
+				for (size_t j = 0; j < size; ++j)
+					product += matrix[i][j] * eigenvectors[k][j];
+				EXPECT_NEAR(std::abs(product - eigenvalue * eigenvectors[k][i]), 0, tolerance);
+			}
+		}
+	}
+};
+
+TEST_F(EigenDecompositionFunctionality, RotationShouldHaveAComplexConjugatePair)
+{
+	const Matrix<double> rotation({{0, -2}, {2, 0}});
+	const EigenDecomposition<double> eigen(rotation, true);
+
+	ASSERT_EQ(eigen.get_eigenvalues().size(), 2u);
+	EXPECT_NEAR(eigen.get_eigenvalues()[0].real(), 0, 1e-12);
+	EXPECT_NEAR(eigen.get_eigenvalues()[0].imag(), 2, 1e-12);
+	EXPECT_EQ(eigen.get_eigenvalues()[1], std::conj(eigen.get_eigenvalues()[0]));
+	EXPECT_TRUE(eigen.get_real_eigenvalues().empty());
+	EXPECT_TRUE(rotation.eigenvalues().empty());
+	expect_eigenpairs(rotation, eigen, 1e-12);
+}
+
+TEST_F(EigenDecompositionFunctionality, GeneralMatrixShouldSatisfyEveryEigenpair)
+{
+	constexpr size_t SIZE = 80;
+	const Matrix<double> matrix = test_helper::create_test_matrix(SIZE);
+	const EigenDecomposition<double> eigen = matrix.eigen_decomposition(true);
+
+	std::complex<double> sum = 0;
+	for (const std::complex<double>& eigenvalue : eigen.get_eigenvalues())
+		sum += eigenvalue;
+	EXPECT_NEAR(sum.real(), matrix.tr(), 1e-10);
+	EXPECT_NEAR(sum.imag(), 0, 1e-10);
+	expect_eigenpairs(matrix, eigen, 1e-9);
+
+	// the same eigenvalues without accumulating the transformations
+	const EigenDecomposition<double> eigenvalues_only(matrix);
+	for (size_t i = 0; i < SIZE; ++i)
+		EXPECT_NEAR(std::abs(eigenvalues_only.get_eigenvalues()[i] - eigen.get_eigenvalues()[i]), 0, 1e-9);
+	EXPECT_THROW(std::ignore = eigenvalues_only.get_eigenvectors(), std::invalid_argument);
+}
+
+TEST_F(EigenDecompositionFunctionality, SimilarTriangularMatrixShouldKeepItsDiagonalAsEigenvalues)
+{
+	constexpr size_t SIZE = 40;
+	const Matrix<double> matrix = test_helper::create_similar_to_triangular(SIZE, 0.25);
+
+	std::vector<double> eigenvalues = matrix.eigenvalues();
+	ASSERT_EQ(eigenvalues.size(), SIZE);
+	std::sort(eigenvalues.begin(), eigenvalues.end());
+	for (size_t i = 0; i < SIZE; ++i)
+		EXPECT_NEAR(eigenvalues[i], static_cast<double>(i + 1), 1e-8);
+}
+
+TEST_F(EigenDecompositionFunctionality, SymmetricEigenShouldReturnSortedValuesAndOrthonormalVectors)
+{
+	constexpr size_t SIZE = 90;
+	// the test matrix alone is far from full rank, the diagonal separates its null space
+	std::vector<std::vector<double>> diagonal_table(SIZE, std::vector<double>(SIZE));
+	for (size_t i = 0; i < SIZE; ++i)
+		diagonal_table[i][i] = static_cast<double>(i) / 10;
+	const Matrix<double> factor = test_helper::create_test_matrix(SIZE);
+	const Matrix<double> matrix = factor + factor.transpose() + Matrix<double>(diagonal_table);
+	const SymmetricEigenDecomposition<double> eigen = matrix.symmetric_eigen();
+
+	const std::vector<double>& eigenvalues = eigen.get_eigenvalues();
+	EXPECT_TRUE(std::is_sorted(eigenvalues.begin(), eigenvalues.end()));
+	const Matrix<double>& vectors = eigen.get_eigenvectors();
+	const Matrix<double> gram = vectors.transpose() * vectors;
+	const Matrix<double> product = matrix * vectors;
+	for (size_t i = 0; i < SIZE; ++i)
+	{
+		for (size_t j = 0; j < SIZE; ++j)
+		{
+			EXPECT_NEAR(gram[i][j], i == j ? 1 : 0, 1e-12);
+			EXPECT_NEAR(product[i][j], eigenvalues[j] * vectors[i][j], 1e-11);
+		}
+	}
+
+	std::vector<double> general = matrix.eigen_decomposition().get_real_eigenvalues();
+	std::sort(general.begin(), general.end());
+	ASSERT_EQ(general.size(), SIZE);
+	const std::vector<double> values_only = matrix.eigenvalues();
+	for (size_t i = 0; i < SIZE; ++i)
+	{
+		EXPECT_NEAR(general[i], eigenvalues[i], 1e-10);
+		EXPECT_NEAR(values_only[i], eigenvalues[i], 1e-12);
+	}
+	EXPECT_THROW(std::ignore = matrix.symmetric_eigen(false).get_eigenvectors(), std::invalid_argument);
+}
+
+TEST_F(EigenDecompositionFunctionality, SymmetricEigenShouldReadOnlyTheLowerTriangle)
+{
+	// eigenvalues 2, 4 and 5; the upper triangle is ignored
+	const Matrix<double> matrix({{3, 0, 0}, {-1, 3, 0}, {0, 0, 5}});
+	const SymmetricEigenDecomposition<double> eigen(matrix);
+
+	EXPECT_NEAR(eigen.get_eigenvalues()[0], 2, 1e-14);
+	EXPECT_NEAR(eigen.get_eigenvalues()[1], 4, 1e-14);
+	EXPECT_NEAR(eigen.get_eigenvalues()[2], 5, 1e-14);
+	EXPECT_NEAR(std::abs(eigen.get_eigenvectors()[2][2]), 1, 1e-14);
+}
+
+TEST_F(EigenDecompositionFunctionality, TopEigenpairsShouldMatchTheFullSolvers)
+{
+	constexpr size_t SIZE = 150;
+	constexpr size_t K = 4;
+	const auto by_magnitude = [](const auto& first, const auto& second)
+	{
+		return std::abs(first) > std::abs(second);
+	};
+
+	std::vector<std::vector<double>> diagonal_table(SIZE, std::vector<double>(SIZE));
+	for (size_t i = 0; i < SIZE; ++i)
+		diagonal_table[i][i] = static_cast<double>(i) / 10;
+	const Matrix<double> factor = test_helper::create_test_matrix(SIZE);
+	const Matrix<double> symmetric = factor + factor.transpose() + Matrix<double>(diagonal_table);
+	std::vector<double> expected = symmetric.symmetric_eigen(false).get_eigenvalues();
+	std::sort(expected.begin(), expected.end(), by_magnitude);
+	for (const EigenSolverMethod method : {EigenSolverMethod::krylov, EigenSolverMethod::subspace_iteration})
+	{
+		const PartialEigenDecomposition<double> top = symmetric.top_eigenpairs(K, method);
+		const std::vector<double> eigenvalues = top.get_real_eigenvalues();
+		ASSERT_EQ(eigenvalues.size(), K);
+		const std::vector<std::vector<std::complex<double>>> eigenvectors = top.get_eigenvectors();
+		for (size_t k = 0; k < K; ++k)
+		{
+			EXPECT_NEAR(eigenvalues[k], expected[k], 1e-8);
+			for (size_t i = 0; i < SIZE; ++i)
+			{
+				std::complex<double> product = 0;
+				for (size_t j = 0; j < SIZE; ++j)
+					product += symmetric[i][j] * eigenvectors[k][j];
+				EXPECT_NEAR(std::abs(product - eigenvalues[k] * eigenvectors[k][i]), 0, 1e-7);
+			}
+		}
+	}
+
+	const Matrix<double> general = test_helper::create_test_matrix(SIZE);
+	std::vector<std::complex<double>> general_expected = general.eigen_decomposition().get_eigenvalues();
+	std::sort(general_expected.begin(), general_expected.end(), by_magnitude);
+	const PartialEigenDecomposition<double> top = general.top_eigenpairs(K);
+	ASSERT_GE(top.get_eigenvalues().size(), K);
+	for (size_t k = 0; k < K; ++k)
+		EXPECT_NEAR(std::abs(top.get_eigenvalues()[k]), std::abs(general_expected[k]), 1e-8);
+}
+
+TEST_F(EigenDecompositionFunctionality, TopEigenpairsShouldOnlyNeedMatrixVectorProducts)
+{
+	// diag(1, 2, ..., SIZE) never stored as a matrix
+	constexpr size_t SIZE = 5000;
+	const auto apply = [](const double* x, double* y)
+	{
+		for (size_t i = 0; i < SIZE; ++i)
+			y[i] = static_cast<double>(i + 1) * x[i];
+	};
+
+	const PartialEigenDecomposition<double> top(apply, SIZE, 3, true);
+	ASSERT_EQ(top.get_eigenvalues().size(), 3u);
+	for (size_t k = 0; k < 3; ++k)
+	{
+		EXPECT_NEAR(top.get_eigenvalues()[k].real(), static_cast<double>(SIZE - k), 1e-6);
+		EXPECT_NEAR(std::abs(top.get_eigenvectors()[k][SIZE - k - 1]), 1, 1e-6);
+	}
+	EXPECT_LT(top.get_number_of_matvec(), SIZE);
+
+	EXPECT_THROW(PartialEigenDecomposition<double>(apply, SIZE, 0, true), std::invalid_argument);
+	EXPECT_THROW(std::ignore = test_helper::create_test_matrix(3).top_eigenpairs(4), std::invalid_argument);
+}
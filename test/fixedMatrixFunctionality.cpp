@@ -0,0 +1,102 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "fixed-matrix.h"
+
+using namespace ::testing;
+
+class FixedMatrixFunctionality : public Test
+{
+};
+
+TEST_F(FixedMatrixFunctionality, OperationsShouldBeEvaluatedAtCompileTime)
+{
+	constexpr FixedMatrix<int, 2, 3> first_matrix({{1, 2, 3}, {4, 5, 6}});
+	constexpr FixedMatrix<int, 3, 2> second_matrix({{7, 8}, {9, 10}, {11, 12}});
+
+	static_assert(first_matrix * second_matrix == FixedMatrix<int, 2, 2>({{58, 64}, {139, 154}}));
+	static_assert(first_matrix.transpose() == FixedMatrix<int, 3, 2>({{1, 4}, {2, 5}, {3, 6}}));
+	static_assert(first_matrix + first_matrix == 2 * first_matrix);
+	static_assert(first_matrix - first_matrix == FixedMatrix<int, 2, 3>());
+	static_assert((second_matrix * first_matrix).tr() == 212);
+	static_assert(FixedMatrix<int, 3, 3>({{2, 0, 1}, {1, 3, 2}, {1, 1, 2}}).determinant() == 6);
+	static_assert(FixedMatrix<double, 2, 2>({{4, 7}, {2, 6}}).inverse() ==
+				  FixedMatrix<double, 2, 2>({{0.6, -0.7}, {-0.2, 0.4}}));
+	static_assert(sizeof(FixedMatrix<float, 4, 4>) == 16 * sizeof(float));
+}
+
+TEST_F(FixedMatrixFunctionality, DeterminantAndInverseShouldMatchTheDynamicMatrix)
+{
+	const FixedMatrix<double, 4, 4> matrix_4({{4, 3, 2, 1}, {0, 1, -1, 2}, {1, 0, 3, 1}, {2, 1, 0, 5}});
+	const FixedMatrix<double, 5, 5> matrix_5(
+			{{2, 1, 0, 0, 1}, {1, 3, 1, 0, 0}, {0, 1, 4, 1, 0}, {0, 0, 1, 5, 1}, {1, 0, 0, 1, 6}});
+
+	EXPECT_NEAR(matrix_4.determinant(), Matrix<double>(matrix_4.view()).determinant(), 1e-9);
+	EXPECT_NEAR(matrix_5.determinant(), Matrix<double>(matrix_5.view()).determinant(), 1e-9);
+
+	const FixedMatrix<double, 4, 4> identity_4 = matrix_4 * matrix_4.inverse();
+	const FixedMatrix<double, 5, 5> identity_5 = matrix_5.inverse() * matrix_5;
+	for (size_t i = 0; i < 4; ++i)
+		for (size_t j = 0; j < 4; ++j)
+			EXPECT_NEAR(identity_4[i][j], i == j ? 1 : 0, 1e-12);
+	for (size_t i = 0; i < 5; ++i)
+		for (size_t j = 0; j < 5; ++j)
+			EXPECT_NEAR(identity_5[i][j], i == j ? 1 : 0, 1e-12);
+	const FixedMatrix<double, 3, 3> singular_matrix({{1, 2, 3}, {2, 4, 6}, {0, 1, 1}});
+	EXPECT_THROW(std::ignore = singular_matrix.inverse(), std::invalid_argument);
+}
+
+TEST_F(FixedMatrixFunctionality, IntegerDeterminantAndInverseShouldBeExactPastTheClosedForms)
+{
+	// {{3, 2}, {2, 3}} next to I3: Gaussian elimination in int truncates 2 / 3 to 0
+	constexpr FixedMatrix<int, 5, 5> block_matrix(
+			{{3, 2, 0, 0, 0}, {2, 3, 0, 0, 0}, {0, 0, 1, 0, 0}, {0, 0, 0, 1, 0}, {0, 0, 0, 0, 1}});
+	static_assert(block_matrix.determinant() == 5);
+	EXPECT_EQ(block_matrix.determinant(), Matrix<int>(block_matrix.view()).determinant());
+
+	const FixedMatrix<long long, 6, 6> matrix_6({{0, 2, 1, 0, 3, 1}, {4, 1, -1, 2, 0, 0}, {2, 5, 3, 1, 1, 2},
+			{1, 0, 2, 7, -3, 1}, {3, 3, 0, 1, 2, -2}, {0, 1, 1, 0, 4, 5}});
+	EXPECT_EQ(matrix_6.determinant(), Matrix<long long>(matrix_6.view()).determinant());
+	const FixedMatrix<int, 5, 5> singular_matrix(
+			{{1, 2, 3, 4, 5}, {2, 4, 6, 8, 10}, {0, 1, 0, 0, 0}, {0, 0, 1, 0, 0}, {0, 0, 0, 1, 1}});
+	EXPECT_EQ(singular_matrix.determinant(), 0);
+	EXPECT_THROW(std::ignore = singular_matrix.inverse(), std::invalid_argument);
+
+	// L * U with unit diagonals, so the inverse is an integer matrix
+	const FixedMatrix<int, 5, 5> unimodular(
+			{{1, 2, 0, -1, 1}, {2, 5, 3, -2, 4}, {-1, 1, 10, 5, 5}, {0, 1, 1, -7, -1}, {1, 2, 2, 8, -1}});
+	const FixedMatrix<int, 5, 5> identity = FixedMatrix<int, 5, 5>::create_i_matrix();
+	ASSERT_EQ(unimodular.determinant(), 1);
+	EXPECT_TRUE(unimodular * unimodular.inverse() == identity);
+	// otherwise every element of A^-1 truncates toward zero, as the closed forms do for smaller sizes
+	const FixedMatrix<int, 5, 5> truncated_inverse(
+			{{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}, {0, 0, 1, 0, 0}, {0, 0, 0, 1, 0}, {0, 0, 0, 0, 1}});
+	EXPECT_TRUE(block_matrix.inverse() == truncated_inverse);
+	static_assert(FixedMatrix<int, 2, 2>({{3, 2}, {2, 3}}).inverse() == FixedMatrix<int, 2, 2>());
+
+	// like Matrix, a determinant that does not fit throws, whether a minor outgrew the wide type or only the result
+	constexpr long long LARGE = 4'000'000'000'000;
+	const FixedMatrix<long long, 5, 5> large_minors({{LARGE, 0, 0, 0, 0}, {0, LARGE, 0, 0, 0}, {0, 0, LARGE, 0, 0},
+			{0, 0, 0, LARGE, 0}, {0, 0, 0, 0, LARGE}});
+	EXPECT_THROW(std::ignore = large_minors.determinant(), std::overflow_error);
+	EXPECT_THROW(std::ignore = Matrix<long long>(large_minors.view()).determinant(), std::overflow_error);
+	EXPECT_THROW(std::ignore = large_minors.inverse(), std::overflow_error);
+	const FixedMatrix<long long, 5, 5> large_result({{3'000'000'000, 0, 0, 0, 0}, {0, 4'000'000'000, 0, 0, 0},
+			{0, 0, 1, 0, 0}, {0, 0, 0, 1, 0}, {0, 0, 0, 0, 1}});
+	EXPECT_THROW(std::ignore = large_result.determinant(), std::overflow_error);
+	EXPECT_THROW(std::ignore = Matrix<long long>(large_result.view()).determinant(), std::overflow_error);
+}
+
+TEST_F(FixedMatrixFunctionality, FixedMatrixShouldInteroperateWithTheDynamicMatrix)
+{
+	const Matrix<int> dynamic_matrix({{1, 2}, {3, 4}});
+	FixedMatrix<int, 2, 2> fixed_matrix(dynamic_matrix);
+	fixed_matrix[1][0] = 5;
+
+	EXPECT_EQ(fixed_matrix.at(1, 0), 5);
+	EXPECT_EQ(Matrix<int>(dynamic_matrix + fixed_matrix.view()), Matrix<int>({{2, 4}, {8, 8}}));
+	EXPECT_EQ(dynamic_matrix * fixed_matrix.view(), Matrix<int>({{11, 10}, {23, 22}}));
+	EXPECT_EQ(static_cast<Matrix<int>>(fixed_matrix), Matrix<int>({{1, 2}, {5, 4}}));
+	EXPECT_EQ(fixed_matrix.get_table(), std::vector<std::vector<int>>({{1, 2}, {5, 4}}));
+	EXPECT_THROW((FixedMatrix<int, 3, 2>(dynamic_matrix)), std::invalid_argument);
+}
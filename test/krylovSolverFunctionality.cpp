@@ -0,0 +1,119 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "krylov-solver.h"
+#include "test-helper.h"
+
+using namespace ::testing;
+
+class KrylovSolverFunctionality : public Test
+{
+protected:
+	static constexpr size_t GRID = 60;
+};
+
+TEST_F(KrylovSolverFunctionality, ConjugateGradientShouldConvergeFasterWithBetterPreconditioners)
+{
+	const SparseMatrix<double> matrix = test_helper::create_convection_diffusion(GRID, 0);
+	const std::vector<double> b = test_helper::create_right_hand_side(GRID * GRID);
+
+	const KrylovSolver<double> plain(matrix, b, KrylovMethod::conjugate_gradient, 1e-10);
+	const KrylovSolver<double> jacobi(matrix, b, KrylovMethod::conjugate_gradient,
+			JacobiPreconditioner<double>(matrix), 1e-10);
+	const KrylovSolver<double> cholesky(matrix, b, KrylovMethod::conjugate_gradient,
+			IncompleteCholeskyPreconditioner<double>(matrix), 1e-10);
+	for (const KrylovSolver<double>* solver : {&plain, &jacobi, &cholesky})
+	{
+		EXPECT_TRUE(solver->is_converged());
+		EXPECT_LT(test_helper::relative_residual(matrix, solver->get_solution(), b), 1e-9);
+		EXPECT_EQ(solver->get_residual_history().size(), solver->get_number_of_iteration() + 1);
+		EXPECT_EQ(solver->get_number_of_matvec(), solver->get_number_of_iteration());
+		EXPECT_DOUBLE_EQ(solver->get_residual_history().front(), 1);
+		EXPECT_LE(solver->get_relative_residual(), 1e-10);
+	}
+	EXPECT_LT(cholesky.get_number_of_iteration(), plain.get_number_of_iteration() * 2 / 3);
+}
+
+TEST_F(KrylovSolverFunctionality, NonSymmetricSolversShouldConvergeWithIncompleteLU)
+{
+	const SparseMatrix<double> matrix = test_helper::create_convection_diffusion(GRID, 0.4);
+	const std::vector<double> b = test_helper::create_right_hand_side(GRID * GRID);
+
+	for (const KrylovMethod method : {KrylovMethod::bicgstab, KrylovMethod::gmres})
+	{
+		const KrylovSolver<double> plain(matrix, b, method, 1e-10);
+		const KrylovSolver<double> ilu(matrix, b, method, IncompleteLUPreconditioner<double>(matrix), 1e-10);
+		EXPECT_TRUE(plain.is_converged());
+		EXPECT_TRUE(ilu.is_converged());
+		EXPECT_LT(test_helper::relative_residual(matrix, plain.get_solution(), b), 1e-9);
+		EXPECT_LT(test_helper::relative_residual(matrix, ilu.get_solution(), b), 1e-9);
+		EXPECT_LT(ilu.get_number_of_iteration(), plain.get_number_of_iteration() / 2);
+	}
+}
+
+TEST_F(KrylovSolverFunctionality, AnyLinearOperatorShouldBeAccepted)
+{
+	// a dense Matrix, and a callback for the same diagonally dominant matrix
+	constexpr size_t SIZE = 80;
+	const Matrix<double> dense = test_helper::create_test_matrix(SIZE, SIZE / 2);
+	const std::vector<double> b = test_helper::create_right_hand_side(SIZE);
+	const std::vector<double> expected = dense.solve(b);
+
+	const KrylovSolver<double> gmres(dense, b, KrylovMethod::gmres, JacobiPreconditioner<double>(dense), 1e-12);
+	const auto callback = [&dense](const double* x, double* y) { dense.multiply(x, y); };
+	const KrylovSolver<double> bicgstab(callback, b, KrylovMethod::bicgstab, 1e-12);
+	for (size_t i = 0; i < SIZE; ++i)
+	{
+		EXPECT_NEAR(gmres.get_solution()[i], expected[i], 1e-10);
+		EXPECT_NEAR(bicgstab.get_solution()[i], expected[i], 1e-10);
+	}
+
+	// out of iterations is reported, not thrown
+	const KrylovSolver<double> short_run(test_helper::create_convection_diffusion(GRID, 0),
+			test_helper::create_right_hand_side(GRID * GRID), KrylovMethod::conjugate_gradient, 1e-12, 3);
+	EXPECT_FALSE(short_run.is_converged());
+	EXPECT_EQ(short_run.get_number_of_iteration(), 3u);
+	EXPECT_GT(short_run.get_relative_residual(), 1e-12);
+
+	const KrylovSolver<double> zero(dense, std::vector<double>(SIZE), KrylovMethod::gmres);
+	EXPECT_TRUE(zero.is_converged());
+	EXPECT_EQ(zero.get_solution(), std::vector<double>(SIZE));
+
+	// b^T * A * b = 0 for a skew-symmetric A: BiCGSTAB breaks down in its first step instead of dividing by zero
+	const KrylovSolver<double> breakdown(Matrix<double>({{0, 1}, {-1, 0}}), std::vector<double>{1, 0},
+			KrylovMethod::bicgstab);
+	EXPECT_FALSE(breakdown.is_converged());
+	EXPECT_EQ(breakdown.get_solution(), std::vector<double>(2));
+}
+
+TEST_F(KrylovSolverFunctionality, IncompleteFactorizationsShouldBeExactWithoutFill)
+{
+	// a tridiagonal matrix has no fill, so ILU(0) and IC(0) are its exact factorizations
+	constexpr size_t SIZE = 50;
+	SparseMatrixBuilder<double> builder(SIZE, SIZE);
+	for (size_t i = 0; i < SIZE; ++i)
+	{
+		builder.add(i, i, 3);
+		if (i > 0)
+		{
+			builder.add(i, i - 1, -1);
+			builder.add(i - 1, i, -1);
+		}
+	}
+	const SparseMatrix<double> matrix = builder.build();
+	const std::vector<double> b = test_helper::create_right_hand_side(SIZE);
+	std::vector<double> x(SIZE);
+
+	const IncompleteLUPreconditioner<double> lu(matrix);
+	lu(b.data(), x.data());
+	EXPECT_LT(test_helper::relative_residual(matrix, x, b), 1e-14);
+	const IncompleteCholeskyPreconditioner<double> cholesky(matrix);
+	cholesky(b.data(), x.data());
+	EXPECT_LT(test_helper::relative_residual(matrix, x, b), 1e-14);
+
+	EXPECT_THROW(IncompleteCholeskyPreconditioner<double>(SparseMatrix<double>(matrix.to_dense() * -1.0)),
+			std::invalid_argument);
+	EXPECT_THROW(JacobiPreconditioner<double>(SparseMatrix<double>(SIZE, SIZE)), std::invalid_argument);
+}
@@ -0,0 +1,94 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "lu-decomposition.h"
+#include "test-helper.h"
+
+using namespace ::testing;
+
+class LUDecompositionFunctionality : public Test
+{
+};
+
+TEST_F(LUDecompositionFunctionality, LowerTimesUpperShouldEqualThePermutedMatrix)
+{
+	constexpr size_t SIZE = 150;
+	const Matrix<double> matrix = test_helper::create_test_matrix(SIZE, 3);
+	const LUDecomposition<double> lu = matrix.lu_decomposition();
+
+	const Matrix<double> product = lu.get_lower() * lu.get_upper();
+	const std::vector<size_t>& permutation = lu.get_permutation();
+	for (size_t i = 0; i < SIZE; ++i)
+		for (size_t j = 0; j < SIZE; ++j)
+			EXPECT_NEAR(product[i][j], matrix[permutation[i]][j], 1e-9);
+	for (size_t i = 0; i < SIZE; ++i)
+		for (size_t j = 0; j < i; ++j)
+			EXPECT_LE(std::abs(lu.get_packed()[i][j]), 1.0);
+}
+
+TEST_F(LUDecompositionFunctionality, DeterminantShouldPivotOnTheLargestElement)
+{
+	const Matrix<double> matrix({{0, 1, 2}, {1e-20, 1, 1}, {3, 1, 0}});
+	const LUDecomposition<double> lu(matrix);
+
+	EXPECT_EQ(lu.get_permutation()[0], 2u);
+	EXPECT_NEAR(lu.determinant(), -3, 1e-12);
+	EXPECT_NEAR(matrix.determinant(), -3, 1e-12);
+	EXPECT_EQ(Matrix<int>({{0, 1}, {1, 0}}).determinant(), -1);
+	EXPECT_EQ(Matrix<int>({{0, 0, 1}, {0, 1, 0}, {1, 0, 0}}).determinant(), -1);
+}
+
+TEST_F(LUDecompositionFunctionality, SolveShouldReuseTheFactorizationForEveryRightHandSide)
+{
+	constexpr size_t SIZE = 90;
+	const Matrix<double> matrix = test_helper::create_test_matrix(SIZE, 3);
+	const LUDecomposition<double> lu(matrix);
+
+	std::vector<std::vector<double>> rhs_table(SIZE, std::vector<double>(3));
+	for (size_t i = 0; i < SIZE; ++i)
+		for (size_t j = 0; j < 3; ++j)
+			rhs_table[i][j] = static_cast<double>(i + j * 5);
+	const Matrix<double> b(rhs_table);
+
+	const Matrix<double> x = lu.solve(b);
+	const Matrix<double> residual = matrix * x - b;
+	for (size_t i = 0; i < SIZE; ++i)
+		for (size_t j = 0; j < 3; ++j)
+			EXPECT_NEAR(residual[i][j], 0, 1e-9);
+
+	const std::vector<double> vector_b = b.column(1).to_vector();
+	const std::vector<double> vector_x = lu.solve(vector_b);
+	const std::vector<double> transpose_x = lu.solve_transpose(vector_b);
+	const Matrix<double> transpose = matrix.transpose();
+	for (size_t i = 0; i < SIZE; ++i)
+	{
+		EXPECT_NEAR(vector_x[i], x[i][1], 1e-9);
+		double row_sum = 0;
+		for (size_t j = 0; j < SIZE; ++j)
+			row_sum += transpose[i][j] * transpose_x[j];
+		EXPECT_NEAR(row_sum, vector_b[i], 1e-9);
+	}
+	EXPECT_THROW(std::ignore = lu.solve(std::vector<double>(SIZE + 1)), std::invalid_argument);
+}
+
+TEST_F(LUDecompositionFunctionality, SingularMatrixShouldBeReported)
+{
+	const LUDecomposition<double> lu(Matrix<double>({{1, 2, 3}, {2, 4, 6}, {1, 0, 1}}));
+
+	EXPECT_TRUE(lu.is_singular());
+	EXPECT_EQ(lu.determinant(), 0);
+	EXPECT_EQ(lu.reciprocal_condition_number(), 0);
+	EXPECT_THROW(std::ignore = lu.inverse(), std::invalid_argument);
+	EXPECT_THROW(LUDecomposition<double>(Matrix<double>(2, 3)), std::invalid_argument);
+}
+
+TEST_F(LUDecompositionFunctionality, ReciprocalConditionNumberShouldTrackTheConditioning)
+{
+	EXPECT_DOUBLE_EQ(LUDecomposition<double>(Matrix<double>::create_i_matrix(4)).reciprocal_condition_number(), 1);
+	// ||A||_1 = 2 + 1e-8, ||A^-1||_1 = (2 + 1e-8) / 1e-8
+	const double reciprocal_condition =
+			LUDecomposition<double>(Matrix<double>({{1, 1}, {1, 1 + 1e-8}})).reciprocal_condition_number();
+	EXPECT_NEAR(reciprocal_condition, 1e-8 / ((2 + 1e-8) * (2 + 1e-8)), 1e-12);
+}
@@ -1,7 +1,12 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "matrix.h"
+#include "test-helper.h"
 
 using namespace ::testing;
 
@@ -43,6 +48,54 @@ TEST_F(MatrixFunctionality, CreatMatrixWithIntializerList)
 	EXPECT_THAT(matrix.get_table(), Eq(table_of_matrix));
 }
 
+TEST_F(MatrixFunctionality, TheDataOfMatrixShouldBeContiguousRowMajorAndCacheLineAligned)
+{
+	const Matrix<double> matrix({{1, 2, 3}, {4, 5, 6}});
+	const double* data = matrix.get_data();
+
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(data) % matrix_helper::CACHE_LINE_SIZE, 0);
+	EXPECT_EQ(matrix.get_stride(), 3);
+	for (size_t i = 0; i < matrix.get_number_of_row(); ++i)
+		for (size_t j = 0; j < matrix.get_number_of_col(); ++j)
+			EXPECT_EQ(data[i * matrix.get_stride() + j], matrix[i][j]);
+}
+
+TEST_F(MatrixFunctionality, TheIndexOperatorShouldReturnRowViewWithoutCopy)
+{
+	const Matrix<int> matrix({{1, 2, 3}, {4, 5, 6}});
+	const RowView<const int> row = matrix[1];
+
+	EXPECT_EQ(row.data(), matrix.get_data() + matrix.get_stride());
+	EXPECT_THAT(row, ElementsAre(4, 5, 6));
+}
+
+TEST_F(MatrixFunctionality, TheColumnFunctionShouldReturnStridedViewOfColumn)
+{
+	const Matrix<int> matrix({{1, 2, 3}, {4, 5, 6}});
+	const ColumnView<const int> column = matrix.column(2);
+
+	EXPECT_EQ(column.size(), 2);
+	EXPECT_EQ(&column[1], &matrix[1][2]);
+	EXPECT_THAT(column.to_vector(), ElementsAre(3, 6));
+	EXPECT_EQ(column.end() - column.begin(), 2);
+	EXPECT_EQ(&*std::prev(column.end()), &matrix[1][2]);
+	EXPECT_THROW(std::ignore = matrix.column(3), std::out_of_range);
+}
+
+TEST_F(MatrixFunctionality, TheSubMatrixFunctionShouldReturnViewThatCanBeUsedInArithmetic)
+{
+	const Matrix<int> matrix({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}});
+	const MatrixView<const int> sub_matrix = matrix.sub_matrix(1, 1, 2, 2);
+	const Matrix<int> other({{1, 1}, {1, 1}});
+
+	EXPECT_EQ(sub_matrix.get_stride(), 3);
+	EXPECT_EQ(Matrix<int>(sub_matrix), Matrix<int>({{5, 6}, {8, 9}}));
+	EXPECT_EQ(other + sub_matrix, Matrix<int>({{6, 7}, {9, 10}}));
+	EXPECT_EQ(other - sub_matrix, Matrix<int>({{-4, -5}, {-7, -8}}));
+	EXPECT_EQ(other * sub_matrix, Matrix<int>({{13, 15}, {13, 15}}));
+	EXPECT_THROW(std::ignore = matrix.sub_matrix(2, 2, 2, 2), std::out_of_range);
+}
+
 TEST_F(MatrixFunctionality, CreatMatrixWithDifferentColumnSizeShouldBeGetTrow)
 {
 	EXPECT_THROW(Matrix<int>({{1, 2, 3}, {1, 4}, {5, 6, 7, 8}}), std::invalid_argument);
@@ -262,15 +315,548 @@ INSTANTIATE_TEST_SUITE_P(MultipleData, MultipleOfTwoMatrix,
 		Values(std::make_tuple(Matrix<int>({{1, 2}, {1, 2}}), Matrix<int>({{1, 2}, {1, 2}}),
 					   Matrix<int>({{3, 6}, {3, 6}})),
 				std::make_tuple(Matrix<int>({{1, 2, 3, 4, 5, 6, 7}}), Matrix<int>({{7}, {6}, {5}, {4}, {3}, {2}, {1}}),
-						Matrix<int>({{84, 0, 0, 0, 0, 0, 0}})),
+						Matrix<int>({{84}})),
 				std::make_tuple(Matrix<int>({{1, 2, 3, 4, 5, 6, 7}, {1, 2, 3, 4, 5, 6, 7}, {1, 2, 3, 4, 5, 6, 7},
 										{1, 2, 3, 4, 5, 6, 7}, {1, 2, 3, 4, 5, 6, 7}}),
 						Matrix<int>({{7, 2, 3, 4, 5, 6, 9, 7}, {6, 2, 3, 4, 5, 6, 9, 7}, {5, 2, 3, 4, 5, 6, 9, 7},
 								{4, 2, 3, 4, 5, 6, 9, 7}, {3, 2, 3, 4, 5, 6, 9, 7}, {2, 2, 3, 4, 5, 6, 9, 7},
 								{1, 2, 3, 4, 5, 6, 9, 7}}),
-						Matrix<int>({{84, 56, 84, 112, 140, 168, 252}, {84, 56, 84, 112, 140, 168, 252},
-								{84, 56, 84, 112, 140, 168, 252}, {84, 56, 84, 112, 140, 168, 252},
-								{84, 56, 84, 112, 140, 168, 252}}))));
+						Matrix<int>({{84, 56, 84, 112, 140, 168, 252, 196}, {84, 56, 84, 112, 140, 168, 252, 196},
+								{84, 56, 84, 112, 140, 168, 252, 196}, {84, 56, 84, 112, 140, 168, 252, 196},
+								{84, 56, 84, 112, 140, 168, 252, 196}}))));
+
+TEST_F(MatrixFunctionality, TheMultipleFunctionShouldMatchNaiveProductForLargeNonSquareMatrices)
+{
+	constexpr size_t ROW_NUMBER = 131;
+	constexpr size_t INNER_NUMBER = 300;
+	constexpr size_t COL_NUMBER = 77;
+	std::vector<std::vector<double>> first_table(ROW_NUMBER, std::vector<double>(INNER_NUMBER));
+	std::vector<std::vector<double>> second_table(INNER_NUMBER, std::vector<double>(COL_NUMBER));
+	for (size_t i = 0; i < ROW_NUMBER; ++i)
+		for (size_t k = 0; k < INNER_NUMBER; ++k)
+			first_table[i][k] = static_cast<double>((i * 7 + k * 3) % 11) - 5;
+	for (size_t k = 0; k < INNER_NUMBER; ++k)
+		for (size_t j = 0; j < COL_NUMBER; ++j)
+			second_table[k][j] = static_cast<double>((k * 5 + j) % 13) - 6;
+	const Matrix<double> first_matrix(first_table);
+	const Matrix<double> second_matrix(second_table);
+
+	const Matrix<double> result = first_matrix.multiple(second_matrix);
+
+	ASSERT_EQ(result.get_number_of_row(), ROW_NUMBER);
+	ASSERT_EQ(result.get_number_of_col(), COL_NUMBER);
+	for (size_t i = 0; i < ROW_NUMBER; ++i)
+	{
+		for (size_t j = 0; j < COL_NUMBER; ++j)
+		{
+			double expected = 0;
+			for (size_t k = 0; k < INNER_NUMBER; ++k)
+				expected += first_table[i][k] * second_table[k][j];
+			EXPECT_DOUBLE_EQ(result[i][j], expected);
+		}
+	}
+}
+
+TEST_F(MatrixFunctionality, EveryInstructionSetShouldGiveTheSameResultAsScalarKernels)
+{
+	constexpr size_t SIZE = 70;
+	std::vector<std::vector<int64_t>> first_table(SIZE, std::vector<int64_t>(SIZE));
+	std::vector<std::vector<int64_t>> second_table(SIZE, std::vector<int64_t>(SIZE));
+	for (size_t i = 0; i < SIZE; ++i)
+	{
+		for (size_t j = 0; j < SIZE; ++j)
+		{
+			first_table[i][j] = static_cast<int64_t>((i * 31 + j * 17) % 23) - 11;
+			second_table[i][j] = static_cast<int64_t>((i * 13 + j * 7) % 19) - 9;
+		}
+	}
+	const Matrix<int64_t> first_matrix(first_table);
+	const Matrix<int64_t> second_matrix(second_table);
+
+	const matrix_kernel::InstructionSet detected = matrix_kernel::detect_instruction_set();
+	matrix_kernel::set_instruction_set(matrix_kernel::InstructionSet::scalar);
+	const Matrix<int64_t> expected_sum = first_matrix + second_matrix;
+	const Matrix<int64_t> expected_submission = first_matrix - second_matrix;
+	const Matrix<int64_t> expected_multiple = first_matrix * second_matrix;
+	const Matrix<int64_t> expected_scale = first_matrix * int64_t(3);
+	const int64_t expected_tr = first_matrix.tr();
+
+	for (auto instruction_set : {matrix_kernel::InstructionSet::sse4_2, matrix_kernel::InstructionSet::avx2,
+				 matrix_kernel::InstructionSet::avx512})
+	{
+		matrix_kernel::set_instruction_set(instruction_set);
+		EXPECT_EQ(first_matrix + second_matrix, expected_sum);
+		EXPECT_EQ(first_matrix - second_matrix, expected_submission);
+		EXPECT_EQ(first_matrix * second_matrix, expected_multiple);
+		EXPECT_EQ(first_matrix * int64_t(3), expected_scale);
+		EXPECT_EQ(first_matrix.tr(), expected_tr);
+	}
+	matrix_kernel::set_instruction_set(detected);
+	EXPECT_EQ(matrix_kernel::get_instruction_set(), detected);
+}
+
+TEST_F(MatrixFunctionality, TheThreadPoolShouldVisitEveryIndexOnceAndRethrowTaskExceptions)
+{
+	constexpr size_t SIZE = 10007;
+	ThreadPool pool(4);
+	std::vector<std::atomic<int>> visit(SIZE);
+
+	pool.parallel_for(0, SIZE, 16, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			++visit[i];
+	});
+
+	for (size_t i = 0; i < SIZE; ++i)
+		EXPECT_EQ(visit[i], 1);
+	EXPECT_THROW(pool.parallel_for(0, SIZE, 16, [](size_t begin, size_t)
+	{
+		if (begin > 0)
+			throw std::runtime_error("task failed");
+	}), std::runtime_error);
+}
+
+TEST_F(MatrixFunctionality, EveryNumberOfThreadShouldGiveTheSameResult)
+{
+	constexpr size_t SIZE = 300;
+	std::vector<std::vector<double>> table(SIZE, std::vector<double>(SIZE));
+	for (size_t i = 0; i < SIZE; ++i)
+		for (size_t j = 0; j < SIZE; ++j)
+			table[i][j] = static_cast<double>((i * 7 + j * 3) % 11) - 5;
+	const Matrix<double> matrix(table);
+
+	ThreadPool& pool = ThreadPool::get_instance();
+	const size_t default_number_of_thread = pool.get_number_of_thread();
+	pool.set_number_of_thread(1);
+	const Matrix<double> expected_sum = matrix + matrix;
+	const Matrix<double> expected_multiple = matrix * matrix;
+	const Matrix<double> expected_transpose = matrix.transpose();
+
+	for (size_t number_of_thread : {2, 3, 8})
+	{
+		pool.set_number_of_thread(number_of_thread);
+		EXPECT_EQ(matrix + matrix, expected_sum);
+		EXPECT_EQ(matrix * matrix, expected_multiple);
+		EXPECT_EQ(matrix.transpose(), expected_transpose);
+	}
+	pool.set_number_of_thread(default_number_of_thread);
+}
+
+TEST_F(MatrixFunctionality, ArithmeticOperatorsShouldBuildLazyExpressionsEvaluatedOnAssignment)
+{
+	const Matrix<int> first_matrix({{1, 2}, {3, 4}});
+	const Matrix<int> second_matrix({{5, 6}, {7, 8}});
+
+	const auto expression = 2 * (first_matrix + second_matrix) - -first_matrix;
+
+	EXPECT_FALSE((std::is_same_v<std::remove_cvref_t<decltype(expression)>, Matrix<int>>));
+	EXPECT_EQ(expression, Matrix<int>({{13, 18}, {23, 28}}));
+	const Matrix<int> result = expression * second_matrix;
+	EXPECT_EQ(result, Matrix<int>({{191, 222}, {311, 362}}));
+	EXPECT_EQ(first_matrix * (second_matrix - first_matrix), Matrix<int>({{12, 12}, {28, 28}}));
+	EXPECT_THROW(std::ignore = first_matrix + Matrix<int>(2, 3), std::invalid_argument);
+	EXPECT_THROW(std::ignore = first_matrix * Matrix<int>(3, 2), std::invalid_argument);
+}
+
+TEST_F(MatrixFunctionality, AssigningAnExpressionThatReadsTheDestinationShouldUseTheOldValues)
+{
+	const Matrix<int> first_matrix({{1, 2}, {3, 4}});
+	Matrix<int> matrix({{5, 6}, {7, 8}});
+
+	matrix = matrix - 2 * first_matrix;
+	EXPECT_EQ(matrix, Matrix<int>({{3, 2}, {1, 0}}));
+
+	matrix = first_matrix * matrix;
+	EXPECT_EQ(matrix, Matrix<int>({{5, 2}, {13, 6}}));
+
+	matrix = matrix.sub_matrix(0, 0, 1, 2) + Matrix<int>({{1, 1}});
+	EXPECT_EQ(matrix, Matrix<int>({{6, 3}}));
+}
+
+TEST_F(MatrixFunctionality, CompoundAssignmentAndTemporaryOperandsShouldReuseTheLeftBuffer)
+{
+	const Matrix<int> first_matrix({{1, 2}, {3, 4}});
+	Matrix<int> matrix({{5, 6}, {7, 8}});
+	const int* data = matrix.get_data();
+
+	matrix += first_matrix;
+	matrix -= first_matrix.sub_matrix(0, 0, 2, 2);
+	matrix += 2 * first_matrix;
+	matrix *= 3;
+	EXPECT_EQ(matrix, Matrix<int>({{21, 30}, {39, 48}}));
+	EXPECT_EQ(matrix.get_data(), data);
+	EXPECT_THROW(matrix += Matrix<int>(2, 3), std::invalid_argument);
+
+	Matrix<int> result = -(std::move(matrix) + first_matrix - first_matrix) * 2;
+	EXPECT_EQ(result, Matrix<int>({{-42, -60}, {-78, -96}}));
+	EXPECT_EQ(result.get_data(), data);
+}
+
+TEST_F(MatrixFunctionality, TheSolveFunctionShouldSubstituteTriangularMatricesAcrossBlocks)
+{
+	constexpr size_t SIZE = 150;
+	constexpr size_t NUMBER_OF_RHS = 4;
+	std::vector<std::vector<double>> lower_table(SIZE, std::vector<double>(SIZE));
+	std::vector<std::vector<double>> rhs_table(SIZE, std::vector<double>(NUMBER_OF_RHS));
+	for (size_t i = 0; i < SIZE; ++i)
+	{
+		for (size_t j = 0; j < i; ++j)
+			lower_table[i][j] = static_cast<double>((i * 7 + j * 3) % 11) / 11 - 0.5;
+		lower_table[i][i] = 2 + static_cast<double>(i % 5);
+		for (size_t k = 0; k < NUMBER_OF_RHS; ++k)
+			rhs_table[i][k] = static_cast<double>(i) - static_cast<double>(k * 10);
+	}
+	const Matrix<double> lower(lower_table);
+	const Matrix<double> b(rhs_table);
+	const Matrix<double> upper = lower.transpose();
+	EXPECT_TRUE(lower.is_lower_triangular());
+	EXPECT_TRUE(upper.is_upper_triangular());
+	EXPECT_FALSE(lower.is_upper_triangular());
+
+	const Matrix<double> lower_residual = lower * lower.solve(b) - b;
+	const Matrix<double> upper_residual = upper * upper.solve(b) - b;
+	for (size_t i = 0; i < SIZE; ++i)
+	{
+		for (size_t k = 0; k < NUMBER_OF_RHS; ++k)
+		{
+			EXPECT_NEAR(lower_residual[i][k], 0, 1e-9);
+			EXPECT_NEAR(upper_residual[i][k], 0, 1e-9);
+		}
+	}
+
+	const Matrix<double> singular_lower({{1, 0}, {2, 0}});
+	const std::vector<double> rhs = {1, 2};
+	EXPECT_THROW(std::ignore = singular_lower.solve(rhs), std::invalid_argument);
+}
+
+TEST_F(MatrixFunctionality, TheSolveFunctionShouldMatchInverseTimesRightHandSide)
+{
+	const Matrix<double> general({{0, 2, 1}, {4, 1, -1}, {2, 5, 3}});
+	const Matrix<double> symmetric_positive_definite({{4, 2, -2}, {2, 10, 4}, {-2, 4, 9}});
+	const Matrix<double> symmetric_indefinite({{1, 2, 0}, {2, 1, 3}, {0, 3, 1}});
+	const Matrix<double> b({{1, 0}, {2, -1}, {3, 5}});
+	EXPECT_TRUE(symmetric_positive_definite.is_symmetric());
+	EXPECT_FALSE(general.is_symmetric());
+	EXPECT_TRUE(symmetric_positive_definite.cholesky_decomposition().is_positive_definite());
+	EXPECT_FALSE(symmetric_indefinite.cholesky_decomposition().is_positive_definite());
+
+	for (const Matrix<double>* matrix : {&general, &symmetric_positive_definite, &symmetric_indefinite})
+	{
+		const Matrix<double> expected = matrix->inverse() * b;
+		const Matrix<double> x = matrix->solve(b);
+		const std::vector<double> vector_x = matrix->solve(b.column(1).to_vector());
+		for (size_t i = 0; i < 3; ++i)
+		{
+			EXPECT_NEAR(x[i][0], expected[i][0], 1e-12);
+			EXPECT_NEAR(x[i][1], expected[i][1], 1e-12);
+			EXPECT_NEAR(vector_x[i], expected[i][1], 1e-12);
+		}
+	}
+
+	const Matrix<double> not_square(2, 3);
+	EXPECT_THROW(std::ignore = not_square.solve(b), std::invalid_argument);
+	EXPECT_THROW(std::ignore = general.solve(Matrix<double>(2, 1)), std::invalid_argument);
+}
+
+TEST_F(MatrixFunctionality, TheStructureShouldPickTheFastPathAndFollowWrites)
+{
+	const Matrix<double> diagonal({{2, 0, 0}, {0, -4, 0}, {0, 0, 0.5}});
+	const Matrix<double> permutation({{0, 1, 0}, {0, 0, 1}, {1, 0, 0}});
+	const Matrix<double> lower({{2, 0, 0}, {1, 3, 0}, {-1, 2, 4}});
+	const Matrix<double> symmetric_positive_definite({{4, 2, -2}, {2, 10, 4}, {-2, 4, 9}});
+	const Matrix<double> b({{1, 0}, {2, -1}, {3, 5}});
+
+	EXPECT_TRUE(diagonal.is_diagonal());
+	EXPECT_TRUE(diagonal.is_symmetric());
+	EXPECT_FALSE(diagonal.is_permutation());
+	EXPECT_TRUE(permutation.is_permutation());
+	EXPECT_FALSE(permutation.is_symmetric());
+	EXPECT_TRUE(lower.structure().lower_triangular);
+	EXPECT_FALSE(lower.structure().diagonal);
+	EXPECT_TRUE(symmetric_positive_definite.structure().may_be_positive_definite);
+	EXPECT_FALSE(Matrix<double>({{1, 0}, {1, 0}}).is_permutation());
+	EXPECT_FALSE(Matrix<double>({{-1, 0}, {0, 1}}).structure().may_be_positive_definite);
+
+	EXPECT_DOUBLE_EQ(diagonal.determinant(), -4);
+	EXPECT_DOUBLE_EQ(permutation.determinant(), 1);
+	EXPECT_DOUBLE_EQ(Matrix<double>({{0, 1}, {1, 0}}).determinant(), -1);
+	EXPECT_DOUBLE_EQ(lower.determinant(), 24);
+	EXPECT_EQ(Matrix<int>({{0, 0, 1}, {1, 0, 0}, {0, 1, 0}}).determinant(), 1);
+	EXPECT_EQ(Matrix<int>({{0, 1}, {1, 0}}).determinant(), -1);
+	EXPECT_EQ(Matrix<int>({{3, 0}, {7, -5}}).determinant(), -15);
+	EXPECT_THROW(std::ignore = Matrix<int>({{1 << 20, 0}, {0, 1 << 20}}).determinant(), std::overflow_error);
+
+	EXPECT_EQ(permutation.inverse(), permutation.transpose());
+	for (const Matrix<double>* matrix : {&diagonal, &permutation, &lower, &symmetric_positive_definite})
+	{
+		const Matrix<double> identity = *matrix * matrix->inverse();
+		const Matrix<double> residual = *matrix * matrix->solve(b) - b;
+		for (size_t i = 0; i < 3; ++i)
+		{
+			for (size_t j = 0; j < 3; ++j)
+				EXPECT_NEAR(identity[i][j], i == j ? 1 : 0, 1e-12);
+			EXPECT_NEAR(residual[i][0], 0, 1e-12);
+			EXPECT_NEAR(residual[i][1], 0, 1e-12);
+		}
+	}
+	EXPECT_THROW(std::ignore = Matrix<double>({{1, 0}, {0, 0}}).solve(std::vector<double>{1, 1}),
+			std::invalid_argument);
+
+	// a copy finds its own structure, and every write drops it
+	Matrix<double> changing = diagonal;
+	EXPECT_TRUE(changing.is_diagonal());
+	changing += lower;
+	EXPECT_FALSE(changing.is_diagonal());
+	EXPECT_TRUE(changing.is_lower_triangular());
+	EXPECT_DOUBLE_EQ(changing.determinant(), 4 * -1 * 4.5);
+	changing = permutation * 1.0;
+	EXPECT_TRUE(changing.is_permutation());
+	changing *= 2.0;
+	EXPECT_FALSE(changing.is_permutation());
+	EXPECT_DOUBLE_EQ(changing.determinant(), 8);
+	changing -= changing;
+	EXPECT_TRUE(changing.is_diagonal());
+	EXPECT_DOUBLE_EQ(changing.determinant(), 0);
+	// a decomposition eliminates in its own copy, which must not keep the structure of the original
+	EXPECT_FALSE(symmetric_positive_definite.lu_decomposition().get_packed().is_symmetric());
+}
+
+TEST_F(MatrixFunctionality, CachedResultsShouldFollowEveryWriteAndBeSharedByConcurrentReaders)
+{
+	Matrix<double> matrix({{0, 2, 1}, {4, 1, -1}, {2, 5, 3}});
+	const Matrix<double> reference = matrix;
+	EXPECT_FALSE(matrix.is_cache_enabled());
+	matrix.set_cache_enabled(true);
+	EXPECT_TRUE(matrix.is_cache_enabled());
+
+	const double det = reference.determinant();
+	const Matrix<double> inverse = reference.inverse();
+	const Polynomial<double> characteristic_polynomial = reference.characteristic_polynomial();
+	std::vector<std::thread> readers;
+	std::atomic<size_t> number_of_mismatch = 0;
+	for (size_t t = 0; t < 4; ++t)
+	{
+		readers.emplace_back([&]
+		{
+			for (size_t i = 0; i < 50; ++i)
+			{
+				const Matrix<double>& shared = matrix;
+				if (shared.determinant() != det or shared.inverse() != inverse or shared.tr() != 4 or
+						shared.characteristic_polynomial() != characteristic_polynomial or
+						shared.lu_decomposition().get_packed() != reference.lu_decomposition().get_packed())
+					++number_of_mismatch;
+			}
+		});
+	}
+	for (std::thread& reader : readers)
+		reader.join();
+	EXPECT_EQ(number_of_mismatch, 0u);
+
+	// every write drops what was cached
+	const Matrix<double> shifted = reference + Matrix<double>::create_i_matrix(3);
+	matrix += Matrix<double>::create_i_matrix(3);
+	EXPECT_DOUBLE_EQ(matrix.tr(), 7);
+	EXPECT_DOUBLE_EQ(matrix.determinant(), shifted.determinant());
+	matrix *= 2.0;
+	EXPECT_DOUBLE_EQ(matrix.tr(), 14);
+	matrix = reference * 1.0;
+	EXPECT_DOUBLE_EQ(matrix.determinant(), det);
+	matrix -= reference;
+	EXPECT_DOUBLE_EQ(matrix.determinant(), 0);
+	EXPECT_THROW(std::ignore = matrix.inverse(), std::invalid_argument);
+
+	// the setting belongs to the object
+	matrix = reference;
+	EXPECT_TRUE(matrix.is_cache_enabled());
+	EXPECT_EQ(matrix.inverse(), inverse);
+	const Matrix<double> copy = matrix;
+	EXPECT_FALSE(copy.is_cache_enabled());
+	matrix.set_cache_enabled(false);
+	EXPECT_FALSE(matrix.is_cache_enabled());
+	EXPECT_DOUBLE_EQ(matrix.determinant(), det);
+
+	Matrix<int> integer({{2, 1}, {1, 3}});
+	integer.set_cache_enabled(true);
+	EXPECT_EQ(integer.determinant(), 5);
+	integer *= 2;
+	EXPECT_EQ(integer.determinant(), 20);
+}
+
+TEST_F(MatrixFunctionality, TheCharacteristicPolynomialShouldBeDeterminantOfMatrixMinusX)
+{
+	// det(A - x * I) = -x^3 + 9 * x^2 + 6 * x
+	const Polynomial<double> odd = Matrix<double>({{1, 2, 3}, {2, 3, 4}, {3, 4, 5}}).characteristic_polynomial();
+	const std::vector<double> odd_coefficients = {0, 6, 9, -1};
+	for (size_t i = 0; i < odd_coefficients.size(); ++i)
+		EXPECT_NEAR(odd[i], odd_coefficients[i], 1e-12);
+
+	// det(A - x * I) = x^2 - 5 * x - 2, exact for integers
+	const Polynomial<int> even = Matrix<int>({{1, 2}, {3, 4}}).characteristic_polynomial();
+	EXPECT_EQ(even, Polynomial<int>({-2, -5, 1}));
+	const Polynomial<int> integer_odd = Matrix<int>({{1, 2, 3}, {2, 3, 4}, {3, 4, 5}}).characteristic_polynomial();
+	EXPECT_EQ(integer_odd, Polynomial<int>({0, 6, 9, -1}));
+}
+
+TEST_F(MatrixFunctionality, TheCharacteristicPolynomialOfALargeMatrixShouldVanishAtItsEigenvalues)
+{
+	// upper triangular with diagonal 1..n plus a similarity that fills the matrix, so the roots are 1..n
+	constexpr size_t SIZE = 12;
+	const Matrix<double> matrix = test_helper::create_similar_to_triangular(SIZE, 0.5);
+
+	const Polynomial<double> characteristic = matrix.characteristic_polynomial();
+	for (size_t root = 1; root <= SIZE; ++root)
+	{
+		// relative to the size of the terms that cancel
+		double magnitude = 0;
+		double value = 0;
+		for (size_t i = SIZE + 1; i-- > 0;)
+		{
+			value = value * static_cast<double>(root) + characteristic[i];
+			magnitude = magnitude * static_cast<double>(root) + std::abs(characteristic[i]);
+		}
+		EXPECT_NEAR(value / magnitude, 0, 1e-10);
+	}
+}
+
+TEST_F(MatrixFunctionality, TheIntegerDeterminantShouldBeExactOrThrowOnOverflow)
+{
+	// Vandermonde on 1, ..., 9: det = 1! * 2! * ... * 8!, far beyond what double rounding keeps exact
+	constexpr size_t SIZE = 9;
+	std::vector<std::vector<long long>> vandermonde(SIZE, std::vector<long long>(SIZE, 1));
+	for (size_t i = 0; i < SIZE; ++i)
+		for (size_t j = 1; j < SIZE; ++j)
+			vandermonde[i][j] = vandermonde[i][j - 1] * static_cast<long long>(i + 1);
+	long long expected = 1;
+	long long factorial = 1;
+	for (long long k = 1; k < static_cast<long long>(SIZE); ++k)
+	{
+		factorial *= k;
+		expected *= factorial;
+	}
+	EXPECT_EQ(Matrix<long long>(vandermonde).determinant(), expected);
+
+	// the minors overflow int on the way, the determinant itself does not
+	EXPECT_EQ(Matrix<int>({{50000, 49999}, {50001, 50000}}).determinant(), 1);
+	EXPECT_THROW(std::ignore = Matrix<int>({{100000, 0}, {0, 100000}}).determinant(), std::overflow_error);
+}
+
+TEST_F(MatrixFunctionality, ThePowerFunctionShouldMatchRepeatedMultiplicationForBothMethods)
+{
+	// [[1, 1], [1, 0]]^n = [[F(n + 1), F(n)], [F(n), F(n - 1)]], F(91) still fits in long long
+	const Matrix<long long> fibonacci({{1, 1}, {1, 0}});
+	const Matrix<long long> expected({{4660046610375530309LL, 2880067194370816120LL},
+			{2880067194370816120LL, 1779979416004714189LL}});
+	EXPECT_EQ(fibonacci.power(90), expected);
+	EXPECT_EQ(fibonacci.power(90, MatrixPowerMethod::characteristic_polynomial), expected);
+	EXPECT_EQ(fibonacci.power(0), Matrix<long long>::create_i_matrix(2));
+	EXPECT_EQ(fibonacci.power(0, MatrixPowerMethod::characteristic_polynomial), Matrix<long long>::create_i_matrix(2));
+
+	std::vector<std::vector<double>> table(5, std::vector<double>(5));
+	for (size_t i = 0; i < 5; ++i)
+		for (size_t j = 0; j < 5; ++j)
+			table[i][j] = static_cast<double>((3 * i + 7 * j) % 11) / 11 - 0.4;
+	const Matrix<double> matrix(table);
+	Matrix<double> product = Matrix<double>::create_i_matrix(5);
+	for (uint64_t exponent = 1; exponent <= 13; ++exponent)
+	{
+		product = product * matrix;
+		const Matrix<double> squared = matrix.power(exponent);
+		const Matrix<double> reduced = matrix.power(exponent, MatrixPowerMethod::characteristic_polynomial);
+		for (size_t i = 0; i < 5; ++i)
+			for (size_t j = 0; j < 5; ++j)
+			{
+				EXPECT_NEAR(squared[i][j], std::as_const(product)[i][j], 1e-9);
+				EXPECT_NEAR(reduced[i][j], std::as_const(product)[i][j], 1e-9);
+			}
+	}
+
+	// a Markov chain after many steps: every row is the stationary distribution (0.25, 0.5, 0.25)
+	const Matrix<double> chain({{0.5, 0.5, 0}, {0.25, 0.5, 0.25}, {0, 0.5, 0.5}});
+	for (const MatrixPowerMethod method :
+			{MatrixPowerMethod::repeated_squaring, MatrixPowerMethod::characteristic_polynomial})
+	{
+		const Matrix<double> limit = chain.power(1'000'000'000'000ULL, method);
+		for (size_t i = 0; i < 3; ++i)
+		{
+			EXPECT_NEAR(limit[i][0], 0.25, 1e-9);
+			EXPECT_NEAR(limit[i][1], 0.5, 1e-9);
+			EXPECT_NEAR(limit[i][2], 0.25, 1e-9);
+		}
+	}
+
+	EXPECT_THROW(std::ignore = Matrix<double>(2, 3).power(2), std::invalid_argument);
+}
+
+TEST_F(MatrixFunctionality, TheMatrixExponentialShouldMatchClosedFormsAndItsAction)
+{
+	// e^[[0, -a], [a, 0]] is the rotation by a; 1e-3 takes a low Pade degree, the others scaling and squaring
+	for (const double angle : {1e-3, 0.5, 10.0, 300.0})
+	{
+		const Matrix<double> rotation = Matrix<double>({{0, -angle}, {angle, 0}}).expm();
+		EXPECT_NEAR(rotation[0][0], std::cos(angle), 1e-12);
+		EXPECT_NEAR(rotation[0][1], -std::sin(angle), 1e-12);
+		EXPECT_NEAR(rotation[1][0], std::sin(angle), 1e-12);
+		EXPECT_NEAR(rotation[1][1], std::cos(angle), 1e-12);
+	}
+
+	// nilpotent: the series stops after the linear term
+	const Matrix<double> shear = Matrix<double>({{0, 3}, {0, 0}}).expm();
+	EXPECT_NEAR(shear[0][0], 1, 1e-14);
+	EXPECT_NEAR(shear[0][1], 3, 1e-14);
+	EXPECT_NEAR(shear[1][0], 0, 1e-14);
+	EXPECT_NEAR(shear[1][1], 1, 1e-14);
+
+	// e^(t * A) * v against the dense exponential, for a stiff decay and a growth with a large shift
+	constexpr size_t SIZE = 40;
+	std::vector<std::vector<double>> table(SIZE, std::vector<double>(SIZE));
+	std::vector<double> v(SIZE);
+	for (size_t i = 0; i < SIZE; ++i)
+	{
+		for (size_t j = 0; j < SIZE; ++j)
+			table[i][j] = static_cast<double>((5 * i + 3 * j) % 13) / 13 - 0.5;
+		table[i][i] -= static_cast<double>(i) / 4;
+		v[i] = static_cast<double>(i % 7) - 3;
+	}
+	const Matrix<double> matrix(table);
+	for (const double t : {0.1, -2.0, 3.0})
+	{
+		const std::vector<double> action = matrix.expm_multiply(v, t);
+		const Matrix<double> exponential = (matrix * t).evaluate().expm();
+		double scale = 0;
+		std::vector<double> expected(SIZE);
+		for (size_t i = 0; i < SIZE; ++i)
+		{
+			for (size_t j = 0; j < SIZE; ++j)
+				expected[i] += exponential[i][j] * v[j];
+			scale = std::max(scale, std::abs(expected[i]));
+		}
+		for (size_t i = 0; i < SIZE; ++i)
+			EXPECT_NEAR(action[i] / scale, expected[i] / scale, 1e-11);
+	}
+
+	// float takes its own degrees and thresholds, and is accurate to float rounding
+	for (const float angle : {1e-2F, 1.0F, 3.0F, 300.0F})
+	{
+		const Matrix<float> rotation = Matrix<float>({{0, -angle}, {angle, 0}}).expm();
+		const float tolerance = 1e-5F * std::max(1.0F, angle);
+		EXPECT_NEAR(rotation[0][0], std::cos(angle), tolerance);
+		EXPECT_NEAR(rotation[1][0], std::sin(angle), tolerance);
+	}
+	std::vector<std::vector<float>> single_table(SIZE, std::vector<float>(SIZE));
+	for (size_t i = 0; i < SIZE; ++i)
+		for (size_t j = 0; j < SIZE; ++j)
+			single_table[i][j] = static_cast<float>(table[i][j]);
+	const std::vector<float> single_v(v.begin(), v.end());
+	const std::vector<float> single_action = Matrix<float>(single_table).expm_multiply(single_v, 3.0F);
+	const std::vector<double> action = matrix.expm_multiply(v, 3.0);
+	const double scale = std::abs(*std::max_element(action.begin(), action.end(),
+			[](double first, double second) { return std::abs(first) < std::abs(second); }));
+	for (size_t i = 0; i < SIZE; ++i)
+		EXPECT_NEAR(single_action[i] / scale, action[i] / scale, 1e-4);
+
+	EXPECT_THROW(std::ignore = Matrix<double>(2, 3).expm(), std::invalid_argument);
+	EXPECT_THROW(std::ignore = matrix.expm_multiply(std::vector<double>(SIZE + 1)), std::invalid_argument);
+}
 
 class OppositeOfMatrix : public ::testing::TestWithParam<std::tuple<Matrix<int>, Matrix<int>>>
 {
@@ -301,8 +887,9 @@ TEST_P(DeterminantOfMatrix, TheDeterminantShouldReturnSecondParamWhenDeterminant
 INSTANTIATE_TEST_SUITE_P(DeterminantData, DeterminantOfMatrix,
 		Values(std::make_tuple(Matrix<int>({{1, 2}, {0, 2}}), 2),
 				std::make_tuple(Matrix<int>({{1, 2, 3}, {0, 2, 3}, {1, 2, 0}}), -6),
-				std::make_tuple(Matrix<int>({{1, 2, 3, 4}, {0, 2, 3, 5}, {1, 2, 0, 5}, {1, 2, 8, 5}}), -12),
-				std::make_tuple(Matrix<int>({{1}}), 1)));
+				std::make_tuple(Matrix<int>({{1, 2, 3, 4}, {0, 2, 3, 5}, {1, 2, 0, 5}, {1, 2, 8, 5}}), -16),
+				std::make_tuple(Matrix<int>({{1}}), 1), std::make_tuple(Matrix<int>({{3, 2}, {2, 3}}), 5),
+				std::make_tuple(Matrix<int>({{0, 4, 6}, {3, 1, 7}, {5, 2, 9}}), 38)));
 
 class InverseOfMatrix : public ::testing::TestWithParam<std::tuple<Matrix<double>, Matrix<double>>>
 {
@@ -356,8 +943,10 @@ TEST_P(EigenvaluesOfMatrix, TheEigenvaluesOperatorShouldReturnSecondParamWhenEig
 {
 	const Matrix<double> MATRIX = std::get<0>(GetParam());
 	const std::vector<double> EIGENVALUES = std::get<1>(GetParam());
-	const std::vector<double> eigenvalues = MATRIX.eigenvalues();
+	std::vector<double> eigenvalues = MATRIX.eigenvalues();
+	std::sort(eigenvalues.begin(), eigenvalues.end());
 
+	ASSERT_EQ(eigenvalues.size(), EIGENVALUES.size());
 	for (size_t j = 0; j < MATRIX.get_number_of_col(); ++j)
 		EXPECT_NEAR(eigenvalues[j], EIGENVALUES[j], 1e-3);
 }
@@ -369,4 +958,4 @@ INSTANTIATE_TEST_SUITE_P(EigenvaluesData, EigenvaluesOfMatrix,
 										{2, 3, 4},
 										{3, 4, 5},
 								}),
-						std::vector<double>({0, -0.725, -8.274}))));
+						std::vector<double>({-0.623, 0, 9.623}))));
@@ -0,0 +1,91 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "matrix.h"
+#include "mod-int.h"
+
+using namespace ::testing;
+
+class ModIntFunctionality : public Test
+{
+protected:
+	static constexpr uint64_t SMALL_PRIME = 1'000'000'007;
+	// 2^61 - 1, products need the 64-bit Montgomery path
+	static constexpr uint64_t LARGE_PRIME = (uint64_t(1) << 61) - 1;
+
+	// U * L for unit triangular U and L: det = 1, but the minors Bareiss walks through reach hundreds of bits
+	static Matrix<long long> create_unimodular_matrix(size_t size)
+	{
+		std::vector<std::vector<long long>> lower(size, std::vector<long long>(size));
+		std::vector<std::vector<long long>> upper(size, std::vector<long long>(size));
+		for (size_t i = 0; i < size; ++i)
+		{
+			lower[i][i] = upper[i][i] = 1;
+			for (size_t j = 0; j < i; ++j)
+			{
+				lower[i][j] = static_cast<long long>((i * 7919 + j * 104729) % 1999) - 999;
+				upper[j][i] = static_cast<long long>((i * 31 + j * 977) % 1999) - 999;
+			}
+		}
+		return Matrix<long long>(upper) * Matrix<long long>(lower);
+	}
+};
+
+TEST_F(ModIntFunctionality, ArithmeticShouldWrapAroundThePrime)
+{
+	static_assert(Elementable<ModInt<SMALL_PRIME>>);
+	static_assert(Elementable<ModInt<LARGE_PRIME>>);
+	static_assert(ModInt<7>(3) * ModInt<7>(5) == ModInt<7>(1));
+	static_assert(ModInt<7>(-1).value() == 6);
+
+	using Small = ModInt<SMALL_PRIME>;
+	EXPECT_EQ((Small(SMALL_PRIME - 1) + Small(5)).value(), 4u);
+	EXPECT_EQ((Small(3) - Small(5)).value(), SMALL_PRIME - 2);
+	EXPECT_EQ((Small(123456789) * Small(987654321)).value(), 123456789ull * 987654321ull % SMALL_PRIME);
+	EXPECT_EQ(Small(42) / Small(42), Small(1));
+	EXPECT_EQ(Small(2).power(SMALL_PRIME - 1), Small(1));
+	EXPECT_EQ(to_string(Small(-2)), std::to_string(SMALL_PRIME - 2));
+
+	using Large = ModInt<LARGE_PRIME>;
+	EXPECT_EQ(Large(-1) * Large(-1), Large(1));
+	EXPECT_EQ((Large(uint64_t(1) << 60) * Large(4)).value(), 2u);
+	EXPECT_EQ(Large(987654321987654321LL) * Large(987654321987654321LL).inverse(), Large(1));
+	EXPECT_EQ(-Large(5), Large(5) * -1);
+	EXPECT_THROW(std::ignore = Large(0).inverse(), std::invalid_argument);
+}
+
+TEST_F(ModIntFunctionality, MatrixOfModIntShouldReduceItsDeterminant)
+{
+	using Small = ModInt<SMALL_PRIME>;
+	const Matrix<Small> matrix({{Small(2), Small(-1), Small(0)}, {Small(-1), Small(2), Small(-1)},
+			{Small(0), Small(-1), Small(2)}});
+	EXPECT_EQ(matrix.determinant(), Small(4));
+	EXPECT_EQ(matrix * matrix.inverse(), Matrix<Small>::create_i_matrix(3));
+
+	const Matrix<long long> integers = create_unimodular_matrix(8);
+	std::vector<std::vector<Small>> table(8, std::vector<Small>(8));
+	for (size_t i = 0; i < 8; ++i)
+		for (size_t j = 0; j < 8; ++j)
+			table[i][j] = Small(integers[i][j]);
+	EXPECT_EQ(Matrix<Small>(table).determinant(), Small(1));
+}
+
+TEST_F(ModIntFunctionality, ModularDeterminantShouldBeExact)
+{
+	EXPECT_EQ(modular_arithmetic::largest_primes<uint32_t>(2), std::vector<uint32_t>({2147483647, 2147483629}));
+	EXPECT_TRUE(modular_arithmetic::is_prime(LARGE_PRIME));
+	EXPECT_FALSE(modular_arithmetic::is_prime(uint64_t(3215031751)));
+
+	const Matrix<long long> unimodular = create_unimodular_matrix(16);
+	EXPECT_EQ(unimodular.modular_determinant(), 1);
+	// Bareiss overflows on the way there and hands over to the primes
+	EXPECT_EQ(unimodular.determinant(), 1);
+
+	const Matrix<int> small({{3, 2, 0}, {2, 3, -1}, {7, 0, 5}});
+	EXPECT_EQ(small.modular_determinant(), small.determinant());
+	EXPECT_EQ(Matrix<int>(-small).modular_determinant(), -small.determinant());
+	EXPECT_EQ(Matrix<int>({{1, 2}, {2, 4}}).modular_determinant(), 0);
+	EXPECT_THROW(std::ignore = Matrix<int>({{100000, 0}, {0, 100000}}).modular_determinant(), std::overflow_error);
+}
@@ -0,0 +1,183 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "banded-matrix.h"
+#include "krylov-solver.h"
+#include "symmetric-matrix.h"
+#include "test-helper.h"
+#include "triangular-matrix.h"
+
+using namespace ::testing;
+
+class PackedMatrixFunctionality : public Test
+{
+protected:
+	static constexpr size_t SIZE = 40;
+
+	static void expect_near(const Matrix<double>& actual, const Matrix<double>& expected, double tolerance)
+	{
+		ASSERT_EQ(actual.get_number_of_row(), expected.get_number_of_row());
+		ASSERT_EQ(actual.get_number_of_col(), expected.get_number_of_col());
+		for (size_t i = 0; i < actual.get_number_of_row(); ++i)
+		{
+			for (size_t j = 0; j < actual.get_number_of_col(); ++j)
+				EXPECT_NEAR(actual[i][j], expected[i][j], tolerance);
+		}
+	}
+
+	static void expect_near(const std::vector<double>& actual, const std::vector<double>& expected, double tolerance)
+	{
+		ASSERT_EQ(actual.size(), expected.size());
+		for (size_t i = 0; i < actual.size(); ++i)
+			EXPECT_NEAR(actual[i], expected[i], tolerance);
+	}
+};
+
+TEST_F(PackedMatrixFunctionality, TriangularMatrixShouldMatchItsDenseCounterpart)
+{
+	const Matrix<double> dense = test_helper::create_test_matrix(SIZE, 3);
+	const std::vector<double> b = test_helper::create_right_hand_side(SIZE);
+	for (const TriangularPart part : {TriangularPart::lower, TriangularPart::upper})
+	{
+		const TriangularMatrix<double> triangular(dense, part);
+		const Matrix<double> expected = triangular.to_dense();
+		EXPECT_EQ(triangular.get_data().size(), SIZE * (SIZE + 1) / 2);
+		EXPECT_EQ(part == TriangularPart::lower ? expected.is_lower_triangular() : expected.is_upper_triangular(),
+				true);
+
+		double det = 1;
+		for (size_t i = 0; i < SIZE; ++i)
+			det *= dense[i][i];
+		EXPECT_NEAR(triangular.determinant(), det, std::abs(det) * 1e-12);
+		std::vector<double> dense_product(SIZE);
+		for (size_t i = 0; i < SIZE; ++i)
+		{
+			for (size_t j = 0; j < SIZE; ++j)
+				dense_product[i] += expected[i][j] * b[j];
+		}
+		expect_near(triangular * b, dense_product, 1e-12);
+		expect_near(triangular * triangular.solve(b), b, 1e-12);
+		expect_near(triangular.solve(dense), expected.solve(dense), 1e-12);
+		expect_near(triangular.inverse().to_dense(), expected.inverse(), 1e-12);
+		expect_near((triangular * triangular).to_dense(), expected * expected, 1e-12);
+		expect_near((triangular * 2.0 - triangular).to_dense(), expected, 1e-15);
+		expect_near(static_cast<Matrix<double>>(triangular.transpose()), expected.transpose(), 0);
+		EXPECT_EQ(triangular.transpose().transpose(), triangular);
+	}
+
+	TriangularMatrix<double> lower(3);
+	lower.set(2, 0, 5);
+	EXPECT_EQ(lower.at(2, 0), 5);
+	EXPECT_EQ(lower.at(0, 2), 0);
+	EXPECT_THROW(lower.set(0, 2, 1), std::out_of_range);
+	EXPECT_THROW(static_cast<void>(lower.at(3, 0)), std::out_of_range);
+	EXPECT_THROW(static_cast<void>(lower.solve(std::vector<double>(3, 1))), std::invalid_argument);
+	EXPECT_THROW(static_cast<void>(lower + TriangularMatrix<double>(3, TriangularPart::upper)), std::invalid_argument);
+
+	// an integer determinant that does not fit throws, as the dense one does
+	const Matrix<long long> large({{4'000'000'000, 0, 0}, {1, 4'000'000'000, 0}, {1, 1, 4'000'000'000}});
+	EXPECT_THROW(std::ignore = TriangularMatrix<long long>(large).determinant(), std::overflow_error);
+	EXPECT_THROW(std::ignore = large.determinant(), std::overflow_error);
+	const Matrix<long long> singular({{4'000'000'000, 0, 0}, {1, 4'000'000'000, 0}, {1, 1, 0}});
+	EXPECT_EQ(TriangularMatrix<long long>(singular).determinant(), 0);
+	EXPECT_EQ(TriangularMatrix<long long>(Matrix<long long>({{2, 0}, {5, -3}})).determinant(), -6);
+}
+
+TEST_F(PackedMatrixFunctionality, SymmetricMatrixShouldUseCholeskyWhenPositiveDefinite)
+{
+	const Matrix<double> dense = test_helper::create_test_matrix(SIZE, 3);
+	// A^T * A is symmetric positive definite
+	const SymmetricMatrix<double> positive_definite(dense.transpose() * dense);
+	const Matrix<double> expected = positive_definite.to_dense();
+	const std::vector<double> b = test_helper::create_right_hand_side(SIZE);
+	EXPECT_TRUE(expected.is_symmetric());
+	EXPECT_EQ(positive_definite.get_data().size(), SIZE * (SIZE + 1) / 2);
+
+	const TriangularMatrix<double> lower = positive_definite.cholesky();
+	expect_near(lower * lower.transpose().to_dense(), expected, 1e-10);
+	EXPECT_NEAR(positive_definite.determinant(), expected.determinant(), std::abs(expected.determinant()) * 1e-10);
+	expect_near(positive_definite * positive_definite.solve(b), b, 1e-10);
+	expect_near(positive_definite.solve(dense), expected.solve(dense), 1e-10);
+	expect_near(positive_definite.inverse().to_dense(), expected.inverse(), 1e-10);
+	expect_near(positive_definite * dense, expected * dense, 1e-10);
+	expect_near((positive_definite + positive_definite * 2.0).to_dense(), expected * 3.0, 1e-10);
+
+	// indefinite: falls back to the dense LU
+	SymmetricMatrix<double> indefinite(3);
+	indefinite.set(0, 1, 2);
+	indefinite.set(2, 2, 1);
+	indefinite.set(0, 0, 1);
+	EXPECT_EQ(indefinite.at(1, 0), 2);
+	EXPECT_THROW(static_cast<void>(indefinite.cholesky()), std::invalid_argument);
+	EXPECT_NEAR(indefinite.determinant(), -4, 1e-12);
+	expect_near(indefinite * indefinite.solve(std::vector<double>{1, 2, 3}), {1, 2, 3}, 1e-12);
+	expect_near(indefinite.inverse().to_dense() * indefinite.to_dense(), Matrix<double>::create_i_matrix(3), 1e-12);
+
+	// a LinearOperator for the Krylov solvers
+	const KrylovSolver<double> cg(positive_definite, b, KrylovMethod::conjugate_gradient, 1e-12);
+	expect_near(cg.get_solution(), positive_definite.solve(b), 1e-8);
+}
+
+TEST_F(PackedMatrixFunctionality, BandedMatrixShouldSolveInLinearTime)
+{
+	// -u'' on a large grid: Thomas, never a dense matrix
+	constexpr size_t LARGE = 1'000'000;
+	BandedMatrix<double> laplacian(LARGE, 1, 1);
+	for (size_t i = 0; i < LARGE; ++i)
+	{
+		laplacian.set(i, i, 2);
+		if (i > 0)
+			laplacian.set(i, i - 1, -1);
+		if (i + 1 < LARGE)
+			laplacian.set(i, i + 1, -1);
+	}
+	const std::vector<double> ones(LARGE, 1);
+	const std::vector<double> x = laplacian.solve(ones);
+	const std::vector<double> product = laplacian * x;
+	// x grows like LARGE^2 / 8, so the residual is measured against it
+	double max_residual = 0;
+	for (size_t i = 0; i < LARGE; ++i)
+		max_residual = std::max(max_residual, std::abs(product[i] - 1));
+	EXPECT_LT(max_residual, 1e-12 * x[LARGE / 2]);
+	// det of the n x n second difference matrix is n + 1
+	BandedMatrix<double> small_laplacian(Matrix<double>({{2, -1, 0, 0}, {-1, 2, -1, 0}, {0, -1, 2, -1}, {0, 0, -1, 2}}),
+			1, 1);
+	EXPECT_NEAR(small_laplacian.determinant(), 5, 1e-12);
+
+	// two bands below the diagonal and one above, not diagonally dominant: banded LU with pivoting
+	const BandedMatrix<double> banded(test_helper::create_test_matrix(SIZE), 2, 1);
+	const Matrix<double> dense = banded.to_dense();
+	const std::vector<double> b = test_helper::create_right_hand_side(SIZE);
+	expect_near(banded.solve(b), dense.solve(b), 1e-9);
+	expect_near(banded.solve(dense), dense.solve(dense), 1e-9);
+	expect_near(banded.inverse(), dense.inverse(), 1e-9);
+	EXPECT_NEAR(banded.determinant(), dense.determinant(), std::abs(dense.determinant()) * 1e-10);
+	expect_near(banded * dense, dense * dense, 1e-12);
+	expect_near(banded.transpose().to_dense(), dense.transpose(), 0);
+
+	const BandedMatrix<double> sum = banded + BandedMatrix<double>(SIZE, 0, 3) * 0.0;
+	EXPECT_EQ(sum.get_lower_bandwidth(), 2u);
+	EXPECT_EQ(sum.get_upper_bandwidth(), 3u);
+	EXPECT_EQ(sum.to_dense(), dense);
+	EXPECT_THROW(BandedMatrix<double>(3, 0, 0).set(0, 1, 1), std::out_of_range);
+	EXPECT_THROW(static_cast<void>(BandedMatrix<double>(3, 1, 1).solve(std::vector<double>(3, 1))),
+			std::invalid_argument);
+	EXPECT_EQ(BandedMatrix<double>(3, 1, 1).determinant(), 0);
+}
+
+TEST_F(PackedMatrixFunctionality, BandedMatrixShouldBeExactForIntegers)
+{
+	EXPECT_EQ(BandedMatrix<int>(Matrix<int>({{2, 1}, {1, 2}}), 1, 1).determinant(), 3);
+	const BandedMatrix<long long> tridiagonal(Matrix<long long>({{3, 1, 0}, {1, 3, 1}, {0, 1, 3}}), 1, 1);
+	EXPECT_EQ(tridiagonal.determinant(), 21);
+	EXPECT_EQ(tridiagonal.determinant(), tridiagonal.to_dense().determinant());
+
+	// solves and inverses take the same path as the dense matrix
+	const BandedMatrix<long long> unimodular(Matrix<long long>({{2, 1, 0}, {1, 1, 1}, {0, 1, 3}}), 1, 1);
+	EXPECT_EQ(unimodular.determinant(), 1);
+	const std::vector<long long> b{1, -2, 3};
+	EXPECT_EQ(unimodular.solve(b), unimodular.to_dense().solve(b));
+	EXPECT_EQ(unimodular.inverse(), unimodular.to_dense().inverse());
+}
@@ -172,6 +172,19 @@ TEST_F(PolynomialMultipleWithPolynomial, MultipleEqual)
 	EXPECT_EQ(Polynomial(expected_result), result);
 }
 
+TEST_F(PolynomialMultipleWithPolynomial, MultipleEqualWithItself)
+{
+	Polynomial<int> result = first_polynomial;
+	result *= result;
+	EXPECT_EQ(Polynomial(Coefficient({1, -2, 1})), result);
+}
+
+TEST_F(PolynomialMultipleWithPolynomial, MultipleTemporary)
+{
+	const Polynomial<int> result = (first_polynomial + Polynomial(Coefficient({0}))) * second_polynomial;
+	EXPECT_EQ(Polynomial(expected_result), result);
+}
+
 class PolynomialMultipleWithElement : public SharedCoefficientAndElement
 {
 protected:
@@ -323,4 +336,18 @@ TEST_F(CoefficientTest, At)
 {
 	for (size_t i = 0; i < coefficients.size(); i++)
 		EXPECT_EQ(coefficients.at(i), polynomial.at(i));
-}
\ No newline at end of file
+}
+
+TEST_F(CoefficientTest, RemainderAndPowerModulo)
+{
+	// (x - 1)^3 = (x^2 + 1) * (x - 3) + 2 * x + 2
+	const Polynomial<int32_t> divisor({1, 0, 1});
+	EXPECT_EQ(polynomial.remainder(divisor), Polynomial<int32_t>({2, 2}));
+	EXPECT_EQ(Polynomial<int32_t>({3}).remainder(divisor), Polynomial<int32_t>({3, 0}));
+
+	// x^2 = -1 modulo x^2 + 1
+	const Polynomial<int32_t> x({0, 1});
+	EXPECT_EQ(x.power_modulo(4, divisor), Polynomial<int32_t>({1, 0}));
+	EXPECT_EQ(x.power_modulo(1'000'000'000'000'003ULL, divisor), Polynomial<int32_t>({0, -1}));
+	EXPECT_THROW(std::ignore = polynomial.remainder(Polynomial<int32_t>({0, 0})), std::invalid_argument);
+}
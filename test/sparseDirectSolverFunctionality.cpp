@@ -0,0 +1,125 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "sparse-direct-solver.h"
+#include "test-helper.h"
+
+using namespace ::testing;
+
+class SparseDirectSolverFunctionality : public Test
+{
+protected:
+	static constexpr size_t GRID = 40;
+};
+
+TEST_F(SparseDirectSolverFunctionality, CholeskyShouldSolveAndMinimumDegreeShouldReduceFill)
+{
+	const SparseMatrix<double> matrix = test_helper::create_convection_diffusion(GRID, 0);
+	const std::vector<double> b = test_helper::create_right_hand_side(GRID * GRID);
+
+	const SparseDirectSolver<double> natural(matrix, SparseFactorization::cholesky, SparseOrdering::natural);
+	const SparseDirectSolver<double> amd(matrix, SparseFactorization::cholesky);
+	EXPECT_LT(test_helper::relative_residual(matrix, natural.solve(b), b), 1e-13);
+	EXPECT_LT(test_helper::relative_residual(matrix, amd.solve(b), b), 1e-13);
+
+	// the natural order of a grid fills the whole band
+	EXPECT_GE(natural.get_symbolic().get_factor_nonzero(), GRID * GRID * GRID);
+	EXPECT_LT(amd.get_symbolic().get_factor_nonzero(), natural.get_symbolic().get_factor_nonzero() / 2);
+	EXPECT_LT(amd.get_symbolic().get_number_of_supernode(), GRID * GRID);
+
+	std::vector<size_t> sorted = amd.get_symbolic().get_permutation();
+	std::sort(sorted.begin(), sorted.end());
+	std::vector<size_t> expected(GRID * GRID);
+	std::iota(expected.begin(), expected.end(), 0);
+	EXPECT_EQ(sorted, expected);
+
+	// only the lower triangle is read, and a matrix that is not positive definite throws
+	SparseMatrixBuilder<double> lower(GRID * GRID, GRID * GRID);
+	const SparseMatrix<double> csr = matrix.to_format(SparseFormat::csr);
+	for (size_t i = 0; i < GRID * GRID; ++i)
+	{
+		for (size_t k = csr.get_offsets()[i]; k < csr.get_offsets()[i + 1] and csr.get_indices()[k] <= i; ++k)
+			lower.add(i, csr.get_indices()[k], csr.get_values()[k]);
+	}
+	const SparseDirectSolver<double> from_lower(lower.build(SparseFormat::csc), SparseFactorization::cholesky);
+	EXPECT_LT(test_helper::relative_residual(matrix, from_lower.solve(b), b), 1e-13);
+	const SparseMatrix<double> indefinite = test_helper::create_convection_diffusion(GRID, 0, -1);
+	EXPECT_THROW(SparseDirectSolver<double>(indefinite, SparseFactorization::cholesky), std::invalid_argument);
+}
+
+TEST_F(SparseDirectSolverFunctionality, LUShouldSolveNonSymmetricSystems)
+{
+	const SparseMatrix<double> matrix = test_helper::create_convection_diffusion(GRID, 0.8);
+	const std::vector<double> b = test_helper::create_right_hand_side(GRID * GRID);
+	const SparseDirectSolver<double> solver(matrix, SparseFactorization::lu);
+	EXPECT_LT(test_helper::relative_residual(matrix, solver.solve(b), b), 1e-13);
+
+	// several right-hand sides at once
+	std::vector<std::vector<double>> columns(GRID * GRID, std::vector<double>(3));
+	for (size_t i = 0; i < GRID * GRID; ++i)
+	{
+		for (size_t j = 0; j < 3; ++j)
+			columns[i][j] = b[(i + j * 17) % b.size()];
+	}
+	const Matrix<double> rhs(columns);
+	const Matrix<double> x = solver.solve(rhs);
+	const Matrix<double> residual = matrix * x - rhs;
+	for (size_t i = 0; i < GRID * GRID; ++i)
+	{
+		for (size_t j = 0; j < 3; ++j)
+			EXPECT_NEAR(std::as_const(residual)[i][j], 0, 1e-12);
+	}
+
+	// zeros on the diagonal are fine as long as the supernode holds another pivot
+	constexpr size_t SIZE = 30;
+	std::vector<std::vector<double>> table = test_helper::create_dense_table(SIZE);
+	for (size_t i = 0; i < SIZE; ++i)
+		table[i][i] = 0;
+	const Matrix<double> dense(table);
+	const std::vector<double> dense_b = test_helper::create_right_hand_side(SIZE);
+	const SparseDirectSolver<double> pivoting(SparseMatrix<double>(dense), SparseFactorization::lu);
+	const std::vector<double> expected = dense.solve(dense_b);
+	const std::vector<double> actual = pivoting.solve(dense_b);
+	for (size_t i = 0; i < SIZE; ++i)
+		EXPECT_NEAR(actual[i], expected[i], 1e-10);
+
+	EXPECT_THROW(SparseDirectSolver<double>(SparseMatrix<double>(Matrix<double>(4, 4)), SparseFactorization::lu),
+			std::invalid_argument);
+	EXPECT_THROW(static_cast<void>(solver.solve(std::vector<double>(3))), std::invalid_argument);
+}
+
+TEST_F(SparseDirectSolverFunctionality, SymbolicAnalysisShouldBeReusedForNewValues)
+{
+	// the steps of an implicit time loop: same pattern, a shift that changes every step
+	const SparseSymbolicAnalysis symbolic(test_helper::create_convection_diffusion(GRID, 0.3));
+	SparseDirectSolver<double> lu(symbolic, test_helper::create_convection_diffusion(GRID, 0.3),
+			SparseFactorization::lu);
+	SparseDirectSolver<double> cholesky(symbolic, test_helper::create_convection_diffusion(GRID, 0),
+			SparseFactorization::cholesky);
+	const std::vector<double> b = test_helper::create_right_hand_side(GRID * GRID);
+	for (const double shift : {0.5, 2.0, 10.0})
+	{
+		const SparseMatrix<double> nonsymmetric = test_helper::create_convection_diffusion(GRID, 0.3, shift);
+		lu.refactorize(nonsymmetric);
+		EXPECT_LT(test_helper::relative_residual(nonsymmetric, lu.solve(b), b), 1e-13);
+
+		const SparseMatrix<double> symmetric = test_helper::create_convection_diffusion(GRID, 0, shift);
+		cholesky.refactorize(symmetric);
+		EXPECT_LT(test_helper::relative_residual(symmetric, cholesky.solve(b), b), 1e-13);
+		EXPECT_EQ(cholesky.get_symbolic().get_permutation(), symbolic.get_permutation());
+	}
+
+	// an entry outside the analysed pattern, and a matrix of another size
+	SparseMatrixBuilder<double> builder(GRID * GRID, GRID * GRID);
+	for (size_t i = 0; i < GRID * GRID; ++i)
+		builder.add(i, i, 1);
+	builder.add(0, GRID * GRID - 1, 1);
+	builder.add(GRID * GRID - 1, 0, 1);
+	EXPECT_THROW(lu.refactorize(builder.build()), std::invalid_argument);
+	EXPECT_THROW(lu.refactorize(SparseMatrix<double>(3, 3)), std::invalid_argument);
+	EXPECT_THROW(SparseSymbolicAnalysis(SparseMatrix<double>(3, 4)), std::invalid_argument);
+}
@@ -0,0 +1,157 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "sparse-matrix.h"
+
+using namespace ::testing;
+
+class SparseMatrixFunctionality : public Test
+{
+protected:
+	// about 3% of the entries are non-zero, some rows and columns stay empty
+	static Matrix<double> create_sparse_table(size_t row, size_t col)
+	{
+		std::vector<std::vector<double>> table(row, std::vector<double>(col));
+		for (size_t i = 0; i < row; ++i)
+			for (size_t j = 0; j < col; ++j)
+				if ((i * 37 + j * 11) % 31 == 0 and i % 17 != 5)
+					table[i][j] = static_cast<double>((i * 7 + j * 3) % 13) - 6.5;
+		return Matrix<double>(table);
+	}
+};
+
+TEST_F(SparseMatrixFunctionality, TheBuilderShouldSumDuplicatesAndDropZeros)
+{
+	SparseMatrixBuilder<int> builder(3, 4);
+	builder.add(2, 3, 5);
+	builder.add(0, 1, 2);
+	builder.add(2, 3, -1);
+	builder.add(1, 0, 7);
+	builder.add(1, 2, 4);
+	builder.add(1, 2, -4);
+	builder.add(0, 0, 1);
+
+	const Matrix<int> expected({{1, 2, 0, 0}, {7, 0, 0, 0}, {0, 0, 0, 4}});
+	for (const SparseFormat format : {SparseFormat::csr, SparseFormat::csc})
+	{
+		const SparseMatrix<int> sparse = builder.build(format);
+		EXPECT_EQ(sparse.get_format(), format);
+		EXPECT_EQ(sparse.get_number_of_nonzero(), 4u);
+		EXPECT_EQ(sparse.to_dense(), expected);
+		EXPECT_EQ(sparse.at(2, 3), 4);
+		EXPECT_EQ(sparse.at(1, 2), 0);
+		EXPECT_EQ(SparseMatrix<int>(expected, format).get_values(), sparse.get_values());
+	}
+	EXPECT_EQ(builder.build(SparseFormat::csr).get_offsets(), std::vector<size_t>({0, 2, 3, 4}));
+	EXPECT_EQ(builder.build(SparseFormat::csc).get_indices(), std::vector<size_t>({0, 1, 0, 2}));
+
+	EXPECT_THROW(builder.add(3, 0, 1), std::out_of_range);
+	EXPECT_THROW(std::ignore = builder.build().at(0, 4), std::out_of_range);
+}
+
+TEST_F(SparseMatrixFunctionality, ProductsShouldMatchTheDenseMatrix)
+{
+	constexpr size_t ROW = 300;
+	constexpr size_t COL = 200;
+	const Matrix<double> dense = create_sparse_table(ROW, COL);
+	std::vector<double> x(COL);
+	std::vector<double> z(ROW);
+	for (size_t j = 0; j < COL; ++j)
+		x[j] = std::sin(static_cast<double>(j));
+	for (size_t i = 0; i < ROW; ++i)
+		z[i] = std::cos(static_cast<double>(i));
+	std::vector<std::vector<double>> block_table(COL, std::vector<double>(5));
+	for (size_t j = 0; j < COL; ++j)
+		for (size_t k = 0; k < 5; ++k)
+			block_table[j][k] = static_cast<double>((j + k) % 9) - 4;
+	const Matrix<double> block(block_table);
+	const Matrix<double> expected_block = dense * block;
+
+	for (const SparseFormat format : {SparseFormat::csr, SparseFormat::csc})
+	{
+		const SparseMatrix<double> sparse(dense, format);
+		EXPECT_EQ(sparse.to_dense(), dense);
+		EXPECT_EQ(sparse.transpose().to_dense(), dense.transpose());
+
+		const std::vector<double> y = sparse * x;
+		std::vector<double> transposed(COL);
+		sparse.multiply_transpose(z.data(), transposed.data());
+		for (size_t i = 0; i < ROW; ++i)
+		{
+			double expected = 0;
+			for (size_t j = 0; j < COL; ++j)
+				expected += dense[i][j] * x[j];
+			EXPECT_NEAR(y[i], expected, 1e-12);
+		}
+		for (size_t j = 0; j < COL; ++j)
+		{
+			double expected = 0;
+			for (size_t i = 0; i < ROW; ++i)
+				expected += dense[i][j] * z[i];
+			EXPECT_NEAR(transposed[j], expected, 1e-12);
+		}
+
+		const Matrix<double> product = sparse * block;
+		for (size_t i = 0; i < ROW; ++i)
+			for (size_t k = 0; k < 5; ++k)
+				EXPECT_NEAR(product[i][k], expected_block[i][k], 1e-12);
+	}
+
+	EXPECT_THROW(std::ignore = SparseMatrix<double>(dense) * std::vector<double>(ROW), std::invalid_argument);
+	EXPECT_THROW(std::ignore = SparseMatrix<double>(dense) * dense, std::invalid_argument);
+}
+
+TEST_F(SparseMatrixFunctionality, SumAndDifferenceShouldMatchTheDenseMatrixInEitherFormat)
+{
+	const Matrix<double> first = create_sparse_table(120, 90);
+	const Matrix<double> second = create_sparse_table(90, 120).transpose() * 2.0;
+
+	const SparseMatrix<double> left(first, SparseFormat::csr);
+	const SparseMatrix<double> right(second, SparseFormat::csc);
+	const SparseMatrix<double> sum = left + right;
+	EXPECT_EQ(sum.get_format(), SparseFormat::csr);
+	EXPECT_EQ(sum.to_dense(), Matrix<double>(first + second));
+	EXPECT_EQ((right - left).get_format(), SparseFormat::csc);
+	EXPECT_EQ((right - left).to_dense(), Matrix<double>(second - first));
+	EXPECT_EQ((left - left).get_number_of_nonzero(), 0u);
+
+	EXPECT_THROW(std::ignore = left + SparseMatrix<double>(90, 120), std::invalid_argument);
+}
+
+TEST_F(SparseMatrixFunctionality, TopEigenpairsShouldOnlyNeedSparseProducts)
+{
+	// symmetric tridiagonal with a well separated diagonal, 60000 non-zeros instead of 4e8 dense entries
+	constexpr size_t SIZE = 20000;
+	SparseMatrixBuilder<double> builder(SIZE, SIZE);
+	builder.reserve(3 * SIZE);
+	for (size_t i = 0; i < SIZE; ++i)
+	{
+		builder.add(i, i, static_cast<double>(i) / 100);
+		if (i + 1 < SIZE)
+		{
+			builder.add(i, i + 1, 0.5);
+			builder.add(i + 1, i, 0.5);
+		}
+	}
+	const SparseMatrix<double> sparse = builder.build();
+	EXPECT_TRUE(sparse.is_symmetric());
+	EXPECT_FALSE(SparseMatrix<double>(create_sparse_table(50, 50)).is_symmetric());
+
+	const PartialEigenDecomposition<double> eigen = sparse.top_eigenpairs(3);
+	const std::vector<double> eigenvalues = eigen.get_real_eigenvalues();
+	const std::vector<std::vector<std::complex<double>>> eigenvectors = eigen.get_eigenvectors();
+	ASSERT_EQ(eigenvalues.size(), 3u);
+	for (size_t j = 0; j < 3; ++j)
+	{
+		std::vector<double> vector(SIZE);
+		for (size_t i = 0; i < SIZE; ++i)
+			vector[i] = eigenvectors[j][i].real();
+		const std::vector<double> product = sparse * vector;
+		double residual = 0;
+		for (size_t i = 0; i < SIZE; ++i)
+			residual = std::max(residual, std::abs(product[i] - eigenvalues[j] * vector[i]));
+		EXPECT_LT(residual, 1e-8 * std::abs(eigenvalues[j]));
+	}
+}
@@ -0,0 +1,102 @@
+#ifndef MATRIX_TEST_HELPER_H
+#define MATRIX_TEST_HELPER_H
+
+#include <cmath>
+#include <cstddef>
+
+#include <vector>
+
+#include "sparse-matrix.h"
+
+// problems shared by the tests
+namespace test_helper
+{
+
+// deterministic entries in [-0.5, 0.5) plus diagonal_shift on the diagonal; the rows repeat every 23, so past that size
+// only a shift makes the matrix nonsingular
+inline std::vector<std::vector<double>> create_dense_table(size_t size, double diagonal_shift = 0)
+{
+	std::vector<std::vector<double>> table(size, std::vector<double>(size));
+	for (size_t i = 0; i < size; ++i)
+	{
+		for (size_t j = 0; j < size; ++j)
+			table[i][j] = static_cast<double>((i * 37 + j * 11 + i * j) % 23) / 23 - 0.5;
+		table[i][i] += diagonal_shift;
+	}
+	return table;
+}
+
+inline Matrix<double> create_test_matrix(size_t size, double diagonal_shift = 0)
+{
+	return Matrix<double>(create_dense_table(size, diagonal_shift));
+}
+
+// S * T * S^-1 for T upper triangular with diagonal 1..size and S = 2 * I plus entries up to coupling, a full matrix
+// whose eigenvalues are 1..size
+inline Matrix<double> create_similar_to_triangular(size_t size, double coupling)
+{
+	std::vector<std::vector<double>> triangular_table(size, std::vector<double>(size));
+	std::vector<std::vector<double>> similarity_table(size, std::vector<double>(size));
+	for (size_t i = 0; i < size; ++i)
+	{
+		triangular_table[i][i] = static_cast<double>(i + 1);
+		for (size_t j = i + 1; j < size; ++j)
+			triangular_table[i][j] = static_cast<double>((i + 2 * j) % 5) / 5;
+		for (size_t j = 0; j < size; ++j)
+			similarity_table[i][j] = (i == j ? 2.0 : 0.0) + coupling * static_cast<double>((3 * i + j) % 7) / 7;
+	}
+	const Matrix<double> similarity(similarity_table);
+	return similarity * Matrix<double>(triangular_table) * similarity.inverse();
+}
+
+// five-point finite differences of -laplacian(u) + velocity * du/dx + shift * u on a grid x grid grid, symmetric
+// positive definite for a zero velocity and a non-negative shift
+inline SparseMatrix<double> create_convection_diffusion(size_t grid, double velocity, double shift = 0)
+{
+	SparseMatrixBuilder<double> builder(grid * grid, grid * grid);
+	builder.reserve(5 * grid * grid);
+	for (size_t i = 0; i < grid; ++i)
+	{
+		for (size_t j = 0; j < grid; ++j)
+		{
+			const size_t index = i * grid + j;
+			builder.add(index, index, 4 + shift);
+			if (i > 0)
+				builder.add(index, index - grid, -1);
+			if (i + 1 < grid)
+				builder.add(index, index + grid, -1);
+			if (j > 0)
+				builder.add(index, index - 1, -1 - velocity);
+			if (j + 1 < grid)
+				builder.add(index, index + 1, -1 + velocity);
+		}
+	}
+	return builder.build();
+}
+
+inline std::vector<double> create_right_hand_side(size_t size)
+{
+	std::vector<double> b(size);
+	for (size_t i = 0; i < size; ++i)
+		b[i] = std::sin(static_cast<double>(i) / 10) + 1;
+	return b;
+}
+
+// ||b - A * x||_2 / ||b||_2
+inline double relative_residual(const SparseMatrix<double>& matrix, const std::vector<double>& x,
+		const std::vector<double>& b)
+{
+	const std::vector<double> product = matrix * x;
+	double residual = 0;
+	double b_norm = 0;
+	for (size_t i = 0; i < b.size(); ++i)
+	{
+		residual += (b[i] - product[i]) * (b[i] - product[i]);
+		b_norm += b[i] * b[i];
+	}
+	return std::sqrt(residual / b_norm);
+}
+
+}		 // namespace test_helper
+
+#endif